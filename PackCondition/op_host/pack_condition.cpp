@@ -0,0 +1,151 @@
+
+#include "pack_condition_tiling.h"
+#include "register/op_def_registry.h"
+#include "tiling/platform/platform_ascendc.h"
+#include "../../common/include/op_profile_layout.h"
+#include "../../common/op_host/ub_planner.h"
+#include "../../common/op_host/tiling_cache.h"
+#include "../../common/op_host/elementwise_tiling.h"
+
+
+namespace optiling {
+const uint32_t BUFFER_NUM = 2;         // 与核函数中队列的深度一致
+const uint32_t PACKED_UNIT = 256;      // 切分粒度：256 个元素对应 32 字节掩码，与 SelectV2 打包模式一致
+const size_t TILING_CACHE_CAPACITY = 256;
+
+// KernelPackCondition 的 UB 占用，需与 op_kernel/pack_condition.cpp 中的 InitBuffer 保持一致：
+//   队列：condition（1 字节）与打包后的掩码（1 bit），各 BUFFER_NUM 块；condition 的 half 副本。
+static uint32_t PackTileLength(uint64_t ub_size)
+{
+    UbPlanner planner;
+    planner.Queue(sizeof(uint8_t), BUFFER_NUM)
+           .BitQueue(BUFFER_NUM)
+           .Buffer(sizeof(uint16_t));
+    return planner.TileLength(ub_size, PACKED_UNIT);
+}
+
+static ge::graphStatus ComputeTiling(gert::TilingContext* context)
+{
+    PackConditionTilingData tiling;
+
+    auto ascendcPlatform = platform_ascendc::PlatformAscendC(context->GetPlatformInfo());
+    uint64_t ub_size;
+    ascendcPlatform.GetCoreMemSize(platform_ascendc::CoreMemType::UB, ub_size); 
+    auto aivNum = ascendcPlatform.GetCoreNum();
+    //用于存数据元素个数
+    uint32_t totalLength = context->GetInputShape(0)->GetStorageShape().GetShapeSize();
+
+    // 计算 block_size：按核函数实际申请的 Buffer 求 UB 能容纳的最大 Tile（元素个数），向下对齐到 PACKED_UNIT。
+    uint32_t block_size = PackTileLength(ub_size);
+    if (block_size == 0) {
+        return ge::GRAPH_FAILED;
+    }
+    // 核间切分的最小粒度：PACKED_UNIT 个元素，保证每个核的 condition 与掩码起始地址都 32 字节对齐。
+    ElementwiseSplit split = SplitElementwise(totalLength, aivNum, PACKED_UNIT);
+    aivNum = split.coreNum;
+
+    tiling.set_block_size(block_size);
+    SetElementwiseSplit(tiling, split);
+
+    context->SetBlockDim(aivNum);
+    tiling.SaveToBuffer(context->GetRawTilingData()->GetData(), context->GetRawTilingData()->GetCapacity());
+    context->GetRawTilingData()->SetDataSize(tiling.GetDataSize());
+    size_t *currentWorkspace = context->GetWorkspaceSizes(1);
+
+    // 算子本身不需要额外的临时内存；开启 OP_PROFILING 时在系统 workspace 之后为每个核预留打点区域。
+    uint64_t profileSize = OpProfileWorkspaceSize(aivNum);
+    currentWorkspace[0] = profileSize == 0 ? 0 : ascendcPlatform.GetLibApiWorkSpaceSize() + profileSize;
+
+    return ge::GRAPH_SUCCESS;
+}
+
+static TilingPlanCache& PlanCache()
+{
+    static TilingPlanCache cache(TILING_CACHE_CAPACITY);
+    return cache;
+}
+
+// 切分结果只取决于元素个数与平台信息，相同签名直接复用缓存的 TilingData。
+static ge::graphStatus TilingFunc(gert::TilingContext* context)
+{
+    auto ascendcPlatform = platform_ascendc::PlatformAscendC(context->GetPlatformInfo());
+    uint64_t ub_size;
+    ascendcPlatform.GetCoreMemSize(platform_ascendc::CoreMemType::UB, ub_size);
+
+    TilingSignature signature;
+    signature.Append(context->GetInputShape(0)->GetStorageShape().GetShapeSize())
+             .Append(static_cast<int64_t>(ascendcPlatform.GetSocVersion()))
+             .Append(ascendcPlatform.GetCoreNum())
+             .Append(static_cast<int64_t>(ub_size));
+
+    if (PlanCache().LookupAndApply(signature, context)) {
+        return ge::GRAPH_SUCCESS;
+    }
+    ge::graphStatus ret = ComputeTiling(context);
+    TilingPlan plan;
+    if (ret == ge::GRAPH_SUCCESS && CaptureTilingPlan(context, plan)) {
+        PlanCache().Insert(signature, plan);
+    }
+    return ret;
+}
+} 
+
+
+namespace ge {
+// 输出为一维 uint8，每个字节打包 8 个元素。
+static ge::graphStatus InferShape(gert::InferShapeContext* context)
+{
+    const gert::Shape* condition_shape = context->GetInputShape(0);
+    gert::Shape* mask_shape = context->GetOutputShape(0);
+    int64_t total = condition_shape->GetShapeSize();
+    mask_shape->SetDimNum(1);
+    // 动态 shape 下元素个数未知时输出长度也未知。
+    mask_shape->SetDim(0, total < 0 ? -1 : (total + 7) / 8);
+    return GRAPH_SUCCESS;
+}
+static ge::graphStatus InferDataType(gert::InferDataTypeContext *context)
+{
+    context->SetOutputDataType(0, ge::DT_UINT8);
+    return ge::GRAPH_SUCCESS;
+}
+}
+
+
+namespace ops {
+// 把 bool condition 打包为 SelectV2 packed_condition 模式使用的按位掩码：
+// 第 i 个元素对应第 i / 8 个字节的第 i % 8 位（低位在前），与 Compare 输出、Select 读取的格式一致。
+// 同一个 condition 被多次 select 复用时只需打包一次。
+class PackCondition : public OpDef {
+public:
+    explicit PackCondition(const char* name) : OpDef(name)
+    {
+        this->Input("condition")
+            .ParamType(REQUIRED)
+            .DataType({ge::DT_BOOL})
+            .Format({ge::FORMAT_ND})
+            .UnknownShapeFormat({ge::FORMAT_ND});
+        this->Output("mask")
+            .ParamType(REQUIRED)
+            .DataType({ge::DT_UINT8})
+            .Format({ge::FORMAT_ND})
+            .UnknownShapeFormat({ge::FORMAT_ND});
+
+        this->SetInferShape(ge::InferShape).SetInferDataType(ge::InferDataType);
+
+        this->AICore()
+            .SetTiling(optiling::TilingFunc);
+        // 动态 shape：核函数只编译一次，shape 变化时只需重新调用 TilingFunc。
+        OpAICoreConfig aicConfig;
+        aicConfig.DynamicCompileStaticFlag(true)
+            .DynamicFormatFlag(false)
+            .DynamicRankSupportFlag(true)
+            .DynamicShapeSupportFlag(true)
+            .NeedCheckSupportFlag(false)
+            .PrecisionReduceFlag(true);
+        this->AICore().AddConfig("ascend310b", aicConfig);
+
+    }
+};
+
+OP_ADD(PackCondition);
+}
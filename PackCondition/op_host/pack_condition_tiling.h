@@ -0,0 +1,13 @@
+
+#include "register/tilingdata_base.h"
+
+namespace optiling {
+BEGIN_TILING_DATA_DEF(PackConditionTilingData)
+  TILING_DATA_FIELD_DEF(uint32_t, block_size);
+  TILING_DATA_FIELD_DEF(uint32_t, core_size);   
+  TILING_DATA_FIELD_DEF(uint32_t, core_remain);   
+  TILING_DATA_FIELD_DEF(uint32_t, core_tail);
+END_TILING_DATA_DEF;
+
+REGISTER_TILING_DATA_CLASS(PackCondition, PackConditionTilingData)
+}
@@ -0,0 +1,112 @@
+#include "kernel_operator.h"
+#include "op_profiler.h"
+#include "copy_utils.h"
+#include "kernel_split.h"
+
+constexpr int32_t BUFFER_NUM = 2;        // 使用双缓冲 (每个队列有 2 个 Buffer)
+constexpr uint32_t PACKED_UNIT = 256;    // 切分粒度：256 个元素对应 32 字节掩码
+constexpr uint32_t COMPARE_ALIGN = 128;  // Compare 按 256 字节处理，half 对应 128 个元素
+
+// bool -> 按位掩码：condition 转为 half 后与 0 比较，Compare 的输出即 Select 使用的掩码格式。
+// 核间切分与 ElementwisePipeline 相同（kernel_split.h），Tile 循环单独实现：输出每 8 个元素 1 个字节，
+// 且最后一个 Tile 搬入时需把 32 字节补齐部分填 0，使最后一个字节中多出的位为 0，
+// 而 ElementwisePipeline 按元素搬出、补齐部分的数据无效。
+class KernelPackCondition {
+public:
+    __aicore__ inline KernelPackCondition() {}
+
+    __aicore__ inline void Init(GM_ADDR condition, GM_ADDR mask, uint32_t block_size, uint32_t core_size,
+                                uint32_t core_remain, uint32_t core_tail, GM_ADDR workspace)
+    {
+        // 核间切分见 kernel_split.h，粒度为 PACKED_UNIT 个元素，每个核的掩码起始地址 32 字节对齐。
+        block.Init(PACKED_UNIT, block_size, core_size, core_remain, core_tail);
+
+        conditionGm.SetGlobalBuffer((__gm__ uint8_t*)condition + block.offset, block.length);
+        maskGm.SetGlobalBuffer((__gm__ uint8_t*)mask + block.offset / 8, (block.length + 7) / 8);
+
+        pipe.InitBuffer(inQueueCondition, BUFFER_NUM, block.tileLength * sizeof(uint8_t));
+        pipe.InitBuffer(outQueueMask, BUFFER_NUM, block.tileLength / 8);
+        pipe.InitBuffer(B_con_half, block.tileLength * sizeof(half));
+        profiler.Init(workspace);
+    }
+
+    __aicore__ inline void Process()
+    {
+        for (uint32_t i = 0; i < block.tileNum; i++) {
+            uint32_t length = block.TileLength(i);
+            profiler.TileBegin();
+            CopyIn(i, length);
+            profiler.Mark(OP_PROFILE_COPY_IN);
+            Compute(length);
+            profiler.Mark(OP_PROFILE_COMPUTE);
+            CopyOut(i, length);
+            profiler.Mark(OP_PROFILE_COPY_OUT);
+            profiler.AddBytes(length, (length + 7) / 8);
+        }
+        profiler.Finish();
+    }
+
+private:
+    __aicore__ inline void CopyIn(uint32_t progress, uint32_t length)
+    {
+        AscendC::LocalTensor<uint8_t> conditionLocal = inQueueCondition.AllocTensor<uint8_t>();
+        uint32_t copyLength = AlignUp(length, COPY_ALIGN_BYTES);
+        if (copyLength == length) {
+            AscendC::DataCopy(conditionLocal, conditionGm[progress * block.tileLength], length);
+        } else {
+            // 尾部补 0 到 32 字节，使最后一个字节中多出的位为 0，输出与补齐前的数据无关。
+            AscendC::DataCopyExtParams copyParams{1, length, 0, 0, 0};
+            AscendC::DataCopyPadExtParams<uint8_t> padParams{true, 0, static_cast<uint8_t>(copyLength - length), 0};
+            AscendC::DataCopyPad(conditionLocal, conditionGm[progress * block.tileLength], copyParams, padParams);
+        }
+        uint32_t cmpLength = AlignUp(length, COMPARE_ALIGN);
+        if (cmpLength > copyLength) {
+            AscendC::Duplicate(conditionLocal[copyLength].ReinterpretCast<uint16_t>(), static_cast<uint16_t>(0),
+                               (cmpLength - copyLength) / 2);
+        }
+        inQueueCondition.EnQue(conditionLocal);
+    }
+
+    __aicore__ inline void Compute(uint32_t length)
+    {
+        AscendC::LocalTensor<uint8_t> conditionLocal = inQueueCondition.DeQue<uint8_t>();
+        AscendC::LocalTensor<uint8_t> maskLocal = outQueueMask.AllocTensor<uint8_t>();
+        auto con_half = B_con_half.Get<half>();
+        uint32_t cmpLength = AlignUp(length, COMPARE_ALIGN);
+
+        AscendC::Cast(con_half, conditionLocal, AscendC::RoundMode::CAST_NONE, cmpLength);
+        AscendC::CompareScalar(maskLocal, con_half, half(0), AscendC::CMPMODE::NE, cmpLength);
+
+        outQueueMask.EnQue(maskLocal);
+        inQueueCondition.FreeTensor(conditionLocal);
+    }
+
+    __aicore__ inline void CopyOut(uint32_t progress, uint32_t length)
+    {
+        AscendC::LocalTensor<uint8_t> maskLocal = outQueueMask.DeQue<uint8_t>();
+        CopyOutExact(maskGm[progress * block.tileLength / 8], maskLocal, (length + 7) / 8);
+        outQueueMask.FreeTensor(maskLocal);
+    }
+
+private:
+    ElementwiseBlock block;
+
+    AscendC::TPipe pipe;
+    AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueCondition;
+    AscendC::TQue<AscendC::QuePosition::VECOUT, BUFFER_NUM> outQueueMask;
+    AscendC::TBuf<AscendC::QuePosition::VECCALC> B_con_half;
+
+    AscendC::GlobalTensor<uint8_t> conditionGm;
+    AscendC::GlobalTensor<uint8_t> maskGm;
+    OpProfiler profiler;
+};
+
+
+extern "C" __global__ __aicore__ void pack_condition(GM_ADDR condition, GM_ADDR mask, GM_ADDR workspace, GM_ADDR tiling) {
+
+    GET_TILING_DATA(tiling_data, tiling);
+    KernelPackCondition op;
+    op.Init(condition, mask, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+    op.Process();
+}
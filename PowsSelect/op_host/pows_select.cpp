@@ -0,0 +1,201 @@
+
+#include "pows_select_tiling.h"
+#include "register/op_def_registry.h"
+#include "tiling/platform/platform_ascendc.h"
+#include "../../common/include/op_profile_layout.h"
+#include "../../common/op_host/tiling_cache.h"
+#include "../../common/op_host/broadcast_planner.h"
+#include "../../common/op_host/broadcast_shape.h"
+#include "../../common/op_host/op_log.h"
+#include "../../common/op_host/elementwise_tiling.h"
+#include "pows_select_plan.h"
+
+
+namespace optiling {
+const uint32_t INPUT_NUM = 4;          // condition、x1、x2、x3
+const uint32_t MAX_DIM_NUM = BroadcastPlanner::MAX_DIM_NUM;
+const size_t TILING_CACHE_CAPACITY = 256;
+
+static ge::graphStatus ComputeTiling(gert::TilingContext* context)
+{
+    PowsSelectTilingData tiling;
+
+    auto ascendcPlatform = platform_ascendc::PlatformAscendC(context->GetPlatformInfo());
+    uint64_t ub_size;
+    ascendcPlatform.GetCoreMemSize(platform_ascendc::CoreMemType::UB, ub_size);
+    auto aivNum = ascendcPlatform.GetCoreNum();
+    // 合并 condition、x1、x2、x3 的广播形状，规则与 Pows、SelectV2 相同。
+    BroadcastPlanner planner;
+    for (uint32_t i = 0; i < INPUT_NUM; ++i) {
+        planner.AddInput(context->GetInputShape(i)->GetStorageShape());
+    }
+    if (!planner.Plan()) {
+        return ge::GRAPH_FAILED;
+    }
+    const gert::RuntimeAttrs* attrs = context->GetAttrs();
+    const bool* signAwareAttr = attrs->GetAttrPointer<bool>(0);
+    bool sign_aware = (signAwareAttr != nullptr) && *signAwareAttr;
+
+    // x1、x2、x3、y 同 dtype：float 或 half / bf16。
+    auto inputx1 = context->GetInputDesc(1)->GetDataType();
+    uint32_t sizeofdatatype = (inputx1 == ge::DT_FLOAT) ? 4 : 2;
+    // TilingKey、Tile 长度、核间切分与广播分支的行切分见 pows_select_plan.h。
+    PowsSelectTilingPlan plan;
+    if (!PlanPowsSelectTiling(planner, sizeofdatatype, sign_aware, ub_size, aivNum, plan)) {
+        return ge::GRAPH_FAILED;
+    }
+
+    tiling.set_ALIGN_NUM(plan.alignNum);
+    tiling.set_block_size(plan.blockSize);
+    SetElementwiseSplit(tiling, plan.split);
+    tiling.set_dim_num(planner.DimNum());
+    uint32_t y_dims[MAX_DIM_NUM];
+    std::copy(planner.OutShape(), planner.OutShape() + MAX_DIM_NUM, y_dims);
+    tiling.set_y_shape(y_dims);
+    uint32_t strides[INPUT_NUM * MAX_DIM_NUM];
+    for (uint32_t i = 0; i < INPUT_NUM; ++i) {
+        std::copy(planner.Strides(i), planner.Strides(i) + MAX_DIM_NUM, strides + i * MAX_DIM_NUM);
+    }
+    tiling.set_strides(strides);
+    tiling.set_row_tile(plan.rows.rowTile);
+    tiling.set_col_tile(plan.rows.colTile);
+
+    context->SetTilingKey(plan.tilingKey);
+    context->SetBlockDim(plan.blockDim);
+    tiling.SaveToBuffer(context->GetRawTilingData()->GetData(), context->GetRawTilingData()->GetCapacity());
+    context->GetRawTilingData()->SetDataSize(tiling.GetDataSize());
+    size_t *currentWorkspace = context->GetWorkspaceSizes(1);
+
+    // 算子本身不需要额外的临时内存；开启 OP_PROFILING 时在系统 workspace 之后为每个核预留打点区域。
+    uint64_t profileSize = OpProfileWorkspaceSize(plan.blockDim);
+    currentWorkspace[0] = profileSize == 0 ? 0 : ascendcPlatform.GetLibApiWorkSpaceSize() + profileSize;
+
+    return ge::GRAPH_SUCCESS;
+}
+
+static TilingPlanCache& PlanCache()
+{
+    static TilingPlanCache cache(TILING_CACHE_CAPACITY);
+    return cache;
+}
+
+// 切分结果只取决于输入形状、dtype、sign_aware 属性与平台信息，相同签名直接复用缓存的 TilingData。
+static ge::graphStatus TilingFunc(gert::TilingContext* context)
+{
+    auto ascendcPlatform = platform_ascendc::PlatformAscendC(context->GetPlatformInfo());
+    uint64_t ub_size;
+    ascendcPlatform.GetCoreMemSize(platform_ascendc::CoreMemType::UB, ub_size);
+    const gert::RuntimeAttrs* attrs = context->GetAttrs();
+    const bool* signAwareAttr = attrs->GetAttrPointer<bool>(0);
+
+    TilingSignature signature;
+    for (uint32_t i = 0; i < INPUT_NUM; ++i) {
+        signature.AppendShape(context->GetInputShape(i)->GetStorageShape());
+    }
+    signature.Append(context->GetInputDesc(1)->GetDataType())
+             .Append((signAwareAttr != nullptr) && *signAwareAttr)
+             .Append(static_cast<int64_t>(ascendcPlatform.GetSocVersion()))
+             .Append(ascendcPlatform.GetCoreNum())
+             .Append(static_cast<int64_t>(ub_size));
+
+    if (PlanCache().LookupAndApply(signature, context)) {
+        return ge::GRAPH_SUCCESS;
+    }
+    ge::graphStatus ret = ComputeTiling(context);
+    TilingPlan plan;
+    if (ret == ge::GRAPH_SUCCESS && CaptureTilingPlan(context, plan)) {
+        PlanCache().Insert(signature, plan);
+    }
+    return ret;
+}
+}
+
+
+namespace ge {
+// y 为 condition、x1、x2、x3 按 NumPy 规则广播后的形状，失败时日志中给出出错的输入与各输入的形状。
+static ge::graphStatus InferShape(gert::InferShapeContext* context)
+{
+    static const char* const NAMES[] = {"condition", "x1", "x2", "x3"};
+    const gert::Shape* inputs[] = {context->GetInputShape(0), context->GetInputShape(1), context->GetInputShape(2),
+                                   context->GetInputShape(3)};
+    gert::Shape* y_shape = context->GetOutputShape(0);
+    BroadcastShapeError error;
+    BroadcastShapeStatus status =
+        InferBroadcastShape(inputs, 4, optiling::BroadcastPlanner::MAX_INPUT_DIM_NUM, *y_shape, &error);
+    if (status != BroadcastShapeStatus::OK) {
+        OP_HOST_LOGE("PowsSelect", "InferShape failed: %s", BroadcastShapeMessage(NAMES, inputs, 4, 0,
+                     optiling::BroadcastPlanner::MAX_INPUT_DIM_NUM, status, error).c_str());
+        return GRAPH_FAILED;
+    }
+    return GRAPH_SUCCESS;
+}
+// y 与 x1、x2、x3 的 dtype 一致，三者不同时推导失败。
+static ge::graphStatus InferDataType(gert::InferDataTypeContext *context)
+{
+    const auto inputDataType = context->GetInputDataType(1);
+    for (size_t i = 2; i <= 3; i++) {
+        if (context->GetInputDataType(i) != inputDataType) {
+            OP_HOST_LOGE("PowsSelect", "InferDataType failed: x%zu (input %zu) dtype %d differs from x1 (input 1) dtype %d",
+                         i, i, static_cast<int>(context->GetInputDataType(i)), static_cast<int>(inputDataType));
+            return ge::GRAPH_FAILED;
+        }
+    }
+    context->SetOutputDataType(0, inputDataType);
+    return ge::GRAPH_SUCCESS;
+}
+}
+
+
+namespace ops {
+// y = where(condition, pow(x1, x2), x3)：Pows 的结果在 UB 中直接参与 select，不写回 GM。
+// 与 Pows 后接 SelectV2 相比少一次整张量的写出与读回。
+class PowsSelect : public OpDef {
+public:
+    explicit PowsSelect(const char* name) : OpDef(name)
+    {
+        this->Input("condition")
+            .ParamType(REQUIRED)
+            .DataType({ge::DT_BOOL, ge::DT_BOOL, ge::DT_BOOL})
+            .Format({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND})
+            .UnknownShapeFormat({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND});
+        this->Input("x1")
+            .ParamType(REQUIRED)
+            .DataType({ge::DT_FLOAT, ge::DT_FLOAT16, ge::DT_BF16})
+            .Format({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND})
+            .UnknownShapeFormat({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND});
+        this->Input("x2")
+            .ParamType(REQUIRED)
+            .DataType({ge::DT_FLOAT, ge::DT_FLOAT16, ge::DT_BF16})
+            .Format({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND})
+            .UnknownShapeFormat({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND});
+        this->Input("x3")
+            .ParamType(REQUIRED)
+            .DataType({ge::DT_FLOAT, ge::DT_FLOAT16, ge::DT_BF16})
+            .Format({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND})
+            .UnknownShapeFormat({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND});
+        this->Output("y")
+            .ParamType(REQUIRED)
+            .DataType({ge::DT_FLOAT, ge::DT_FLOAT16, ge::DT_BF16})
+            .Format({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND})
+            .UnknownShapeFormat({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND});
+
+        // 与 Pows 的 sign_aware 相同：按 std::pow 语义处理负底数与 0/1 等特殊值。
+        this->Attr("sign_aware").AttrType(OPTIONAL).Bool(false);
+
+        this->SetInferShape(ge::InferShape).SetInferDataType(ge::InferDataType);
+
+        this->AICore()
+            .SetTiling(optiling::TilingFunc);
+        OpAICoreConfig aicConfig;
+        aicConfig.DynamicCompileStaticFlag(true)
+            .DynamicFormatFlag(false)
+            .DynamicRankSupportFlag(true)
+            .DynamicShapeSupportFlag(true)
+            .NeedCheckSupportFlag(false)
+            .PrecisionReduceFlag(true);
+        this->AICore().AddConfig("ascend310b", aicConfig);
+    }
+};
+
+OP_ADD(PowsSelect);
+}
@@ -0,0 +1,117 @@
+#ifndef POWS_SELECT_PLAN_H
+#define POWS_SELECT_PLAN_H
+
+#include <algorithm>
+#include <cstdint>
+#include "../../common/op_host/ub_planner.h"
+#include "../../common/op_host/broadcast_planner.h"
+#include "../../common/op_host/elementwise_tiling.h"
+#include "../../common/op_host/tuned_tiling.h"
+
+namespace optiling {
+// PowsSelect 的切分方案只取决于合并后的形状、元素宽度、sign_aware 属性与平台的 UB 大小和核数，
+// 这里不依赖 TilingContext，TilingFunc 与 tools 中的 CPU 仿真基准共用同一套计算。
+
+// 核函数的分支，TilingKey 在此基础上 sign_aware 时加 10（与 Pows 一致）、逐元素分支三缓冲时再加 TILING_KEY_TRIPLE_BUFFER。
+const uint32_t POWS_SELECT_BRANCH_TENSOR = 1;      // condition、x1、x2、x3 同形状，逐元素
+const uint32_t POWS_SELECT_BRANCH_BROADCAST = 2;   // 需要广播
+const uint32_t POWS_SELECT_KEY_SIGN_AWARE = 10;
+
+// 核函数的 UB 占用，需与 op_kernel/pows_select.cpp 中的 InitBuffer 保持一致：
+//   队列：condition（1 字节）、x1、x2、x3、y，各 depth 块，pow 的结果直接写在 y 上，没有中间 Tensor；
+//   PowsCompute：half / bf16 需要 x1、x2 的 float 中间结果，sign-aware 另需 y 的 float 中间结果，
+//     PowsSignFixup 需要 3 个 float / int32 临时 Buffer 与 4 个按位掩码；
+//   SelectCompute：condition 的 half 副本与 Compare 输出的按位掩码。
+inline UbPlanner PowsSelectUbPlan(uint32_t sizeofdatatype, bool sign_aware, uint32_t depth)
+{
+    UbPlanner planner;
+    planner.Queue(sizeof(uint8_t), depth)
+           .Queue(sizeofdatatype, depth)
+           .Queue(sizeofdatatype, depth)
+           .Queue(sizeofdatatype, depth)
+           .Queue(sizeofdatatype, depth);
+    if (sizeofdatatype != sizeof(float)) {
+        planner.Buffer(sizeof(float), sign_aware ? 3 : 2);
+    }
+    if (sign_aware) {
+        planner.Buffer(sizeof(float), 3)
+               .BitMask(4);
+    }
+    planner.Buffer(sizeof(uint16_t))
+           .BitMask();
+    return planner;
+}
+
+inline uint32_t PowsSelectTileLength(uint64_t ub_size, uint32_t sizeofdatatype, bool sign_aware, uint32_t align,
+                                     uint32_t depth = PIPELINE_DEPTH_DOUBLE)
+{
+    return PowsSelectUbPlan(sizeofdatatype, sign_aware, depth).TileLength(ub_size, align);
+}
+
+struct PowsSelectTilingPlan {
+    uint32_t branch;         // POWS_SELECT_BRANCH_*
+    uint32_t tilingKey;
+    uint8_t alignNum;        // 一个 32 字节块容纳的元素数
+    uint32_t blockSize;      // 单个 Tile 的元素数
+    uint32_t blockDim;       // 使用的核数
+    uint32_t depth;          // 队列深度
+    ElementwiseSplit split;  // 连续分支的核间切分
+    BroadcastRowSplit rows;  // 广播分支的行切分
+    uint64_t ubBytes;        // 按 blockSize 实际申请的 UB 字节数
+};
+
+// sizeofdatatype 为 x1 的元素宽度：4（float）或 2（half / bf16）。planner 按 condition、x1、x2、x3 的顺序合并。
+// 输出元素数超过 UINT32_MAX（TilingData 按 uint32 记录长度）或 UB 放不下最小的 Tile 时返回 false。
+// tuned 为 nullptr 时查 tuned_tiling_table.h，未命中按公式计算；tools/tiling_autotune 传入候选方案直接评估。
+inline bool PlanPowsSelectTiling(const BroadcastPlanner& planner, uint32_t sizeofdatatype, bool sign_aware,
+                                 uint64_t ub_size, uint32_t coreNum, PowsSelectTilingPlan& plan,
+                                 const TunedTiling* tuned = nullptr)
+{
+    if (planner.OutSize() > UINT32_MAX) {
+        return false;
+    }
+    uint32_t totalLength = static_cast<uint32_t>(planner.OutSize());
+    // 输出为空时没有需要广播的数据，按连续分支处理。
+    plan.branch = (!planner.AllFull() && totalLength != 0) ? POWS_SELECT_BRANCH_BROADCAST : POWS_SELECT_BRANCH_TENSOR;
+    plan.tilingKey = sign_aware ? plan.branch + POWS_SELECT_KEY_SIGN_AWARE : plan.branch;
+    plan.alignNum = static_cast<uint8_t>(COPY_BLOCK_BYTES / sizeofdatatype);
+    plan.depth = PIPELINE_DEPTH_DOUBLE;
+    plan.split = {0, 0, 0, 0};
+    plan.rows = {0, 0, 0};
+    const TunedTiling formula = {};
+    if (tuned == nullptr) {
+        tuned = FindTunedTiling(TUNE_OP_POWS_SELECT, sizeofdatatype, plan.tilingKey, TuneClassOf(planner, 4),
+                                totalLength, ub_size, coreNum);
+    }
+    const TunedTiling& choice = tuned != nullptr ? *tuned : formula;
+    // blockSize 向下对齐到 alignNum * 8 与 COMPARE_ALIGN 中的较大者。
+    uint32_t tile_align = std::max<uint32_t>(plan.alignNum * 8, COMPARE_ALIGN);
+    plan.blockSize = PowsSelectTileLength(ub_size, sizeofdatatype, sign_aware, tile_align);
+    if (plan.blockSize == 0) {
+        return false;
+    }
+    if (plan.branch == POWS_SELECT_BRANCH_TENSOR) {
+        // 核间切分的最小粒度：alignNum * 8 个元素（256 字节），保证每个核的 GM 起始地址 32 字节对齐。
+        plan.split = SplitElementwise(totalLength, TunedCoreNum(choice, coreNum), plan.alignNum * 8);
+        plan.blockDim = plan.split.coreNum;
+        auto tileLengthOf = [&](uint32_t depth) {
+            return PowsSelectTileLength(ub_size, sizeofdatatype, sign_aware, tile_align, depth);
+        };
+        plan.depth = TunedPipelineDepth(choice, plan.split.coreSize, sizeofdatatype, tileLengthOf, plan.blockSize);
+        plan.blockSize = TunedTileLength(choice, plan.blockSize, tile_align);
+        if (plan.depth == PIPELINE_DEPTH_TRIPLE) {
+            plan.tilingKey += TILING_KEY_TRIPLE_BUFFER;
+        }
+    } else {
+        plan.blockSize = TunedTileLength(choice, plan.blockSize, tile_align);
+        // 广播分支每行在 UB 中按 COPY_BLOCK_BYTES 个元素补齐（condition 为 1 字节）。
+        uint32_t rowLength = planner.OutShape()[planner.DimNum() - 1];
+        plan.rows = SplitBroadcastRows(totalLength, rowLength, COPY_BLOCK_BYTES, plan.blockSize);
+        plan.blockDim = BroadcastCoreNum(TunedCoreNum(choice, coreNum), plan.rows);
+    }
+    plan.ubBytes = PowsSelectUbPlan(sizeofdatatype, sign_aware, plan.depth).UsedBytes(plan.blockSize);
+    return true;
+}
+}
+
+#endif  // POWS_SELECT_PLAN_H
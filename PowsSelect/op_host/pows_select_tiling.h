@@ -0,0 +1,19 @@
+
+#include "register/tilingdata_base.h"
+
+namespace optiling {
+BEGIN_TILING_DATA_DEF(PowsSelectTilingData)
+  TILING_DATA_FIELD_DEF(uint32_t, block_size);
+  TILING_DATA_FIELD_DEF(uint32_t, core_size);   
+  TILING_DATA_FIELD_DEF(uint32_t, core_remain);   
+  TILING_DATA_FIELD_DEF(uint32_t, core_tail);
+  TILING_DATA_FIELD_DEF(uint32_t, dim_num);
+  TILING_DATA_FIELD_DEF_ARR(uint32_t, 8, y_shape);       // 合并后的输出形状
+  TILING_DATA_FIELD_DEF_ARR(uint32_t, 32, strides);      // condition、x1、x2、x3 在各维上的步长，广播维为 0
+  TILING_DATA_FIELD_DEF(uint32_t, row_tile);
+  TILING_DATA_FIELD_DEF(uint32_t, col_tile);
+  TILING_DATA_FIELD_DEF(uint8_t, ALIGN_NUM); 
+END_TILING_DATA_DEF;
+
+REGISTER_TILING_DATA_CLASS(PowsSelect, PowsSelectTilingData)
+}
@@ -0,0 +1,280 @@
+#include "kernel_operator.h" // 包含 Ascend C 核心库头文件
+#include "op_profiler.h"
+#include "copy_utils.h"
+#include "broadcast_indexer.h"
+#include "broadcast_tile.h"
+#include "pows_compute.h"
+#include "select_compute.h"
+#include "elementwise_pipeline.h"
+
+
+
+constexpr int32_t BUFFER_NUM = 2;     // 使用双缓冲 (每个队列有 2 个 Buffer)
+constexpr int32_t MAX_DIM_NUM = 8;    // 与 TilingFunc 中合并后形状的最大维度数一致
+constexpr int32_t INPUT_NUM = 4;      // condition、x1、x2、x3
+constexpr uint32_t ROW_ALIGN = 32;    // 广播分支 UB 中每行补齐的元素数：condition 为 1 字节，32 字节对应 32 个元素
+
+// y = where(condition, pow(x1, x2), x3) 的逐元素计算：Pows 的结果直接写在 yLocal 上，
+// 再以 yLocal 作为 select 的 x1 原地选择，pow 的结果不离开 UB。
+// Select 逐元素读写，目的与源为同一块 Tensor 时结果不变。
+template<typename TYPE_X1, typename TYPE_X2, typename TYPE_X3, typename TYPE_Y, bool SIGN_AWARE> class PowsSelectCompute {
+public:
+    __aicore__ inline PowsSelectCompute() {}
+
+    // 申请的 Buffer 需与 op_host/pows_select.cpp 中 PowsSelectTileLength 的统计一致。
+    __aicore__ inline void Init(AscendC::TPipe& pipe, uint32_t tileLength)
+    {
+        pows.Init(pipe, tileLength);
+        select.Init(pipe, tileLength);
+    }
+
+    // length 为参与计算的元素数，补齐部分的结果无效且不会被搬出。
+    __aicore__ inline void Compute(const AscendC::LocalTensor<TYPE_Y>& yLocal, const AscendC::LocalTensor<uint8_t>& conditionLocal,
+                                   const AscendC::LocalTensor<TYPE_X1>& x1Local, const AscendC::LocalTensor<TYPE_X2>& x2Local,
+                                   const AscendC::LocalTensor<TYPE_X3>& x3Local, uint32_t length)
+    {
+        pows.Compute(yLocal, x1Local, x2Local, length);
+        select.Compute(yLocal, conditionLocal, yLocal, x3Local, length);
+    }
+
+private:
+    PowsCompute<TYPE_X1, TYPE_X2, TYPE_Y, SIGN_AWARE> pows;
+    SelectCompute<TYPE_Y, TYPE_X3, TYPE_Y> select;
+};
+
+
+// 逐元素分支：condition、x1、x2、x3、y 按核均分后连续处理，流水线见 ElementwisePipeline，DEPTH 为队列深度。
+template<typename TYPE_X1, typename TYPE_X2, typename TYPE_X3, typename TYPE_Y, bool SIGN_AWARE = false,
+         int32_t DEPTH = BUFFER_NUM> class KernelPowsSelect {
+public:
+    __aicore__ inline KernelPowsSelect() {}
+
+    // ALIGN_NUM：一个 BLOCK_SIZE (32 字节) 可以容纳多少个当前数据类型的元素，核间切分粒度为 ALIGN_NUM * 8 个元素。
+    __aicore__ inline void Init(GM_ADDR condition, GM_ADDR x1, GM_ADDR x2, GM_ADDR x3, GM_ADDR y,
+                                uint8_t ALIGN_NUM, uint32_t block_size, uint32_t core_size, uint32_t core_remain, uint32_t core_tail,
+                                GM_ADDR workspace)
+    {
+        // condition 为 bool，按 uint8 搬运。
+        GM_ADDR inputs[] = {condition, x1, x2, x3};
+        pipeline.Init(inputs, y, ALIGN_NUM * 8, block_size, core_size, core_remain, core_tail, workspace);
+    }
+
+    __aicore__ inline void Process()
+    {
+        pipeline.Process();
+    }
+
+private:
+    ElementwisePipeline<PowsSelectCompute<TYPE_X1, TYPE_X2, TYPE_X3, TYPE_Y, SIGN_AWARE>, TYPE_Y, DEPTH,
+                        uint8_t, TYPE_X1, TYPE_X2, TYPE_X3> pipeline;
+};
+
+
+// 广播分支：与 KernelSelect_Broadcast 相同的行切分与逐行搬入，输入增加为 condition、x1、x2、x3 四个。
+template<typename TYPE_X1, typename TYPE_X2, typename TYPE_X3, typename TYPE_Y, bool SIGN_AWARE = false> class KernelPowsSelect_Broadcast {
+    public:
+        __aicore__ inline KernelPowsSelect_Broadcast() {}
+
+        __aicore__ inline void Init(GM_ADDR condition, GM_ADDR x1, GM_ADDR x2, GM_ADDR x3, GM_ADDR y, uint32_t block_size,
+                                    uint32_t dim_num, uint32_t y_shape[MAX_DIM_NUM], uint32_t strides[INPUT_NUM * MAX_DIM_NUM],
+                                    uint32_t row_tile, uint32_t col_tile, GM_ADDR workspace)
+        {
+            // 输入的步长与输出的连续步长一致时，该输入与输出同形状，可按整块搬入。
+            this->dimNum = dim_num;
+            uint64_t yShape[MAX_DIM_NUM];
+            uint64_t inputSize[INPUT_NUM] = {1, 1, 1, 1};
+            uint64_t ySize = 1;
+            for (int32_t k = 0; k < INPUT_NUM; k++) {
+                this->contiguous[k] = true;
+            }
+            for (int32_t j = this->dimNum - 1; j >= 0; j--) {
+                yShape[j] = y_shape[j];
+                for (int32_t k = 0; k < INPUT_NUM; k++) {
+                    this->inputStrides[k][j] = strides[k * MAX_DIM_NUM + j];
+                    this->contiguous[k] = this->contiguous[k] && (this->inputStrides[k][j] == ySize);
+                    inputSize[k] += (yShape[j] - 1) * this->inputStrides[k][j];
+                }
+                ySize *= yShape[j];
+            }
+            // 行号只在外层 dimNum - 1 维上展开。
+            rowIndexer.Init(this->dimNum - 1, yShape);
+            for (int32_t k = 0; k < INPUT_NUM; k++) {
+                rowIndexer.SetStrides(k, this->inputStrides[k]);
+            }
+            this->rowLength = yShape[this->dimNum - 1];
+            tiler.Init(ySize, this->rowLength, row_tile, col_tile, ROW_ALIGN);
+
+            // condition 为 bool，按 uint8 搬运。
+            conditionGm.SetGlobalBuffer((__gm__ uint8_t*)condition, inputSize[0]);
+            x1Gm.SetGlobalBuffer((__gm__ TYPE_X1*)x1, inputSize[1]);
+            x2Gm.SetGlobalBuffer((__gm__ TYPE_X2*)x2, inputSize[2]);
+            x3Gm.SetGlobalBuffer((__gm__ TYPE_X3*)x3, inputSize[3]);
+            yGm.SetGlobalBuffer((__gm__ TYPE_Y*)y, ySize);
+
+            pipe.InitBuffer(inQueueCondition, BUFFER_NUM, block_size * sizeof(uint8_t));
+            pipe.InitBuffer(inQueueX1, BUFFER_NUM, block_size * sizeof(TYPE_X1));
+            pipe.InitBuffer(inQueueX2, BUFFER_NUM, block_size * sizeof(TYPE_X2));
+            pipe.InitBuffer(inQueueX3, BUFFER_NUM, block_size * sizeof(TYPE_X3));
+            pipe.InitBuffer(outQueueY, BUFFER_NUM, block_size * sizeof(TYPE_Y));
+            computer.Init(pipe, block_size);
+            profiler.Init(workspace);
+        }
+
+        __aicore__ inline void Process()
+        {
+            for (uint32_t i = tiler.tileStart; i < tiler.tileEnd; i++) {
+                profiler.TileBegin();
+                BroadcastTile tile = tiler.Locate(i);
+                CopyIn(tile);
+                profiler.Mark(OP_PROFILE_COPY_IN);
+                Compute(tile);
+                profiler.Mark(OP_PROFILE_COMPUTE);
+                CopyOut(tile);
+                profiler.Mark(OP_PROFILE_COPY_OUT);
+                profiler.AddBytes(InputBytes<uint8_t>(0, tile) + InputBytes<TYPE_X1>(1, tile) + InputBytes<TYPE_X2>(2, tile) +
+                                  InputBytes<TYPE_X3>(3, tile),
+                                  static_cast<uint64_t>(tile.rows) * tile.cols * sizeof(TYPE_Y));
+            }
+            profiler.Finish();
+        }
+
+    private:
+        // 与 CopyIn 对应，一个 Tile 实际从 GM 读取的字节数，仅用于性能打点。
+        template<typename T>
+        __aicore__ inline uint64_t InputBytes(int32_t k, const BroadcastTile& tile)
+        {
+            if (!this->contiguous[k] && this->inputStrides[k][this->dimNum - 1] == 0) {
+                return static_cast<uint64_t>(tile.rows) * sizeof(T);
+            }
+            return static_cast<uint64_t>(tile.rows) * tile.cols * sizeof(T);
+        }
+
+        // 第 k 个输入的一个 Tile：同形状时整块搬入，否则逐行搬入（最内维被广播时逐行 Duplicate）。
+        template<typename T>
+        __aicore__ inline void CopyInInput(int32_t k, const AscendC::LocalTensor<T>& local, const AscendC::GlobalTensor<T>& gm,
+                                           const BroadcastTile& tile)
+        {
+            if (this->contiguous[k]) {
+                CopyInTile(local, gm, this->rowLength, tile);
+                return;
+            }
+            // 每个 Tile 只分解一次起始行号，之后逐行前进，行内没有除法与取模。
+            uint32_t inner = this->dimNum - 1;
+            rowIndexer.Seek(tile.rowStart);
+            for (uint32_t r = 0; r < tile.rows; r++) {
+                CopyInRow(local[r * tile.colPad], gm, rowIndexer.Offset(k), this->inputStrides[k][inner], tile);
+                rowIndexer.Next();
+            }
+        }
+
+        __aicore__ inline void CopyIn(const BroadcastTile& tile)
+        {
+            AscendC::LocalTensor<uint8_t> conditionLocal = inQueueCondition.AllocTensor<uint8_t>();
+            AscendC::LocalTensor<TYPE_X1> x1Local = inQueueX1.AllocTensor<TYPE_X1>();
+            AscendC::LocalTensor<TYPE_X2> x2Local = inQueueX2.AllocTensor<TYPE_X2>();
+            AscendC::LocalTensor<TYPE_X3> x3Local = inQueueX3.AllocTensor<TYPE_X3>();
+
+            CopyInInput(0, conditionLocal, conditionGm, tile);
+            CopyInInput(1, x1Local, x1Gm, tile);
+            CopyInInput(2, x2Local, x2Gm, tile);
+            CopyInInput(3, x3Local, x3Gm, tile);
+
+            inQueueCondition.EnQue(conditionLocal);
+            inQueueX1.EnQue(x1Local);
+            inQueueX2.EnQue(x2Local);
+            inQueueX3.EnQue(x3Local);
+        }
+
+        __aicore__ inline void Compute(const BroadcastTile& tile)
+        {
+            AscendC::LocalTensor<uint8_t> conditionLocal = inQueueCondition.DeQue<uint8_t>();
+            AscendC::LocalTensor<TYPE_X1> x1Local = inQueueX1.DeQue<TYPE_X1>();
+            AscendC::LocalTensor<TYPE_X2> x2Local = inQueueX2.DeQue<TYPE_X2>();
+            AscendC::LocalTensor<TYPE_X3> x3Local = inQueueX3.DeQue<TYPE_X3>();
+            AscendC::LocalTensor<TYPE_Y> yLocal = outQueueY.AllocTensor<TYPE_Y>();
+
+            computer.Compute(yLocal, conditionLocal, x1Local, x2Local, x3Local, tile.rows * tile.colPad);
+
+            outQueueY.EnQue<TYPE_Y>(yLocal);
+            inQueueCondition.FreeTensor(conditionLocal);
+            inQueueX1.FreeTensor(x1Local);
+            inQueueX2.FreeTensor(x2Local);
+            inQueueX3.FreeTensor(x3Local);
+        }
+
+        __aicore__ inline void CopyOut(const BroadcastTile& tile)
+        {
+            AscendC::LocalTensor<TYPE_Y> yLocal = outQueueY.DeQue<TYPE_Y>();
+            CopyOutTile(yGm, yLocal, this->rowLength, tile);
+            outQueueY.FreeTensor(yLocal);
+        }
+
+    private:
+        AscendC::TPipe pipe;
+        AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueCondition;
+        AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueX1;
+        AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueX2;
+        AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueX3;
+        AscendC::TQue<AscendC::QuePosition::VECOUT, BUFFER_NUM> outQueueY;
+        // 固定变量
+        uint32_t dimNum, rowLength;
+        BroadcastTiler tiler;
+        bool contiguous[INPUT_NUM];    // condition、x1、x2、x3 是否与输出同形状
+
+        AscendC::GlobalTensor<uint8_t> conditionGm;
+        AscendC::GlobalTensor<TYPE_X1> x1Gm;
+        AscendC::GlobalTensor<TYPE_X2> x2Gm;
+        AscendC::GlobalTensor<TYPE_X3> x3Gm;
+        AscendC::GlobalTensor<TYPE_Y> yGm;
+
+        uint64_t inputStrides[INPUT_NUM][MAX_DIM_NUM];
+        BroadcastIndexer<INPUT_NUM> rowIndexer;    // 输出行号对应的 condition、x1、x2、x3 起始偏移
+        PowsSelectCompute<TYPE_X1, TYPE_X2, TYPE_X3, TYPE_Y, SIGN_AWARE> computer;
+        OpProfiler profiler;
+};
+
+
+extern "C" __global__ __aicore__ void pows_select(GM_ADDR condition, GM_ADDR x1, GM_ADDR x2, GM_ADDR x3, GM_ADDR y,
+                                                  GM_ADDR workspace, GM_ADDR tiling) {
+
+    GET_TILING_DATA(tiling_data, tiling);
+    // TilingKey：1 逐元素，2 广播；加 10 为 sign-aware 版本；逐元素分支加 100 为三缓冲版本。
+    if (TILING_KEY_IS(1)) {
+        KernelPowsSelect<DTYPE_X1, DTYPE_X2, DTYPE_X3, DTYPE_Y> op;
+        op.Init(condition, x1, x2, x3, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(2)) {
+        KernelPowsSelect_Broadcast<DTYPE_X1, DTYPE_X2, DTYPE_X3, DTYPE_Y> op;
+        op.Init(condition, x1, x2, x3, y, tiling_data.block_size,
+            tiling_data.dim_num, tiling_data.y_shape, tiling_data.strides,
+            tiling_data.row_tile, tiling_data.col_tile, workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(11)) {
+        KernelPowsSelect<DTYPE_X1, DTYPE_X2, DTYPE_X3, DTYPE_Y, true> op;
+        op.Init(condition, x1, x2, x3, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(12)) {
+        KernelPowsSelect_Broadcast<DTYPE_X1, DTYPE_X2, DTYPE_X3, DTYPE_Y, true> op;
+        op.Init(condition, x1, x2, x3, y, tiling_data.block_size,
+            tiling_data.dim_num, tiling_data.y_shape, tiling_data.strides,
+            tiling_data.row_tile, tiling_data.col_tile, workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(101)) {
+        KernelPowsSelect<DTYPE_X1, DTYPE_X2, DTYPE_X3, DTYPE_Y, false, 3> op;
+        op.Init(condition, x1, x2, x3, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(111)) {
+        KernelPowsSelect<DTYPE_X1, DTYPE_X2, DTYPE_X3, DTYPE_Y, true, 3> op;
+        op.Init(condition, x1, x2, x3, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    }
+
+}
@@ -2,205 +2,247 @@
 #include "select_v2_tiling.h"
 #include "register/op_def_registry.h"
 #include "tiling/platform/platform_ascendc.h"
+#include "../../common/include/op_profile_layout.h"
+#include "../../common/op_host/tiling_cache.h"
+#include "../../common/op_host/broadcast_planner.h"
+#include "../../common/op_host/broadcast_shape.h"
+#include "../../common/op_host/op_log.h"
+#include "../../common/op_host/elementwise_tiling.h"
+#include "select_v2_plan.h"
+#include <vector>
 
 
 namespace optiling {
-const uint32_t BLOCK_SIZE = 32;
-static ge::graphStatus TilingFunc(gert::TilingContext* context)
+const uint32_t MAX_DIM_NUM = BroadcastPlanner::MAX_DIM_NUM;
+const size_t TILING_CACHE_CAPACITY = 256;
+
+// select 只按元素宽度搬运位，同宽度的 dtype 共用一套计算；不支持的 dtype 返回 0。
+static uint32_t SelectElementSize(ge::DataType dtype)
 {
-    SelectV2TilingData tiling;
-    uint32_t y_dim[4] = {0};
-    const gert::StorageShape* y_shape = context->GetOutputShape(0);       
-    for (int j = 0; j < y_shape->GetStorageShape().GetDimNum(); j++) {  
-        y_dim[j] = y_shape->GetStorageShape().GetDim(j);                   
-    } 
-    tiling.set_y_shape(y_dim);
+    switch (dtype) {
+        case ge::DT_BOOL:
+        case ge::DT_INT8:
+        case ge::DT_UINT8:
+            return 1;
+        case ge::DT_FLOAT16:
+        case ge::DT_BF16:
+        case ge::DT_INT16:
+            return 2;
+        case ge::DT_FLOAT:
+        case ge::DT_INT32:
+            return 4;
+        case ge::DT_INT64:
+            return 8;
+        default:
+            return 0;
+    }
+}
 
+static ge::graphStatus ComputeTiling(gert::TilingContext* context)
+{
+    SelectV2TilingData tiling;
     uint32_t sizeofdatatype;
-    int32_t NUM = 24;
 
     auto ascendcPlatform = platform_ascendc::PlatformAscendC(context->GetPlatformInfo());
     auto socVersion = ascendcPlatform.GetSocVersion();
     uint64_t ub_size;
     ascendcPlatform.GetCoreMemSize(platform_ascendc::CoreMemType::UB, ub_size); 
     auto aivNum = ascendcPlatform.GetCoreNum();
-    uint32_t input_num=3;
-    //用于存维度数
-    uint32_t shapeInf[3 * 10] = {};
-    uint32_t inputLength[3] = {};
-    uint32_t length = 0;  
-    // 获取最大维度数
-    for (int i = 0; i < input_num; ++i) 
-        length = std::max<uint32_t>(length, context->GetInputShape(i)->GetStorageShape().GetDimNum());
-    // 获取输入形状，维度数，以及输入数据大小
-    for (int i = 0; i < input_num; ++i) { 
-        const gert::StorageShape* shape = context->GetInputShape(i);
-        inputLength[i] = context->GetInputTensor(i)->GetShapeSize();        
-        shapeInf[i*4+0]=shape->GetStorageShape().GetDimNum();             
-        for (int j = 1; j <= shape->GetStorageShape().GetDimNum(); j++) {  
-            shapeInf[i*4+j] = shape->GetStorageShape().GetDim(j-1);                   
-        } 
-    }  
-    // 获取最大元素值
-    uint32_t total_length = 0;
-    for (int i = 0; i < input_num; ++i) {  
-        total_length = std::max<uint32_t>(total_length, context->GetInputTensor(i)->GetShapeSize());
-    }    
-    //判断是否需要广播
-    bool boardCast = 0;    
-    if (inputLength[0] != total_length ||       
-        inputLength[1] != total_length ||
-        inputLength[2] != total_length) {    
-        boardCast = 1;  
-    }  
-    tiling.set_boardCast(boardCast);
-    //用于存数据元素个数
-    uint32_t totalLength = total_length;
-    
-    // 获取第一个输入的数据类型。
-    auto inputx1 = context->GetInputTensor(1)->GetDataType();
-    uint32_t tmp_x = 2;
-    // 开始条件判断：根据数据类型设置不同的参数。
-    // 如果数据类型是 INT8 (ge::DT_INT8)。
-    if(inputx1 == ge::DT_INT8){
-        // 设置数据类型大小为 1 字节。
-        sizeofdatatype = 1;
-        // 将经验参数 NUM 调整为 15。
-        NUM = 13;
-    // 如果数据类型是 FP16 (ge::DT_FLOAT16)。
-    }else if(inputx1 == ge::DT_FLOAT16){
-        // 设置数据类型大小为 2 字节。
-        sizeofdatatype = 2;
-        // 将经验参数 NUM 调整为 9。
-        NUM = 7;
-    // 如果数据类型是 INT32 (ge::DT_INT32)。
-    } else if (inputx1 == ge::DT_INT32) {
-        // 设置数据类型大小为 4 字节。
-        sizeofdatatype = 4;
-        // 将经验参数 NUM 调整为 11 (9+2)。
-        NUM = 8+2;
-        // 将调整因子 tmp_x 设为 1。
-        tmp_x = 1;
-    // 对于其他数据类型，如 FP32。
-    } else if (inputx1 == ge::DT_FLOAT) {
-        // 默认设置数据类型大小为 2 字节。
-        sizeofdatatype = 2;
-        // 默认将经验参数 NUM 调整为 9。
-        NUM = 8;
-    } else { 
-        // 默认设置数据类型大小为 2 字节。
-        sizeofdatatype = 2;
-        // 默认将经验参数 NUM 调整为 9。
-        NUM = 7;
+    uint32_t input_num = 3;
+    // 可选属性 packed_condition：condition 已按 Select 的掩码格式每个元素 1 bit 打包（PackCondition 的输出）。
+    const gert::RuntimeAttrs* attrs = context->GetAttrs();
+    const bool* packedAttr = attrs->GetAttrPointer<bool>(0);
+    bool packed = (packedAttr != nullptr) && *packedAttr;
+    // 可选属性 skip_uniform_tiles：condition 多为整段全 1 / 全 0（如 padding 掩码）时，逐 Tile 跳过用不到的输入。
+    const bool* skipAttr = attrs->GetAttrPointer<bool>(1);
+    bool skip_uniform = (skipAttr != nullptr) && *skipAttr;
+    // 合并 condition、x1、x2 的广播形状，得到合并后的输出形状与各输入的步长（广播维步长为 0）。
+    // 只依赖 shape，动态 shape 下输入不是常量 Tensor 也能切分。
+    // 打包的 condition 不参与广播，只合并 x1、x2，并要求二者同形状、condition 恰好覆盖全部元素。
+    BroadcastPlanner planner;
+    for (uint32_t i = packed ? 1 : 0; i < input_num; ++i) {
+        planner.AddInput(context->GetInputShape(i)->GetStorageShape());
+    }
+    if (!planner.Plan()) {
+        return ge::GRAPH_FAILED;
+    }
+    //用于存数据元素个数：按广播后的输出计算，TilingData 按 uint32 记录长度
+    if (planner.OutSize() > UINT32_MAX) {
+        return ge::GRAPH_FAILED;
     }
+    if (packed && !PackedConditionMatches(planner,
+        static_cast<uint64_t>(context->GetInputShape(0)->GetStorageShape().GetShapeSize()))) {
+        return ge::GRAPH_FAILED;
+    }
+    // 获取 x1 的数据类型，只按元素宽度区分。
+    sizeofdatatype = SelectElementSize(context->GetInputDesc(1)->GetDataType());
+    if (sizeofdatatype == 0) {
+        return ge::GRAPH_FAILED;
+    }
+
+    // 选择 TilingKey，并按核函数实际申请的 Buffer 求 Tile 大小、核间切分或广播分支的行切分，见 select_v2_plan.h。
+    SelectTilingPlan plan;
+    if (!PlanSelectTiling(planner, packed, skip_uniform, sizeofdatatype, ub_size, aivNum, plan)) {
+        return ge::GRAPH_FAILED;
+    }
+    uint32_t tiling_key = plan.tilingKey;
+    aivNum = plan.blockDim;
 
-    // 计算 ALIGN_NUM：一个 BLOCK_SIZE (32 字节) 可以容纳多少个当前数据类型的元素。
-    // 这是数据对齐的基本单位（元素个数）。
-    uint8_t ALIGN_NUM = BLOCK_SIZE / sizeofdatatype;
-    // 计算 tiling_size：这是 Tiling 的核心参数之一。
-    // 它估算在 UB 内存限制下，单次处理（或单核单次迭代）可以处理多少个 BLOCK_SIZE 块。
-    // (总 UB 大小 / 每个块大小 / 调整因子 tmp_x) / 经验参数 NUM
-    uint32_t tiling_size = ((ub_size) / BLOCK_SIZE / tmp_x) / NUM;
-    // 调整 tiling_size：如果 tiling_size 大于 8，则将其向下取整到最近的 8 的倍数。
-    // 这通常是为了匹配硬件的向量处理能力（例如，一次处理 8 个向量）。
-    tiling_size = tiling_size <= 8 ? tiling_size : tiling_size / 8 * 8;
-    // 计算 block_size：将 tiling_size（块的数量）乘以 ALIGN_NUM（每块的元素数），
-    // 得到核函数内部处理的基本数据块的大小（单位：元素数量）。
-    uint32_t block_size = tiling_size * ALIGN_NUM;
-    // 调整要使用的 AI Core 数量 aivNum：
-    // 取“物理可用核心数”和“总工作量 / 每个块的大小 所需的块数”中的较小值。
-    // 防止分配的核心数超过实际工作所需的数量。
-    aivNum = (aivNum < totalLength / block_size) ? aivNum : (totalLength / block_size);
-    aivNum = aivNum >= 1 ? aivNum : 1;
-
-    // 计算 core_size：每个 AI Core 负责处理的主要（对齐）部分的数据量（单位：元素数量）。
-    // (总元素数 / 使用的核心数) 先得到每个核心大致处理量，
-    // 然后除以 (ALIGN_NUM * 8) 再乘以 (ALIGN_NUM * 8)，实现向下对齐到 ALIGN_NUM * 8 的倍数。
-    // ALIGN_NUM * 8 可能是一个更优的处理粒度。
-    uint32_t core_size = (totalLength / aivNum) / (ALIGN_NUM * 8) * (ALIGN_NUM * 8);
-    // 计算 core_remain：总元素数量减去所有核心处理的对齐部分的总和，
-    // 得到剩余的、未能被对齐处理的元素数量。这些通常需要特殊处理。
-    uint32_t core_remain = totalLength - aivNum * core_size;
-
-    // 将计算出的 ALIGN_NUM 保存到 tiling 对象中。
-    tiling.set_ALIGN_NUM(ALIGN_NUM);
-
-    // 将计算出的核内处理块大小 block_size 保存到 tiling 对象中。
-    tiling.set_block_size(block_size);
-
-    // 将计算出的每个核心主要处理量 core_size 保存到 tiling 对象中。
-    tiling.set_core_size(core_size);
-
-    // 将计算出的剩余元素数量 core_remain 保存到 tiling 对象中。
-    tiling.set_core_remain(core_remain);
-
-    // 将之前获取并存储的输入形状信息 shapeInf 保存到 tiling 对象中。
-    tiling.set_shapeInf(shapeInf);
+    // 将 ALIGN_NUM、block_size、核间切分、合并后的形状与步长、广播分支的 Tile 划分保存到 tiling 对象中。
+    FillSelectTilingData(planner, packed, plan, tiling);
 
+    context->SetTilingKey(tiling_key);
     context->SetBlockDim(aivNum);
     tiling.SaveToBuffer(context->GetRawTilingData()->GetData(), context->GetRawTilingData()->GetCapacity());
     context->GetRawTilingData()->SetDataSize(tiling.GetDataSize());
     // 获取用于设置 Workspace（工作空间，临时内存）大小的数组指针。参数 1 表示需要 1 个 Workspace 区域。
     size_t *currentWorkspace = context->GetWorkspaceSizes(1);
 
-    // 设置第一个（也是唯一一个）Workspace 的大小为 0。
-    // 表示根据当前的 Tiling 计算，该算子执行不需要额外的临时内存。
-    currentWorkspace[0] = 0;
+    // 算子本身不需要额外的临时内存；开启 OP_PROFILING 时在系统 workspace 之后为每个核预留打点区域。
+    uint64_t profileSize = OpProfileWorkspaceSize(aivNum);
+    currentWorkspace[0] = profileSize == 0 ? 0 : ascendcPlatform.GetLibApiWorkSpaceSize() + profileSize;
 
     return ge::GRAPH_SUCCESS;
 }
+
+static TilingPlanCache& PlanCache()
+{
+    static TilingPlanCache cache(TILING_CACHE_CAPACITY);
+    return cache;
+}
+
+// 切分结果只取决于输入形状、dtype 与平台信息，相同签名直接复用缓存的 TilingData。
+static ge::graphStatus TilingFunc(gert::TilingContext* context)
+{
+    auto ascendcPlatform = platform_ascendc::PlatformAscendC(context->GetPlatformInfo());
+    uint64_t ub_size;
+    ascendcPlatform.GetCoreMemSize(platform_ascendc::CoreMemType::UB, ub_size);
+
+    const gert::RuntimeAttrs* attrs = context->GetAttrs();
+    const bool* packedAttr = attrs->GetAttrPointer<bool>(0);
+    const bool* skipAttr = attrs->GetAttrPointer<bool>(1);
+
+    TilingSignature signature;
+    for (int i = 0; i < 3; ++i) {
+        signature.AppendShape(context->GetInputShape(i)->GetStorageShape());
+    }
+    signature.Append(context->GetInputDesc(1)->GetDataType())
+             .Append((packedAttr != nullptr) && *packedAttr)
+             .Append((skipAttr != nullptr) && *skipAttr)
+             .Append(static_cast<int64_t>(ascendcPlatform.GetSocVersion()))
+             .Append(ascendcPlatform.GetCoreNum())
+             .Append(static_cast<int64_t>(ub_size));
+
+    if (PlanCache().LookupAndApply(signature, context)) {
+        return ge::GRAPH_SUCCESS;
+    }
+    ge::graphStatus ret = ComputeTiling(context);
+    TilingPlan plan;
+    if (ret == ge::GRAPH_SUCCESS && CaptureTilingPlan(context, plan)) {
+        PlanCache().Insert(signature, plan);
+    }
+    return ret;
+}
 } 
 
 
 namespace ge {
+// y 为 condition、x1、x2 按 NumPy 规则广播后的形状；packed_condition 时 condition 为打包掩码，只广播 x1、x2。
+// 维度数超限或形状不兼容时推导失败，日志中给出出错的输入与各输入的形状。
 static ge::graphStatus InferShape(gert::InferShapeContext* context)
 {
-    // const gert::Shape* x2_shape = context->GetInputShape(0);
+    static const char* const NAMES[] = {"condition", "x1", "x2"};
+    const gert::RuntimeAttrs* attrs = context->GetAttrs();
+    const bool* packedAttr = attrs == nullptr ? nullptr : attrs->GetAttrPointer<bool>(0);
+    bool packed = (packedAttr != nullptr) && *packedAttr;
+    const gert::Shape* inputs[] = {context->GetInputShape(0), context->GetInputShape(1), context->GetInputShape(2)};
     gert::Shape* y_shape = context->GetOutputShape(0);
-    *y_shape = *context->GetOutputShape(0);
+    uint32_t first = packed ? 1 : 0;
+    BroadcastShapeError error;
+    BroadcastShapeStatus status = InferBroadcastShape(inputs + first, 3 - first,
+                                                      optiling::BroadcastPlanner::MAX_INPUT_DIM_NUM, *y_shape, &error);
+    if (status != BroadcastShapeStatus::OK) {
+        OP_HOST_LOGE("SelectV2", "InferShape failed: %s", BroadcastShapeMessage(NAMES + first, inputs + first,
+                     3 - first, first, optiling::BroadcastPlanner::MAX_INPUT_DIM_NUM, status, error).c_str());
+        return GRAPH_FAILED;
+    }
     return GRAPH_SUCCESS;
 }
-// static ge::graphStatus InferDataType(gert::InferDataTypeContext *context)
-// {
-// const auto inputDataType = context->GetInputDataType(1);
-// context->SetOutputDataType(0, inputDataType);
-// return ge::GRAPH_SUCCESS;
-// }
+// y 与 x1、x2 的 dtype 一致。
+static ge::graphStatus InferDataType(gert::InferDataTypeContext *context)
+{
+    const auto inputDataType = context->GetInputDataType(1);
+    if (context->GetInputDataType(2) != inputDataType) {
+        OP_HOST_LOGE("SelectV2", "InferDataType failed: x1 (input 1) and x2 (input 2) have different dtypes %d and %d",
+                     static_cast<int>(inputDataType), static_cast<int>(context->GetInputDataType(2)));
+        return ge::GRAPH_FAILED;
+    }
+    context->SetOutputDataType(0, inputDataType);
+    return ge::GRAPH_SUCCESS;
+}
 }
 
 
 namespace ops {
+// x1、x2、y 支持的 dtype，condition 为 bool 与 uint8（packed_condition）时各注册一遍。
+// 核函数只按元素宽度（1 / 2 / 4 / 8 字节）选择，新增同宽度的 dtype 只需加在这里与 SelectElementSize 中。
+static const std::vector<ge::DataType> SELECT_DATA_TYPES = {
+    ge::DT_FLOAT, ge::DT_FLOAT16, ge::DT_INT32, ge::DT_INT8, ge::DT_BF16, ge::DT_INT16, ge::DT_UINT8, ge::DT_BOOL,
+    ge::DT_INT64,
+    ge::DT_FLOAT, ge::DT_FLOAT16, ge::DT_INT32, ge::DT_INT8, ge::DT_BF16, ge::DT_INT16, ge::DT_UINT8, ge::DT_BOOL,
+    ge::DT_INT64};
+static const std::vector<ge::DataType> SELECT_CONDITION_TYPES = {
+    ge::DT_BOOL, ge::DT_BOOL, ge::DT_BOOL, ge::DT_BOOL, ge::DT_BOOL, ge::DT_BOOL, ge::DT_BOOL, ge::DT_BOOL,
+    ge::DT_BOOL,
+    ge::DT_UINT8, ge::DT_UINT8, ge::DT_UINT8, ge::DT_UINT8, ge::DT_UINT8, ge::DT_UINT8, ge::DT_UINT8, ge::DT_UINT8,
+    ge::DT_UINT8};
+static const std::vector<ge::Format> SELECT_FORMATS(SELECT_DATA_TYPES.size(), ge::FORMAT_ND);
+
 class SelectV2 : public OpDef {
 public:
     explicit SelectV2(const char* name) : OpDef(name)
     {
         this->Input("condition")
             .ParamType(REQUIRED)
-            .DataType({ge::DT_BOOL, ge::DT_BOOL, ge::DT_BOOL, ge::DT_BOOL})
-            .Format({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND})
-            .UnknownShapeFormat({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND});
+            .DataType(SELECT_CONDITION_TYPES)
+            .Format(SELECT_FORMATS)
+            .UnknownShapeFormat(SELECT_FORMATS);
         this->Input("x1")
             .ParamType(REQUIRED)
-            .DataType({ge::DT_FLOAT, ge::DT_FLOAT16, ge::DT_INT32, ge::DT_INT8})
-            .Format({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND})
-            .UnknownShapeFormat({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND});
+            .DataType(SELECT_DATA_TYPES)
+            .Format(SELECT_FORMATS)
+            .UnknownShapeFormat(SELECT_FORMATS);
         this->Input("x2")
             .ParamType(REQUIRED)
-            .DataType({ge::DT_FLOAT, ge::DT_FLOAT16, ge::DT_INT32, ge::DT_INT8})
-            .Format({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND})
-            .UnknownShapeFormat({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND});
+            .DataType(SELECT_DATA_TYPES)
+            .Format(SELECT_FORMATS)
+            .UnknownShapeFormat(SELECT_FORMATS);
         this->Output("y")
             .ParamType(REQUIRED)
-            .DataType({ge::DT_FLOAT, ge::DT_FLOAT16, ge::DT_INT32, ge::DT_INT8})
-            .Format({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND})
-            .UnknownShapeFormat({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND});
-
-        // this->SetInferShape(ge::InferShape).SetInferDataType(ge::InferDataType);
-        this->SetInferShape(ge::InferShape);
+            .DataType(SELECT_DATA_TYPES)
+            .Format(SELECT_FORMATS)
+            .UnknownShapeFormat(SELECT_FORMATS);
+
+        // packed_condition 为 true 时 condition 为 uint8，每个字节打包 8 个元素（低位在前），x1、x2 需同形状。
+        this->Attr("packed_condition").AttrType(OPTIONAL).Bool(false);
+        // skip_uniform_tiles 为 true 时，condition 全为 1 / 全为 0 的 Tile 只读取 x1 / x2，适合结构化的掩码。
+        this->Attr("skip_uniform_tiles").AttrType(OPTIONAL).Bool(false);
+        // y 可以与 x1 或 x2 共用同一块内存（原地执行）。该输入与 y 同形状时各核并行，每个元素都在写回之前读取，
+        // 选中的 Tile 或整个输出正是 y 所在的输入时直接跳过搬运；该输入被广播或为标量时，
+        // 核函数比较 GM 地址后改为 0 号核串行处理（广播分支按 Tile 倒序），保证结果正确。
+        this->SetInferShape(ge::InferShape).SetInferDataType(ge::InferDataType);
 
         this->AICore()
             .SetTiling(optiling::TilingFunc);
-        this->AICore().AddConfig("ascend310b");
+        // 动态 shape：核函数按 dtype / TilingKey 只编译一次，shape 变化时只需重新调用 TilingFunc。
+        OpAICoreConfig aicConfig;
+        aicConfig.DynamicCompileStaticFlag(true)
+            .DynamicFormatFlag(false)
+            .DynamicRankSupportFlag(true)
+            .DynamicShapeSupportFlag(true)
+            .NeedCheckSupportFlag(false)
+            .PrecisionReduceFlag(true);
+        this->AICore().AddConfig("ascend310b", aicConfig);
 
     }
 };
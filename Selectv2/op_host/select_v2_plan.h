@@ -0,0 +1,233 @@
+#ifndef SELECT_V2_PLAN_H
+#define SELECT_V2_PLAN_H
+
+#include <algorithm>
+#include <cstdint>
+#include "../../common/op_host/ub_planner.h"
+#include "../../common/op_host/broadcast_planner.h"
+#include "../../common/op_host/elementwise_tiling.h"
+#include "../../common/op_host/tuned_tiling.h"
+
+namespace optiling {
+// SelectV2 的切分方案只取决于合并后的形状、元素宽度、属性与平台的 UB 大小和核数，
+// 这里不依赖 TilingContext，TilingFunc 与 tools 中的 CPU 仿真基准共用同一套计算。
+const uint32_t PACKED_UNIT = 256;      // 打包 condition 的切分粒度：256 个元素对应 32 字节掩码
+
+// TilingKey，与 op_kernel/select_v2.cpp 中的分支一致。
+const uint32_t KEY_TENSOR = 1;             // condition、x1、x2 同形状，逐元素
+const uint32_t KEY_BROADCAST = 2;          // 需要广播
+const uint32_t KEY_PACKED = 3;             // condition 为打包的按位掩码
+const uint32_t KEY_SCALAR_CONDITION = 4;   // condition 只有一个元素，输出直接取 x1 或 x2
+const uint32_t KEY_SCALAR_X2 = 5;          // condition、x1 同形状，x2 只有一个元素
+const uint32_t KEY_SCALAR_X1 = 6;          // condition、x2 同形状，x1 只有一个元素
+const uint32_t KEY_UNIFORM = 7;            // 同 KEY_TENSOR，condition 全 1 / 全 0 的 Tile 只读一个输入
+// KEY_TENSOR、KEY_PACKED、KEY_SCALAR_X1 / X2 走 ElementwisePipeline，可再加 TILING_KEY_TRIPLE_BUFFER 选择三缓冲。
+
+// 核函数的 UB 占用，需与 op_kernel/select_v2.cpp 中的 InitBuffer 保持一致：
+//   队列：condition（1 字节，打包时 1 bit）、x1、x2、y，各 depth 块，标量输入不占队列；
+//   未打包时 2 / 4 字节类型另需 condition 的 half 副本与 Compare 输出的按位掩码，
+//   1 字节类型需要 condition 的 half 副本（规整为 0 / 1），按字节掩码原地 And / Or，有标量输入时另需一个填满标量的 Tile；
+//   打包时 2 / 4 字节类型直接 Select，1 字节类型需要常量 0xFF、half 掩码与逐字节掩码；
+//   8 字节类型按两个 float 选择，掩码加倍并另需 condition 的 int32 副本，标量输入同 1 字节类型填满一个 Tile；
+//   condition 为标量时只有一个搬入即搬出的队列；
+//   跳过一致 Tile 时另需 ReduceMax / ReduceMin 的中间结果（按位掩码大小）与两个 32 字节的结果。
+inline UbPlanner SelectUbPlan(uint32_t sizeofdatatype, uint32_t tiling_key, uint32_t depth)
+{
+    UbPlanner planner;
+    if (tiling_key == KEY_SCALAR_CONDITION) {
+        planner.Queue(sizeofdatatype, PIPELINE_DEPTH_DOUBLE);
+        return planner;
+    }
+    bool packed = tiling_key == KEY_PACKED;
+    bool scalar = tiling_key == KEY_SCALAR_X1 || tiling_key == KEY_SCALAR_X2;
+    if (tiling_key == KEY_UNIFORM) {
+        planner.BitMask()
+               .Reserve(2 * COPY_BLOCK_BYTES);
+    }
+    if (packed) {
+        planner.BitQueue(depth);
+    } else {
+        planner.Queue(sizeof(uint8_t), depth);
+    }
+    planner.Queue(sizeofdatatype, depth)
+           .Queue(sizeofdatatype, depth);
+    if (!scalar) {
+        planner.Queue(sizeofdatatype, depth);
+    }
+    if (packed && sizeofdatatype == sizeof(uint8_t)) {
+        planner.Buffer(sizeof(uint16_t), 2)
+               .Buffer(sizeof(uint8_t));
+    } else if (!packed && sizeofdatatype != sizeof(uint8_t)) {
+        planner.Buffer(sizeof(uint16_t))
+               .BitMask();
+    } else if (!packed) {
+        planner.Buffer(sizeof(uint16_t));
+    }
+    if (sizeofdatatype == sizeof(uint64_t)) {
+        // 8 字节类型的掩码每个元素 2 位，另需 condition 的 int32 副本；打包时还需常量 1.0 与 condition 的 half 副本。
+        planner.Buffer(sizeof(int32_t))
+               .BitMask();
+        if (packed) {
+            planner.Buffer(sizeof(uint16_t), 2)
+                   .BitMask();
+        }
+    }
+    if (scalar && (sizeofdatatype == sizeof(uint8_t) || sizeofdatatype == sizeof(uint64_t))) {
+        planner.Buffer(sizeofdatatype);
+    }
+    return planner;
+}
+
+inline uint32_t SelectTileLength(uint64_t ub_size, uint32_t sizeofdatatype, uint32_t tiling_key, uint32_t align,
+                                 uint32_t depth = PIPELINE_DEPTH_DOUBLE)
+{
+    return SelectUbPlan(sizeofdatatype, tiling_key, depth).TileLength(ub_size, align);
+}
+
+// 选择 TilingKey：打包 condition 优先，其次是无需广播的逐元素，
+// 再识别 condition 或 x1 / x2 为标量的常见形式（如 where(mask, x, -inf)），其余按广播处理。
+// skip_uniform 只作用于逐元素分支：逐 Tile 判断 condition 需要额外的归约与标量同步，掩码不够结构化时反而变慢。
+// 该分支不能加 TILING_KEY_TRIPLE_BUFFER：x1 / x2 搬入哪一个取决于标量单元对 condition 的判断，
+// 判断又要等前一个 Tile 的向量计算完成，数据搬入最多只能提前一个 Tile，更深的队列只会缩小 Tile。
+inline uint32_t SelectTilingKey(const BroadcastPlanner& planner, bool packed, bool skip_uniform, uint8_t& scalar_inputs)
+{
+    scalar_inputs = 0;
+    if (packed) {
+        return KEY_PACKED;
+    }
+    if (planner.AllFull() || planner.OutSize() == 0) {
+        return skip_uniform ? KEY_UNIFORM : KEY_TENSOR;
+    }
+    if (planner.IsScalar(0) && (planner.IsFull(1) || planner.IsScalar(1)) &&
+        (planner.IsFull(2) || planner.IsScalar(2))) {
+        scalar_inputs = (planner.IsScalar(1) ? 1 : 0) | (planner.IsScalar(2) ? 2 : 0);
+        return KEY_SCALAR_CONDITION;
+    }
+    if (planner.IsFull(0) && planner.IsFull(1) && planner.IsScalar(2)) {
+        return KEY_SCALAR_X2;
+    }
+    if (planner.IsFull(0) && planner.IsFull(2) && planner.IsScalar(1)) {
+        return KEY_SCALAR_X1;
+    }
+    return KEY_BROADCAST;
+}
+
+struct SelectTilingPlan {
+    uint32_t tilingKey;
+    uint8_t scalarInputs;    // KEY_SCALAR_CONDITION 时第 0 / 1 位表示 x1 / x2 只有一个元素
+    uint8_t alignNum;        // 一个 32 字节块容纳的元素数
+    uint32_t blockSize;      // 单个 Tile 的元素数
+    uint32_t blockDim;       // 使用的核数
+    uint32_t depth;          // 队列深度
+    ElementwiseSplit split;  // 连续分支的核间切分
+    BroadcastRowSplit rows;  // 广播分支的行切分
+    uint64_t ubBytes;        // 按 blockSize 实际申请的 UB 字节数
+};
+
+// sizeofdatatype 为 x1 的元素宽度（1 / 2 / 4 / 8）。packed 时 planner 只合并 x1、x2，调用方需先检查 condition 的长度。
+// 输出元素数超过 UINT32_MAX（TilingData 按 uint32 记录长度）或 UB 放不下最小的 Tile 时返回 false。
+// tuned 为 nullptr 时查 tuned_tiling_table.h，未命中按公式计算；tools/tiling_autotune 传入候选方案直接评估。
+inline bool PlanSelectTiling(const BroadcastPlanner& planner, bool packed, bool skip_uniform, uint32_t sizeofdatatype,
+                             uint64_t ub_size, uint32_t coreNum, SelectTilingPlan& plan,
+                             const TunedTiling* tuned = nullptr)
+{
+    if (planner.OutSize() > UINT32_MAX) {
+        return false;
+    }
+    uint32_t totalLength = static_cast<uint32_t>(planner.OutSize());
+    plan.tilingKey = SelectTilingKey(planner, packed, skip_uniform, plan.scalarInputs);
+    plan.alignNum = static_cast<uint8_t>(COPY_BLOCK_BYTES / sizeofdatatype);
+    plan.depth = PIPELINE_DEPTH_DOUBLE;
+    plan.split = {0, 0, 0, 0};
+    plan.rows = {0, 0, 0};
+    uint32_t baseKey = plan.tilingKey;
+    const TunedTiling formula = {};
+    if (tuned == nullptr) {
+        // 打包时 planner 只合并了 x1、x2。
+        tuned = FindTunedTiling(TUNE_OP_SELECT_V2, sizeofdatatype, baseKey, TuneClassOf(planner, packed ? 2 : 3),
+                                totalLength, ub_size, coreNum);
+    }
+    const TunedTiling& choice = tuned != nullptr ? *tuned : formula;
+    // 按核函数实际申请的 Buffer 求 UB 能容纳的最大 Tile（元素个数），
+    // 向下对齐到 alignNum * 8 与 COMPARE_ALIGN 中的较大者；打包时还需是 PACKED_UNIT 的整数倍，使每个 Tile 的掩码 32 字节对齐。
+    uint32_t tile_align = std::max<uint32_t>(plan.alignNum * 8, COMPARE_ALIGN);
+    if (packed) {
+        tile_align = std::max<uint32_t>(tile_align, PACKED_UNIT);
+    }
+    plan.blockSize = SelectTileLength(ub_size, sizeofdatatype, baseKey, tile_align);
+    if (plan.blockSize == 0) {
+        return false;
+    }
+    if (baseKey != KEY_BROADCAST) {
+        // 核间切分的最小粒度：alignNum * 8 个元素（256 字节），保证每个核的 GM 起始地址 32 字节对齐；
+        // 打包时为 PACKED_UNIT 个元素，保证每个核的掩码起始地址也 32 字节对齐。
+        plan.split = SplitElementwise(totalLength, TunedCoreNum(choice, coreNum), packed ? PACKED_UNIT : plan.alignNum * 8);
+        plan.blockDim = plan.split.coreNum;
+        // 走 ElementwisePipeline 的分支在每核 Tile 足够多时改用三缓冲，更深的队列更好地掩盖 GM 访问延迟。
+        if (baseKey != KEY_SCALAR_CONDITION && baseKey != KEY_UNIFORM) {
+            auto tileLengthOf = [&](uint32_t depth) {
+                return SelectTileLength(ub_size, sizeofdatatype, baseKey, tile_align, depth);
+            };
+            plan.depth = TunedPipelineDepth(choice, plan.split.coreSize, sizeofdatatype, tileLengthOf, plan.blockSize);
+            if (plan.depth == PIPELINE_DEPTH_TRIPLE) {
+                plan.tilingKey += TILING_KEY_TRIPLE_BUFFER;
+            }
+        }
+        plan.blockSize = TunedTileLength(choice, plan.blockSize, tile_align);
+    } else {
+        plan.blockSize = TunedTileLength(choice, plan.blockSize, tile_align);
+        // 广播分支每行在 UB 中按 COPY_BLOCK_BYTES 个元素补齐（condition 为 1 字节）。
+        uint32_t rowLength = planner.OutShape()[planner.DimNum() - 1];
+        plan.rows = SplitBroadcastRows(totalLength, rowLength, COPY_BLOCK_BYTES, plan.blockSize);
+        plan.blockDim = BroadcastCoreNum(TunedCoreNum(choice, coreNum), plan.rows);
+    }
+    plan.ubBytes = SelectUbPlan(sizeofdatatype, baseKey, plan.depth).UsedBytes(plan.blockSize);
+    return true;
+}
+
+// packed 时打包的 condition 不参与广播：x1、x2 需同形状（planner 只合并了二者，都与输出等长），
+// condition 恰好有 ceil(n / 8) 个字节。
+inline bool PackedConditionMatches(const BroadcastPlanner& planner, uint64_t conditionSize)
+{
+    return planner.AllFull() && conditionSize == (planner.OutSize() + 7) / 8;
+}
+
+// condition、x1、x2 在各维上的步长（广播维为 0），依次占 strides 的 3 段 MAX_DIM_NUM 个元素。
+// packed 时 planner 只合并了 x1、x2：condition 的步长置 0，planner 的输入 0 / 1 对应 x1 / x2 的位置。
+inline void FillSelectStrides(const BroadcastPlanner& planner, bool packed,
+                              uint32_t strides[3 * BroadcastPlanner::MAX_DIM_NUM])
+{
+    const uint32_t MAX_DIM = BroadcastPlanner::MAX_DIM_NUM;
+    std::fill(strides, strides + 3 * MAX_DIM, 0);
+    uint32_t first_input = packed ? 1 : 0;
+    for (uint32_t i = first_input; i < 3; ++i) {
+        const uint32_t* src = planner.Strides(i - first_input);
+        std::copy(src, src + MAX_DIM, strides + i * MAX_DIM);
+    }
+}
+
+// 按切分方案填写 SelectV2TilingData（TilingDataT），TilingFunc 与 tools/tiling_cache_bench 共用。
+template <typename TilingDataT>
+inline void FillSelectTilingData(const BroadcastPlanner& planner, bool packed, const SelectTilingPlan& plan,
+                                 TilingDataT& tiling)
+{
+    const uint32_t MAX_DIM = BroadcastPlanner::MAX_DIM_NUM;
+    tiling.set_ALIGN_NUM(plan.alignNum);
+    tiling.set_block_size(plan.blockSize);
+    // 连续分支的核间切分 core_size / core_remain / core_tail。
+    SetElementwiseSplit(tiling, plan.split);
+    // 合并后的输出形状、condition/x1/x2 的步长与广播分支的 Tile 划分。
+    tiling.set_dim_num(planner.DimNum());
+    uint32_t y_dims[MAX_DIM];
+    std::copy(planner.OutShape(), planner.OutShape() + MAX_DIM, y_dims);
+    tiling.set_y_shape(y_dims);
+    uint32_t strides[3 * MAX_DIM];
+    FillSelectStrides(planner, packed, strides);
+    tiling.set_strides(strides);
+    tiling.set_row_tile(plan.rows.rowTile);
+    tiling.set_col_tile(plan.rows.colTile);
+    tiling.set_scalar_inputs(plan.scalarInputs);
+}
+}
+
+#endif  // SELECT_V2_PLAN_H
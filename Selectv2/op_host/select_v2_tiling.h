@@ -6,10 +6,14 @@ BEGIN_TILING_DATA_DEF(SelectV2TilingData)
   TILING_DATA_FIELD_DEF(uint32_t, block_size);
   TILING_DATA_FIELD_DEF(uint32_t, core_size);   
   TILING_DATA_FIELD_DEF(uint32_t, core_remain);   
-  TILING_DATA_FIELD_DEF_ARR(uint32_t, 30, shapeInf);      
-  TILING_DATA_FIELD_DEF_ARR(uint32_t, 4, y_shape);  
+  TILING_DATA_FIELD_DEF(uint32_t, core_tail);
+  TILING_DATA_FIELD_DEF(uint32_t, dim_num);
+  TILING_DATA_FIELD_DEF_ARR(uint32_t, 8, y_shape);       // 合并后的输出形状
+  TILING_DATA_FIELD_DEF_ARR(uint32_t, 24, strides);      // condition、x1、x2 在各维上的步长，广播维为 0
+  TILING_DATA_FIELD_DEF(uint32_t, row_tile);
+  TILING_DATA_FIELD_DEF(uint32_t, col_tile);
+  TILING_DATA_FIELD_DEF(uint8_t, scalar_inputs);         // TilingKey 4：第 0 / 1 位表示 x1 / x2 只有一个元素
   TILING_DATA_FIELD_DEF(uint8_t, ALIGN_NUM); 
-  TILING_DATA_FIELD_DEF(bool, boardCast); 
 END_TILING_DATA_DEF;
 
 REGISTER_TILING_DATA_CLASS(SelectV2, SelectV2TilingData)
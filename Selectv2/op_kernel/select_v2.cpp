@@ -1,281 +1,579 @@
 #include "kernel_operator.h" // 包含 Ascend C 核心库头文件
+#include "op_profiler.h"
+#include "copy_utils.h"
+#include "broadcast_indexer.h"
+#include "broadcast_tile.h"
+#include "select_compute.h"
+#include "elementwise_pipeline.h"
 
 
 
 constexpr int32_t BUFFER_NUM = 2;     // 使用双缓冲 (每个队列有 2 个 Buffer)
+constexpr int32_t MAX_DIM_NUM = 8;    // 与 TilingFunc 中合并后形状的最大维度数一致
+constexpr uint32_t PACKED_UNIT = 256;    // 打包 condition 的核间 / Tile 切分粒度：256 个元素对应 32 字节掩码
+constexpr uint32_t ROW_ALIGN = 32;        // 广播分支 UB 中每行补齐的元素数：condition 为 1 字节，32 字节对应 32 个元素
+
+// 逐元素分支各 MODE 下逐 Tile 搬入的输入：标量输入不进入流水线，打包的 condition 每个元素 1 bit。
+// condition 为 bool，按 uint8 搬运。DEPTH 为队列深度。
+template<typename TYPE_X1, typename TYPE_X2, typename TYPE_Y, int32_t MODE, int32_t DEPTH> struct SelectPipeline {
+    using Type = ElementwisePipeline<SelectCompute<TYPE_X1, TYPE_X2, TYPE_Y, MODE>, TYPE_Y, DEPTH, uint8_t, TYPE_X1, TYPE_X2>;
+};
+template<typename TYPE_X1, typename TYPE_X2, typename TYPE_Y, int32_t DEPTH>
+struct SelectPipeline<TYPE_X1, TYPE_X2, TYPE_Y, SELECT_PACKED, DEPTH> {
+    using Type = ElementwisePipeline<SelectCompute<TYPE_X1, TYPE_X2, TYPE_Y, SELECT_PACKED>, TYPE_Y, DEPTH,
+                                     PackedBits, TYPE_X1, TYPE_X2>;
+};
+template<typename TYPE_X1, typename TYPE_X2, typename TYPE_Y, int32_t DEPTH>
+struct SelectPipeline<TYPE_X1, TYPE_X2, TYPE_Y, SELECT_SCALAR_X2, DEPTH> {
+    using Type = ElementwisePipeline<SelectCompute<TYPE_X1, TYPE_X2, TYPE_Y, SELECT_SCALAR_X2>, TYPE_Y, DEPTH,
+                                     uint8_t, TYPE_X1>;
+};
+template<typename TYPE_X1, typename TYPE_X2, typename TYPE_Y, int32_t DEPTH>
+struct SelectPipeline<TYPE_X1, TYPE_X2, TYPE_Y, SELECT_SCALAR_X1, DEPTH> {
+    using Type = ElementwisePipeline<SelectCompute<TYPE_X1, TYPE_X2, TYPE_Y, SELECT_SCALAR_X1>, TYPE_Y, DEPTH,
+                                     uint8_t, TYPE_X2>;
+};
 
-template<typename TYPE_CON, typename TYPE_X1, typename TYPE_X2, typename TYPE_Y> class KernelSelect {
+// 逐元素分支：condition、x1、x2、y 按核均分后连续处理，流水线见 ElementwisePipeline。
+// SELECT_PACKED 时 condition 为每个元素 1 bit 的打包掩码，切分粒度为 PACKED_UNIT 个元素；
+// SELECT_SCALAR_X1 / SELECT_SCALAR_X2 时对应输入只有一个元素，只在 Init 中读取一次，不申请队列；
+// y 与该标量输入共用同一块 GM 时改为 0 号核串行处理，标量在写回 y[0] 之前读取。
+// SELECT_UNIFORM 需要先判断 condition 再决定搬入哪些输入，见 KernelSelect_Uniform。
+template<typename TYPE_CON, typename TYPE_X1, typename TYPE_X2, typename TYPE_Y, int32_t MODE = SELECT_TENSOR,
+         int32_t DEPTH = BUFFER_NUM> class KernelSelect {
 public:
     __aicore__ inline KernelSelect() {}
 
     // ALIGN_NUM：一个 BLOCK_SIZE (32 字节) 可以容纳多少个当前数据类型的元素。
     __aicore__ inline void Init(GM_ADDR condition, GM_ADDR x1, GM_ADDR x2, GM_ADDR y,
-                                uint8_t ALIGN_NUM, uint32_t block_size, uint32_t core_size, uint32_t core_remain)
+                                uint8_t ALIGN_NUM, uint32_t block_size, uint32_t core_size, uint32_t core_remain, uint32_t core_tail,
+                                GM_ADDR workspace)
+    {
+        uint32_t coreUnit = (MODE == SELECT_PACKED) ? PACKED_UNIT : ALIGN_NUM * 8;
+        if constexpr (MODE == SELECT_SCALAR_X1) {
+            GM_ADDR inputs[] = {condition, x2};
+            pipeline.Init(inputs, y, coreUnit, block_size, core_size, core_remain, core_tail, workspace, x1 == y);
+            AscendC::GlobalTensor<TYPE_X1> x1Gm;
+            x1Gm.SetGlobalBuffer((__gm__ TYPE_X1*)x1, 1);
+            pipeline.Computer().SetScalar(static_cast<TYPE_Y>(x1Gm.GetValue(0)));
+        } else if constexpr (MODE == SELECT_SCALAR_X2) {
+            GM_ADDR inputs[] = {condition, x1};
+            pipeline.Init(inputs, y, coreUnit, block_size, core_size, core_remain, core_tail, workspace, x2 == y);
+            AscendC::GlobalTensor<TYPE_X2> x2Gm;
+            x2Gm.SetGlobalBuffer((__gm__ TYPE_X2*)x2, 1);
+            pipeline.Computer().SetScalar(static_cast<TYPE_Y>(x2Gm.GetValue(0)));
+        } else {
+            GM_ADDR inputs[] = {condition, x1, x2};
+            pipeline.Init(inputs, y, coreUnit, block_size, core_size, core_remain, core_tail, workspace);
+        }
+    }
+
+    __aicore__ inline void Process()
     {
+        pipeline.Process();
+    }
 
+private:
+    typename SelectPipeline<TYPE_X1, TYPE_X2, TYPE_Y, MODE, DEPTH>::Type pipeline;
+};
 
-        this->blockLength = core_size + core_remain;
-        this->tileLength = block_size;
-        // 将blocklength长度对齐为32字节
-        this->blockLength = this->blockLength + (this->blockLength % ALIGN_NUM ? ALIGN_NUM - this->blockLength % ALIGN_NUM : 0); 
-
-       // AscendC::printf("GetBlockIdx is :%d\n", AscendC::GetBlockIdx());
-       // AscendC::printf("get blockLength is:%u\n", this->blockLength);
-
-        x1Gm.SetGlobalBuffer((__gm__ TYPE_X1*)x1, this->blockLength);
-        x2Gm.SetGlobalBuffer((__gm__ TYPE_X2*)x2, this->blockLength);
-        yGm.SetGlobalBuffer((__gm__ TYPE_Y*)y, this->blockLength);
-        conditionGm.SetGlobalBuffer((__gm__ TYPE_CON*)condition, this->blockLength);
-
-        // 计算需要处理的 Tile 数量 (tileNum)。如果 blockLength 不能被 tileLength 整除，则加 1 处理剩余部分。
-        this->tileNum = this->blockLength / this->tileLength + (this->blockLength % this->tileLength > 0);
-
-        pipe.InitBuffer(inQueueX1, BUFFER_NUM, this->tileLength * sizeof(TYPE_X1));
-        pipe.InitBuffer(inQueueX2, BUFFER_NUM, this->tileLength * sizeof(TYPE_X2));
-        pipe.InitBuffer(inQueueCondition, BUFFER_NUM, this->tileLength * sizeof(TYPE_CON));
-        pipe.InitBuffer(outQueueY, BUFFER_NUM, this->tileLength * sizeof(TYPE_Y));
-        pipe.InitBuffer(B_bits, this->tileLength * sizeof(uint8_t));   
-        pipe.InitBuffer(B_zero, this->tileLength * sizeof(half));
-        pipe.InitBuffer(B_con_half, this->tileLength * sizeof(half));
-        if constexpr (std::is_same_v<TYPE_Y, int8_t>) {
-            pipe.InitBuffer(B_x1, this->tileLength * sizeof(half));
-            pipe.InitBuffer(B_x2, this->tileLength * sizeof(half));
-            pipe.InitBuffer(B_y, this->tileLength * sizeof(half));
-        }
-        else if constexpr (std::is_same_v<TYPE_Y, int32_t>) {
-            pipe.InitBuffer(B_x1, this->tileLength * sizeof(float));
-            pipe.InitBuffer(B_x2, this->tileLength * sizeof(float));
-            pipe.InitBuffer(B_y, this->tileLength * sizeof(float));
-        }
-        
 
-        this->zero = B_zero.Get<half>();
-        this->con_half = B_con_half.Get<half>();
-        Duplicate(this->zero, half(0), this->tileLength);
+// 同 KernelSelect 的逐元素分支，先搬入 condition 判断，全 1 / 全 0 的 Tile 只搬入 x1 / x2 并原样输出，另一个输入不读。
+// 原地执行（y 与 x1 或 x2 为同一块 GM）时，选中的正是 y 所在输入的一致 Tile 已经是结果，搬入、搬出都省去。
+template<typename TYPE_CON, typename TYPE_X1, typename TYPE_X2, typename TYPE_Y> class KernelSelect_Uniform {
+public:
+    __aicore__ inline KernelSelect_Uniform() {}
+
+    __aicore__ inline void Init(GM_ADDR condition, GM_ADDR x1, GM_ADDR x2, GM_ADDR y,
+                                uint8_t ALIGN_NUM, uint32_t block_size, uint32_t core_size, uint32_t core_remain, uint32_t core_tail,
+                                GM_ADDR workspace)
+    {
+        // 核间切分见 kernel_split.h，与 ElementwisePipeline 一致。
+        block.Init(ALIGN_NUM * 8, block_size, core_size, core_remain, core_tail);
+
+        // condition 为 bool，按 uint8 搬运。
+        conditionGm.SetGlobalBuffer((__gm__ uint8_t*)condition + block.offset, block.length);
+        x1Gm.SetGlobalBuffer((__gm__ TYPE_X1*)x1 + block.offset, block.length);
+        x2Gm.SetGlobalBuffer((__gm__ TYPE_X2*)x2 + block.offset, block.length);
+        yGm.SetGlobalBuffer((__gm__ TYPE_Y*)y + block.offset, block.length);
+        this->x1InPlace = (x1 == y);
+        this->x2InPlace = (x2 == y);
+
+        pipe.InitBuffer(inQueueX1, BUFFER_NUM, block.tileLength * sizeof(TYPE_X1));
+        pipe.InitBuffer(inQueueX2, BUFFER_NUM, block.tileLength * sizeof(TYPE_X2));
+        pipe.InitBuffer(inQueueCondition, BUFFER_NUM, block.tileLength * sizeof(uint8_t));
+        pipe.InitBuffer(outQueueY, BUFFER_NUM, block.tileLength * sizeof(TYPE_Y));
+        computer.Init(pipe, block.tileLength);
+        profiler.Init(workspace);
     }
 
-    // 核心处理函数：实现标准的三级双缓冲流水线 (CopyIn -> Compute -> CopyOut)
+    // 软件流水，第 i 轮：
+    //   1. 发出 Tile i + 1 的 condition 搬入，不等待；
+    //   2. 计算 Tile i 并把 y 放入输出队列；
+    //   3. 取出 Tile i + 1 的 condition 判断是否一致，发出它用到的 x1 / x2 搬入；
+    //   4. 搬出 Tile i。
+    // 判断需要标量单元读取归约结果，放在 Tile i 的计算之后：condition 的搬入与 Tile i 的计算重叠，标量单元不必空等 MTE2；
+    // Tile i + 1 的 x1 / x2 搬入与 Tile i 的搬出在不同的流水上重叠。
+    // 各队列中同时最多有当前与下一个 Tile，与 InitBuffer 的 BUFFER_NUM 块一致。
+    // 打点按循环的每一轮记录，COMPUTE 段包含下一个 Tile 的判断。
     __aicore__ inline void Process()
     {
-        int32_t loopCount = this->tileNum;
-        // 循环处理除了最后一个 Tile 之外的所有完整 Tile。
-        for (int32_t i = 0; i < loopCount-1; i++) {
-            //AscendC::printf("++++++++++++++++++++++++++++++this is times:[%d/%d] loop+++++++++++++++++++++++++++++++\n", i, loopCount-2);
-            CopyIn(i, this->tileLength);
-            Compute(i, this->tileLength);
-            CopyOut(i, this->tileLength);
+        if (block.tileNum == 0) {
+            profiler.Finish();
+            return;
         }
-
-        uint32_t length = this->blockLength - this->tileLength * (loopCount - 1);
-        //AscendC::printf("++++++++++++++++++++++++++++++this is times:[%d/%d] loop+++++++++++++++++++++++++++++++\n", loopCount-1, loopCount-1);
-        CopyIn(loopCount - 1, (length + 31) / 32 * 32);
-        Compute(loopCount - 1, (length + 31) / 32 * 32);
-        // 拷贝最后一个 Tile 的计算结果回 GM。
-        // 注意：拷贝长度向上对齐到 32 的倍数，因为 DataCopy 输出通常要求对齐。
-        // 即使计算只产生了 length 个有效结果，也会拷贝对齐后的长度，多余部分是无效数据，
-        // 但因为 GM 空间是按对齐后的 blockLength 分配的，所以写这些无效数据是安全的。
-        CopyOut(loopCount - 1, (length + 31) / 32 * 32);
+        CopyInCondition(0);
+        UniformTile current = ClassifyAndLoad(0);
+        for (uint32_t i = 0; i < block.tileNum; i++) {
+            profiler.TileBegin();
+            bool hasNext = i + 1 < block.tileNum;
+            if (hasNext) {
+                CopyInCondition(i + 1);
+            }
+            profiler.Mark(OP_PROFILE_COPY_IN);
+            uint64_t inBytes = Compute(current);
+            UniformTile next{};
+            if (hasNext) {
+                next = ClassifyAndLoad(i + 1);
+            }
+            profiler.Mark(OP_PROFILE_COMPUTE);
+            CopyOut(i, current);
+            profiler.Mark(OP_PROFILE_COPY_OUT);
+            profiler.AddBytes(inBytes, current.skip ? 0 : current.length * sizeof(TYPE_Y));
+            current = next;
+        }
+        profiler.Finish();
     }
 
 private:
-    // 搬入函数 (GM -> UB)
-    __aicore__ inline void CopyIn(int32_t progress, uint32_t length)
+    // 已搬入并判断过的 Tile：condition 留在队列外直到计算完成，用到的 x1 / x2 已按顺序进入各自的队列。
+    struct UniformTile {
+        AscendC::LocalTensor<uint8_t> condition;
+        int32_t kind;
+        uint32_t length;
+        bool skip;    // 原地执行且选中的正是 y 所在的输入，y 已经是结果
+    };
+
+    __aicore__ inline void CopyInCondition(uint32_t progress)
     {
-        AscendC::LocalTensor<TYPE_X1> x1Local = inQueueX1.AllocTensor<TYPE_X1>();
-        AscendC::LocalTensor<TYPE_X2> x2Local = inQueueX2.AllocTensor<TYPE_X2>();
-        AscendC::LocalTensor<TYPE_CON> conditionLocal = inQueueCondition.AllocTensor<TYPE_CON>(); 
-
-        AscendC::DataCopy(x1Local, x1Gm[progress * this->tileLength], length);
-        AscendC::DataCopy(x2Local, x2Gm[progress * this->tileLength], length);
-        AscendC::DataCopy(conditionLocal, conditionGm[progress * this->tileLength], length);
-        
-        inQueueX1.EnQue(x1Local);
-        inQueueX2.EnQue(x2Local);
+        AscendC::LocalTensor<uint8_t> conditionLocal = inQueueCondition.AllocTensor<uint8_t>();
+        CopyInExact(conditionLocal, conditionGm[progress * block.tileLength], block.TileLength(progress));
         inQueueCondition.EnQue(conditionLocal);
     }
 
-    __aicore__ inline void Compute(int32_t progress, uint32_t length) 
+    // condition 一致的 Tile 大多只需搬入一个输入：结构化的掩码（如 padding 掩码）大部分 Tile 可省去约一半的读流量。
+    __aicore__ inline UniformTile ClassifyAndLoad(uint32_t progress)
     {
-        AscendC::LocalTensor<TYPE_X1> x1Local = inQueueX1.DeQue<TYPE_X1>();
-        AscendC::LocalTensor<TYPE_X2> x2Local = inQueueX2.DeQue<TYPE_X2>();
-        AscendC::LocalTensor<TYPE_CON> conditionLocal = inQueueCondition.DeQue<TYPE_CON>();
-        //将bool转换为int
-        AscendC::LocalTensor<uint8_t> tmpCon = conditionLocal.template ReinterpretCast<uint8_t>();
-        AscendC::Cast(con_half, tmpCon, AscendC::RoundMode::CAST_NONE, length);
-
-        AscendC::LocalTensor<TYPE_Y> yLocal = outQueueY.AllocTensor<TYPE_Y>();
-        
-        auto bits = B_bits.Get<uint8_t>();  
-        AscendC::Compare(bits, con_half, zero, AscendC::CMPMODE::NE, length);
-
-        
-        if constexpr (std::is_same_v<TYPE_Y, int8_t>) {
-            // AscendC::printf("-------------------------------this is int8_t compute-------------------------------\n");
-            auto x1_half = B_x1.Get<half>();
-            auto x2_half = B_x2.Get<half>();
-            auto y_half = B_y.Get<half>();
-            AscendC::Cast(x1_half, x1Local, AscendC::RoundMode::CAST_NONE, length);
-            AscendC::Cast(x2_half, x2Local, AscendC::RoundMode::CAST_NONE, length);
-            AscendC::Select(y_half, bits, x1_half, x2_half, AscendC::SELMODE::VSEL_TENSOR_TENSOR_MODE, length);
-            AscendC::Cast(yLocal, y_half, AscendC::RoundMode::CAST_NONE, length);
+        UniformTile tile;
+        uint32_t offset = progress * block.tileLength;
+        tile.length = block.TileLength(progress);
+        tile.condition = inQueueCondition.DeQue<uint8_t>();
+        tile.kind = computer.Classify(tile.condition, tile.length);
+        tile.skip = (tile.kind == TILE_ALL_TRUE && this->x1InPlace) || (tile.kind == TILE_ALL_FALSE && this->x2InPlace);
+        if (tile.skip) {
+            return tile;
         }
-        else if constexpr (std::is_same_v<TYPE_Y, int32_t>) {
-            // AscendC::printf("-------------------------------this is int32_t compute-------------------------------\n");
-            auto x1_half = B_x1.Get<float>();
-            auto x2_half = B_x2.Get<float>();
-            auto y_half = B_y.Get<float>();
-            AscendC::Cast(x1_half, x1Local, AscendC::RoundMode::CAST_NONE, length);
-            AscendC::Cast(x2_half, x2Local, AscendC::RoundMode::CAST_NONE, length);
-            AscendC::Select(y_half, bits, x1_half, x2_half, AscendC::SELMODE::VSEL_TENSOR_TENSOR_MODE, length);
-            AscendC::Cast(yLocal, y_half, AscendC::RoundMode::CAST_FLOOR, length);
+        if (tile.kind != TILE_ALL_FALSE) {
+            AscendC::LocalTensor<TYPE_X1> x1Local = inQueueX1.AllocTensor<TYPE_X1>();
+            CopyInExact(x1Local, x1Gm[offset], tile.length);
+            inQueueX1.EnQue(x1Local);
         }
-        else if constexpr (std::is_same_v<TYPE_Y, float32_t>) {
-            //AscendC::printf("-------------------------------this is float32_t compute-------------------------------\n");
-            AscendC::Select(yLocal, bits, x1Local, x2Local, AscendC::SELMODE::VSEL_TENSOR_TENSOR_MODE, length);
-        }
-        else if constexpr (std::is_same_v<TYPE_Y, float16_t>) {
-            //AscendC::printf("-------------------------------this is float16_t compute-------------------------------\n");
-            AscendC::Select(yLocal, bits, x1Local, x2Local, AscendC::SELMODE::VSEL_TENSOR_TENSOR_MODE, length);
+        if (tile.kind != TILE_ALL_TRUE) {
+            AscendC::LocalTensor<TYPE_X2> x2Local = inQueueX2.AllocTensor<TYPE_X2>();
+            CopyInExact(x2Local, x2Gm[offset], tile.length);
+            inQueueX2.EnQue(x2Local);
         }
+        return tile;
+    }
 
-        
-        
+    // 返回该 Tile 读取的字节数，结果留在输出队列中，由 CopyOut 搬出。
+    __aicore__ inline uint64_t Compute(const UniformTile& tile)
+    {
+        uint32_t length = tile.length;
+        if (tile.skip) {
+            inQueueCondition.FreeTensor(tile.condition);
+            return length;
+        }
 
+        AscendC::LocalTensor<TYPE_Y> yLocal = outQueueY.AllocTensor<TYPE_Y>();
+        uint64_t inBytes = length;
+        if (tile.kind == TILE_ALL_TRUE) {
+            CopyThrough<TYPE_X1>(yLocal, inQueueX1, length);
+            inBytes += length * sizeof(TYPE_X1);
+        } else if (tile.kind == TILE_ALL_FALSE) {
+            CopyThrough<TYPE_X2>(yLocal, inQueueX2, length);
+            inBytes += length * sizeof(TYPE_X2);
+        } else {
+            AscendC::LocalTensor<TYPE_X1> x1Local = inQueueX1.DeQue<TYPE_X1>();
+            AscendC::LocalTensor<TYPE_X2> x2Local = inQueueX2.DeQue<TYPE_X2>();
+            computer.Compute(yLocal, tile.condition, x1Local, x2Local, length);
+            inQueueX1.FreeTensor(x1Local);
+            inQueueX2.FreeTensor(x2Local);
+            inBytes += length * (sizeof(TYPE_X1) + sizeof(TYPE_X2));
+        }
+        inQueueCondition.FreeTensor(tile.condition);
         outQueueY.EnQue<TYPE_Y>(yLocal);
-        inQueueX1.FreeTensor(x1Local);
-        inQueueX2.FreeTensor(x2Local);
-        inQueueCondition.FreeTensor(conditionLocal);
+        return inBytes;
     }
 
-    // 搬出函数 (UB -> GM)
-    __aicore__ inline void CopyOut(int32_t progress, uint32_t length)
+    __aicore__ inline void CopyOut(uint32_t progress, const UniformTile& tile)
     {
+        if (tile.skip) {
+            return;
+        }
         AscendC::LocalTensor<TYPE_Y> yLocal = outQueueY.DeQue<TYPE_Y>();
-
-        AscendC::DataCopy(yGm[progress * this->tileLength], yLocal, length);
+        CopyOutExact(yGm[progress * block.tileLength], yLocal, tile.length);
         outQueueY.FreeTensor(yLocal);
     }
 
+    // 取出已搬入的输入 Tile，在 UB 内拷贝到 yLocal（x1、x2 与 y 的数据类型一致）。
+    template<typename T>
+    __aicore__ inline void CopyThrough(const AscendC::LocalTensor<TYPE_Y>& yLocal,
+                                       AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM>& queue, uint32_t length)
+    {
+        AscendC::LocalTensor<T> local = queue.template DeQue<T>();
+        AscendC::DataCopy(yLocal, local.template ReinterpretCast<TYPE_Y>(),
+                          AlignUp(length, COPY_ALIGN_BYTES / sizeof(TYPE_Y)));
+        queue.FreeTensor(local);
+    }
+
 private:
     // 固定变量
-    uint32_t blockLength, tileNum, tileLength;  
+    ElementwiseBlock block;
+    bool x1InPlace, x2InPlace;    // y 与 x1 / x2 共用同一块 GM
 
     AscendC::TPipe pipe;
-    AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueX1;          
-    AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueX2;         
-    AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueCondition;  
-    AscendC::TQue<AscendC::QuePosition::VECOUT, BUFFER_NUM> outQueueY;     
-
-    AscendC::GlobalTensor<TYPE_X1> x1Gm; 
-    AscendC::GlobalTensor<TYPE_X2> x2Gm;        
-    AscendC::GlobalTensor<TYPE_CON> conditionGm; 
-    AscendC::GlobalTensor<TYPE_Y> yGm;     
-    //
-    AscendC::TBuf<AscendC::QuePosition::VECCALC> B_con_half, B_zero, B_bits;
-    AscendC::TBuf<AscendC::QuePosition::VECCALC> B_x1, B_x2, B_y;
-    AscendC::LocalTensor<half> zero, con_half;
+    AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueX1;
+    AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueX2;
+    AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueCondition;
+    AscendC::TQue<AscendC::QuePosition::VECOUT, BUFFER_NUM> outQueueY;
+
+    AscendC::GlobalTensor<TYPE_X1> x1Gm;
+    AscendC::GlobalTensor<TYPE_X2> x2Gm;
+    AscendC::GlobalTensor<uint8_t> conditionGm;
+    AscendC::GlobalTensor<TYPE_Y> yGm;
+    SelectCompute<TYPE_X1, TYPE_X2, TYPE_Y, SELECT_UNIFORM> computer;
+    OpProfiler profiler;
 };
 
 
+// condition 只有一个元素：输出整体等于 x1 或 x2，不需要任何计算。
+// 在 Init 中读取 condition，选中的输入与输出同形状时逐 Tile 搬入后原样搬出（VECIN -> VECOUT 共用一个队列），
+// 选中的输入也是标量时每个 Tile 用 Duplicate 填充后搬出。
+// 原地执行且选中的正是 y 所在的输入时，y 已经是结果，不做任何搬运；
+// 选中的是与 y 共用同一块 GM 的标量时改为 0 号核串行处理，标量在写回 y[0] 之前读取。
+template<typename TYPE_X1, typename TYPE_X2, typename TYPE_Y> class KernelSelect_ScalarCondition {
+public:
+    __aicore__ inline KernelSelect_ScalarCondition() {}
+
+    // scalar_inputs：第 0 / 1 位表示 x1 / x2 是否只有一个元素。
+    __aicore__ inline void Init(GM_ADDR condition, GM_ADDR x1, GM_ADDR x2, GM_ADDR y,
+                                uint8_t ALIGN_NUM, uint32_t block_size, uint32_t core_size, uint32_t core_remain, uint32_t core_tail,
+                                uint8_t scalar_inputs, GM_ADDR workspace)
+    {
+        this->alignNum = ALIGN_NUM;
+
+        // x1、x2 与 y 的数据类型一致，选中的输入按 y 的类型搬运。
+        conditionGm.SetGlobalBuffer((__gm__ uint8_t*)condition, 1);
+        bool pickX1 = conditionGm.GetValue(0) != 0;
+        GM_ADDR src = pickX1 ? x1 : x2;
+        this->srcScalar = (scalar_inputs & (pickX1 ? 1 : 2)) != 0;
+        if (this->srcScalar && src == y) {
+            block.InitSerial(ALIGN_NUM * 8, block_size, core_size, core_remain, core_tail);
+        } else {
+            block.Init(ALIGN_NUM * 8, block_size, core_size, core_remain, core_tail);
+        }
+        if (this->srcScalar) {
+            srcGm.SetGlobalBuffer((__gm__ TYPE_Y*)src, 1);
+            this->scalarValue = srcGm.GetValue(0);
+        } else {
+            srcGm.SetGlobalBuffer((__gm__ TYPE_Y*)src + block.offset, block.length);
+        }
+        if (!this->srcScalar && src == y) {
+            block.tileNum = 0;
+        }
+        yGm.SetGlobalBuffer((__gm__ TYPE_Y*)y + block.offset, block.length);
+
+        pipe.InitBuffer(queueY, BUFFER_NUM, block.tileLength * sizeof(TYPE_Y));
+        profiler.Init(workspace);
+    }
+
+    __aicore__ inline void Process()
+    {
+        for (uint32_t i = 0; i < block.tileNum; i++) {
+            uint32_t length = block.TileLength(i);
+            profiler.TileBegin();
+            AscendC::LocalTensor<TYPE_Y> local = queueY.AllocTensor<TYPE_Y>();
+            if (this->srcScalar) {
+                DuplicateValue(local, this->scalarValue, AlignUp(length, this->alignNum));
+            } else {
+                CopyInExact(local, srcGm[i * block.tileLength], length);
+            }
+            queueY.EnQue(local);
+            profiler.Mark(OP_PROFILE_COPY_IN);
+            profiler.Mark(OP_PROFILE_COMPUTE);
+            local = queueY.DeQue<TYPE_Y>();
+            CopyOutExact(yGm[i * block.tileLength], local, length);
+            queueY.FreeTensor(local);
+            profiler.Mark(OP_PROFILE_COPY_OUT);
+            profiler.AddBytes(this->srcScalar ? 0 : length * sizeof(TYPE_Y), length * sizeof(TYPE_Y));
+        }
+        profiler.Finish();
+    }
+
+private:
+    ElementwiseBlock block;
+    uint32_t alignNum;
+    bool srcScalar;
+    TYPE_Y scalarValue;
+
+    AscendC::TPipe pipe;
+    AscendC::TQueBind<AscendC::QuePosition::VECIN, AscendC::QuePosition::VECOUT, BUFFER_NUM> queueY;
+
+    AscendC::GlobalTensor<uint8_t> conditionGm;
+    AscendC::GlobalTensor<TYPE_Y> srcGm;
+    AscendC::GlobalTensor<TYPE_Y> yGm;
+    OpProfiler profiler;
+};
+
+
+// 广播分支：输出按合并后的最内维看作 [rowNum, rowLength]，以整行或行内分段为单位切 Tile，Tile 区间按核均分，
+// 沿用 CopyIn -> Compute -> CopyOut 的双缓冲流水线与 KernelSelect 的 Compare + Select 计算。
+// 与输出同形状的输入整块 DataCopyPad 搬入；最内维连续的广播输入逐行搬入；最内维被广播的输入逐行 Duplicate。
+// y 与被广播的 x1 / x2 共用同一块 GM 时，由 0 号核倒序处理全部 Tile（见 BroadcastTiler::Serialize）。
 template<typename TYPE_CON, typename TYPE_X1, typename TYPE_X2, typename TYPE_Y> class KernelSelect_Broadcast {
     public:
         __aicore__ inline KernelSelect_Broadcast() {}
     
-        __aicore__ inline void Init(GM_ADDR condition, GM_ADDR x1, GM_ADDR x2, GM_ADDR y,
-                                    uint8_t ALIGN_NUM, uint32_t block_size, uint32_t core_size, uint32_t core_remain, uint32_t shapeInf[3*4])
+        __aicore__ inline void Init(GM_ADDR condition, GM_ADDR x1, GM_ADDR x2, GM_ADDR y, uint32_t block_size,
+                                    uint32_t dim_num, uint32_t y_shape[MAX_DIM_NUM], uint32_t strides[3 * MAX_DIM_NUM],
+                                    uint32_t row_tile, uint32_t col_tile, GM_ADDR workspace)
         {
-             // 确定最大维度数
-            int32_t conditionDimNum = static_cast<int32_t>(shapeInf[0 * 4 + 0]);
-            int32_t x1DimNum = static_cast<int32_t>(shapeInf[1 * 4 + 0]);
-            int32_t x2DimNum = static_cast<int32_t>(shapeInf[2 * 4 + 0]);
-            maxDimNum = conditionDimNum;
-            if (x1DimNum > maxDimNum) maxDimNum = x1DimNum;
-            if (x2DimNum > maxDimNum) maxDimNum = x2DimNum;
-            // 将shapeInf转换为shape，最后一行存每个维度最大值
-            for(int tensor_idx = maxDimNum-1; tensor_idx >= 0; tensor_idx--) {
-                this->shapes[0][tensor_idx] = (maxDimNum - conditionDimNum - tensor_idx) > 0 ? 1 : shapeInf[0*4 + tensor_idx+1];
-                this->shapes[1][tensor_idx] = (maxDimNum - x1DimNum - tensor_idx) > 0 ? 1 : shapeInf[1*4 + tensor_idx+1];
-                this->shapes[2][tensor_idx] = (maxDimNum - x2DimNum - tensor_idx) > 0 ? 1 : shapeInf[2*4 + tensor_idx+1];
-                this->shapes[3][tensor_idx] = this->shapes[0][tensor_idx];
-                if (this->shapes[1][tensor_idx] > this->shapes[3][tensor_idx]) this->shapes[3][tensor_idx] = this->shapes[1][tensor_idx];
-                if (this->shapes[2][tensor_idx] > this->shapes[3][tensor_idx]) this->shapes[3][tensor_idx] = this->shapes[2][tensor_idx];
+            // 合并后的输出形状与 condition、x1、x2 的步长（广播维为 0）由 TilingFunc 预先计算。
+            // 输入的步长与输出的连续步长一致时，该输入与输出同形状，可按整块搬入。
+            this->dimNum = dim_num;
+            uint64_t yShape[MAX_DIM_NUM];
+            uint64_t inputSize[3] = {1, 1, 1};
+            uint64_t ySize = 1;
+            for (int32_t k = 0; k < 3; k++) {
+                this->contiguous[k] = true;
             }
-
-            for (int i = 0; i < 4; i++) {
-                strides[i][maxDimNum - 1] = 1;
+            for (int32_t j = this->dimNum - 1; j >= 0; j--) {
+                yShape[j] = y_shape[j];
+                for (int32_t k = 0; k < 3; k++) {
+                    this->inputStrides[k][j] = strides[k * MAX_DIM_NUM + j];
+                    this->contiguous[k] = this->contiguous[k] && (this->inputStrides[k][j] == ySize);
+                    inputSize[k] += (yShape[j] - 1) * this->inputStrides[k][j];
+                }
+                ySize *= yShape[j];
             }
-            for (int i = maxDimNum - 2; i >= 0; i--) {
-                strides[0][i] = strides[0][i + 1] * shapes[0][i + 1];
-                strides[1][i] = strides[1][i + 1] * shapes[1][i + 1];
-                strides[2][i] = strides[2][i + 1] * shapes[2][i + 1];
-                strides[3][i] = strides[3][i + 1] * shapes[3][i + 1];
+            // 行号只在外层 dimNum - 1 维上展开。
+            rowIndexer.Init(this->dimNum - 1, yShape);
+            for (int32_t k = 0; k < 3; k++) {
+                rowIndexer.SetStrides(k, this->inputStrides[k]);
             }
-    
-            
-            this->blockLength = core_size + core_remain;
-            // 将blocklength长度对齐为32字节
-            this->blockLength = this->blockLength + (this->blockLength % ALIGN_NUM ? ALIGN_NUM - this->blockLength % ALIGN_NUM : 0); 
-            x1Gm.SetGlobalBuffer((__gm__ TYPE_X1*)x1, this->blockLength);
-            x2Gm.SetGlobalBuffer((__gm__ TYPE_X2*)x2, this->blockLength);
-            yGm.SetGlobalBuffer((__gm__ TYPE_Y*)y, this->blockLength);
-            conditionGm.SetGlobalBuffer((__gm__ TYPE_CON*)condition, this->blockLength);
+            this->rowLength = yShape[this->dimNum - 1];
+            tiler.Init(ySize, this->rowLength, row_tile, col_tile, ROW_ALIGN);
+            if ((x1 == y && !this->contiguous[1]) || (x2 == y && !this->contiguous[2])) {
+                tiler.Serialize();
+            }
+
+            // condition 为 bool，按 uint8 搬运。
+            conditionGm.SetGlobalBuffer((__gm__ uint8_t*)condition, inputSize[0]);
+            x1Gm.SetGlobalBuffer((__gm__ TYPE_X1*)x1, inputSize[1]);
+            x2Gm.SetGlobalBuffer((__gm__ TYPE_X2*)x2, inputSize[2]);
+            yGm.SetGlobalBuffer((__gm__ TYPE_Y*)y, ySize);
+
+            pipe.InitBuffer(inQueueX1, BUFFER_NUM, block_size * sizeof(TYPE_X1));
+            pipe.InitBuffer(inQueueX2, BUFFER_NUM, block_size * sizeof(TYPE_X2));
+            pipe.InitBuffer(inQueueCondition, BUFFER_NUM, block_size * sizeof(uint8_t));
+            pipe.InitBuffer(outQueueY, BUFFER_NUM, block_size * sizeof(TYPE_Y));
+            computer.Init(pipe, block_size);
+            profiler.Init(workspace);
         }
     
         __aicore__ inline void Process()
         {
-            for (int i = 0; i < blockLength; i++) {
-                int conditionOffset = 0;
-                int x1Offset = 0;
-                int x2Offset = 0;
-                int outOffset = 0;
-                for (int j = 0; j < maxDimNum; j++) {
-                    int index = i / strides[3][j] % shapes[3][j];
-                    conditionOffset += (index % shapes[0][j]) * strides[0][j];
-                    x1Offset += (index % shapes[1][j]) * strides[1][j];
-                    x2Offset += (index % shapes[2][j]) * strides[2][j];
-                    outOffset += index * strides[3][j];
-                }
-                TYPE_CON condition = conditionGm.GetValue(conditionOffset);
-                TYPE_X1 x1 = x1Gm.GetValue(x1Offset);
-                TYPE_X2 x2 = x2Gm.GetValue(x2Offset);
-                if (condition) {
-                    yGm(outOffset) = static_cast<TYPE_Y>(x1);
-                } else {
-                    yGm(outOffset) = static_cast<TYPE_Y>(x2);
+            for (uint32_t i = tiler.tileStart; i < tiler.tileEnd; i++) {
+                profiler.TileBegin();
+                BroadcastTile tile = tiler.Locate(tiler.Order(i));
+                CopyIn(tile);
+                profiler.Mark(OP_PROFILE_COPY_IN);
+                Compute(tile);
+                profiler.Mark(OP_PROFILE_COMPUTE);
+                CopyOut(tile);
+                profiler.Mark(OP_PROFILE_COPY_OUT);
+                profiler.AddBytes(InputBytes<uint8_t>(0, tile) + InputBytes<TYPE_X1>(1, tile) + InputBytes<TYPE_X2>(2, tile),
+                                  static_cast<uint64_t>(tile.rows) * tile.cols * sizeof(TYPE_Y));
+            }
+            profiler.Finish();
+        }
+
+    private:
+        // 与 CopyIn 对应，一个 Tile 实际从 GM 读取的字节数，仅用于性能打点。
+        template<typename T>
+        __aicore__ inline uint64_t InputBytes(int32_t k, const BroadcastTile& tile)
+        {
+            if (!this->contiguous[k] && this->inputStrides[k][this->dimNum - 1] == 0) {
+                return static_cast<uint64_t>(tile.rows) * sizeof(T);
+            }
+            return static_cast<uint64_t>(tile.rows) * tile.cols * sizeof(T);
+        }
+
+        __aicore__ inline void CopyIn(const BroadcastTile& tile)
+        {
+            AscendC::LocalTensor<uint8_t> conditionLocal = inQueueCondition.AllocTensor<uint8_t>();
+            AscendC::LocalTensor<TYPE_X1> x1Local = inQueueX1.AllocTensor<TYPE_X1>();
+            AscendC::LocalTensor<TYPE_X2> x2Local = inQueueX2.AllocTensor<TYPE_X2>();
+
+            if (this->contiguous[0]) {
+                CopyInTile(conditionLocal, conditionGm, this->rowLength, tile);
+            }
+            if (this->contiguous[1]) {
+                CopyInTile(x1Local, x1Gm, this->rowLength, tile);
+            }
+            if (this->contiguous[2]) {
+                CopyInTile(x2Local, x2Gm, this->rowLength, tile);
+            }
+            if (!this->contiguous[0] || !this->contiguous[1] || !this->contiguous[2]) {
+                // 每个 Tile 只分解一次起始行号，之后逐行前进，行内没有除法与取模。
+                uint32_t inner = this->dimNum - 1;
+                rowIndexer.Seek(tile.rowStart);
+                for (uint32_t r = 0; r < tile.rows; r++) {
+                    if (!this->contiguous[0]) {
+                        CopyInRow(conditionLocal[r * tile.colPad], conditionGm, rowIndexer.Offset(0),
+                                  this->inputStrides[0][inner], tile);
+                    }
+                    if (!this->contiguous[1]) {
+                        CopyInRow(x1Local[r * tile.colPad], x1Gm, rowIndexer.Offset(1), this->inputStrides[1][inner], tile);
+                    }
+                    if (!this->contiguous[2]) {
+                        CopyInRow(x2Local[r * tile.colPad], x2Gm, rowIndexer.Offset(2), this->inputStrides[2][inner], tile);
+                    }
+                    rowIndexer.Next();
                 }
             }
+
+            inQueueCondition.EnQue(conditionLocal);
+            inQueueX1.EnQue(x1Local);
+            inQueueX2.EnQue(x2Local);
+        }
+
+        __aicore__ inline void Compute(const BroadcastTile& tile)
+        {
+            AscendC::LocalTensor<uint8_t> conditionLocal = inQueueCondition.DeQue<uint8_t>();
+            AscendC::LocalTensor<TYPE_X1> x1Local = inQueueX1.DeQue<TYPE_X1>();
+            AscendC::LocalTensor<TYPE_X2> x2Local = inQueueX2.DeQue<TYPE_X2>();
+            AscendC::LocalTensor<TYPE_Y> yLocal = outQueueY.AllocTensor<TYPE_Y>();
+
+            computer.Compute(yLocal, conditionLocal, x1Local, x2Local, tile.rows * tile.colPad);
+
+            outQueueY.EnQue<TYPE_Y>(yLocal);
+            inQueueCondition.FreeTensor(conditionLocal);
+            inQueueX1.FreeTensor(x1Local);
+            inQueueX2.FreeTensor(x2Local);
+        }
+
+        __aicore__ inline void CopyOut(const BroadcastTile& tile)
+        {
+            AscendC::LocalTensor<TYPE_Y> yLocal = outQueueY.DeQue<TYPE_Y>();
+            CopyOutTile(yGm, yLocal, this->rowLength, tile);
+            outQueueY.FreeTensor(yLocal);
         }
 
-    
     private:
+        AscendC::TPipe pipe;
+        AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueX1;          
+        AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueX2;         
+        AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueCondition;  
+        AscendC::TQue<AscendC::QuePosition::VECOUT, BUFFER_NUM> outQueueY;     
         // 固定变量
-        uint32_t blockLength;  
-        
+        uint32_t dimNum, rowLength;
+        BroadcastTiler tiler;
+        bool contiguous[3];    // condition、x1、x2 是否与输出同形状
+
         AscendC::GlobalTensor<TYPE_X1> x1Gm; 
         AscendC::GlobalTensor<TYPE_X2> x2Gm;        
-        AscendC::GlobalTensor<TYPE_CON> conditionGm; 
+        AscendC::GlobalTensor<uint8_t> conditionGm; 
         AscendC::GlobalTensor<TYPE_Y> yGm;     
-              
-        int64_t shapes[4][10];   
-        int64_t strides[4][10];  
-        int32_t maxDimNum; // 最大维度数
 
+        uint64_t inputStrides[3][MAX_DIM_NUM];
+        BroadcastIndexer<3> rowIndexer;    // 输出行号对应的 condition、x1、x2 起始偏移
+        SelectCompute<TYPE_X1, TYPE_X2, TYPE_Y> computer;
+        OpProfiler profiler;
 };
 
 
 extern "C" __global__ __aicore__ void select_v2(GM_ADDR condition, GM_ADDR x1, GM_ADDR x2, GM_ADDR y, GM_ADDR workspace, GM_ADDR tiling) {
 
     GET_TILING_DATA(tiling_data, tiling);
-    if (tiling_data.boardCast == 0) {
+    // TilingKey 含义见 op_host/select_v2.cpp；逐元素分支加 100 为三缓冲版本。
+    if (TILING_KEY_IS(1)) {
         KernelSelect<DTYPE_CONDITION, DTYPE_X1, DTYPE_X2, DTYPE_Y> op; 
         op.Init(condition, x1, x2, y,
-            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain);
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
         op.Process();
-    } else if (tiling_data.boardCast == 1) {
+    } else if (TILING_KEY_IS(2)) {
         KernelSelect_Broadcast<DTYPE_CONDITION, DTYPE_X1, DTYPE_X2, DTYPE_Y> op; 
+        op.Init(condition, x1, x2, y, tiling_data.block_size,
+            tiling_data.dim_num, tiling_data.y_shape, tiling_data.strides,
+            tiling_data.row_tile, tiling_data.col_tile, workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(3)) {
+        KernelSelect<DTYPE_CONDITION, DTYPE_X1, DTYPE_X2, DTYPE_Y, SELECT_PACKED> op; 
+        op.Init(condition, x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(4)) {
+        KernelSelect_ScalarCondition<DTYPE_X1, DTYPE_X2, DTYPE_Y> op; 
+        op.Init(condition, x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            tiling_data.scalar_inputs, workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(5)) {
+        KernelSelect<DTYPE_CONDITION, DTYPE_X1, DTYPE_X2, DTYPE_Y, SELECT_SCALAR_X2> op; 
+        op.Init(condition, x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(6)) {
+        KernelSelect<DTYPE_CONDITION, DTYPE_X1, DTYPE_X2, DTYPE_Y, SELECT_SCALAR_X1> op; 
+        op.Init(condition, x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(7)) {
+        KernelSelect_Uniform<DTYPE_CONDITION, DTYPE_X1, DTYPE_X2, DTYPE_Y> op; 
+        op.Init(condition, x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(101)) {
+        KernelSelect<DTYPE_CONDITION, DTYPE_X1, DTYPE_X2, DTYPE_Y, SELECT_TENSOR, 3> op; 
+        op.Init(condition, x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(103)) {
+        KernelSelect<DTYPE_CONDITION, DTYPE_X1, DTYPE_X2, DTYPE_Y, SELECT_PACKED, 3> op; 
+        op.Init(condition, x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(105)) {
+        KernelSelect<DTYPE_CONDITION, DTYPE_X1, DTYPE_X2, DTYPE_Y, SELECT_SCALAR_X2, 3> op; 
+        op.Init(condition, x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(106)) {
+        KernelSelect<DTYPE_CONDITION, DTYPE_X1, DTYPE_X2, DTYPE_Y, SELECT_SCALAR_X1, 3> op; 
         op.Init(condition, x1, x2, y,
-            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.shapeInf);
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
         op.Process();
     }
     
-}
\ No newline at end of file
+}
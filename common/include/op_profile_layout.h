@@ -0,0 +1,53 @@
+#ifndef OP_PROFILE_LAYOUT_H
+#define OP_PROFILE_LAYOUT_H
+
+#include <cstdint>
+
+// 性能打点在 workspace 中的数据布局。
+// 核函数在 OP_PROFILING=1 时写入，TilingFunc 据此分配 workspace，tools/profile_decoder 据此解析。
+// 每个核占用一段固定大小的区域：头部 OP_PROFILE_HEADER_WORDS 个 uint64，
+// 之后是最多 OP_PROFILE_MAX_TILES 条逐 Tile 记录，每条 OP_PROFILE_TILE_WORDS 个 uint64。
+// 所有字段均为 uint64，核函数按下标逐个写入。
+
+constexpr uint64_t OP_PROFILE_MAGIC = 0x4F50524F46494C45ULL;   // "OPROFILE"
+constexpr uint64_t OP_PROFILE_VERSION = 1;
+constexpr uint32_t OP_PROFILE_MAX_TILES = 512;   // 超过该数量的 Tile 只计入头部汇总
+
+// 流水线阶段
+constexpr uint32_t OP_PROFILE_COPY_IN = 0;
+constexpr uint32_t OP_PROFILE_COMPUTE = 1;
+constexpr uint32_t OP_PROFILE_COPY_OUT = 2;
+constexpr uint32_t OP_PROFILE_STAGE_NUM = 3;
+
+// 头部字段下标
+constexpr uint32_t OP_PROFILE_H_MAGIC = 0;
+constexpr uint32_t OP_PROFILE_H_VERSION = 1;
+constexpr uint32_t OP_PROFILE_H_BLOCK_IDX = 2;
+constexpr uint32_t OP_PROFILE_H_BLOCK_NUM = 3;
+constexpr uint32_t OP_PROFILE_H_TILE_NUM = 4;
+constexpr uint32_t OP_PROFILE_H_START_CYCLE = 5;     // Init 结束时刻
+constexpr uint32_t OP_PROFILE_H_END_CYCLE = 6;       // Process 结束时刻
+constexpr uint32_t OP_PROFILE_H_STAGE_CYCLES = 7;    // 各阶段累计 cycle，共 OP_PROFILE_STAGE_NUM 个
+constexpr uint32_t OP_PROFILE_H_READ_BYTES = 10;     // 本核从 GM 读取的字节数
+constexpr uint32_t OP_PROFILE_H_WRITE_BYTES = 11;    // 本核写入 GM 的字节数
+constexpr uint32_t OP_PROFILE_HEADER_WORDS = 16;
+
+// 逐 Tile 记录字段下标：各阶段 cycle 之后是该 Tile 结束时刻
+constexpr uint32_t OP_PROFILE_T_END_CYCLE = OP_PROFILE_STAGE_NUM;
+constexpr uint32_t OP_PROFILE_TILE_WORDS = 4;
+
+constexpr uint32_t OP_PROFILE_REGION_WORDS = OP_PROFILE_HEADER_WORDS + OP_PROFILE_MAX_TILES * OP_PROFILE_TILE_WORDS;
+constexpr uint32_t OP_PROFILE_REGION_BYTES = OP_PROFILE_REGION_WORDS * sizeof(uint64_t);
+
+// 打点所需的用户 workspace 大小，未开启 OP_PROFILING 时为 0。
+inline uint64_t OpProfileWorkspaceSize(uint32_t blockNum)
+{
+#if defined(OP_PROFILING) && OP_PROFILING
+    return static_cast<uint64_t>(blockNum) * OP_PROFILE_REGION_BYTES;
+#else
+    (void)blockNum;
+    return 0;
+#endif
+}
+
+#endif  // OP_PROFILE_LAYOUT_H
@@ -0,0 +1,115 @@
+#ifndef CPU_DTYPE_H
+#define CPU_DTYPE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace opcpu {
+// CPU 参考实现支持的数据类型，与各算子 OpDef 中注册的 dtype 对应。
+enum class DataType {
+  FLOAT,
+  FLOAT16,
+  BF16,
+  INT8,
+  UINT8,
+  BOOL,
+  INT16,
+  INT32,
+  INT64,
+};
+
+inline size_t DataTypeSize(DataType dtype)
+{
+  switch (dtype) {
+    case DataType::INT8:
+    case DataType::UINT8:
+    case DataType::BOOL:
+      return 1;
+    case DataType::FLOAT16:
+    case DataType::BF16:
+    case DataType::INT16:
+      return 2;
+    case DataType::FLOAT:
+    case DataType::INT32:
+      return 4;
+    case DataType::INT64:
+      return 8;
+  }
+  return 0;
+}
+
+inline uint32_t FloatBits(float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+inline float BitsFloat(uint32_t bits)
+{
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// half -> float 没有精度损失，与核函数中 Cast(CAST_NONE) 一致。
+inline float HalfToFloat(uint16_t half)
+{
+  uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+  uint32_t exponent = (half >> 10) & 0x1f;
+  uint32_t mantissa = half & 0x3ff;
+  if (exponent == 0) {
+    // 0 与非规格化数：mantissa * 2^-24。
+    float value = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+    return sign != 0 ? -value : value;
+  }
+  if (exponent == 0x1f) {
+    return BitsFloat(sign | 0x7f800000 | (mantissa << 13));
+  }
+  return BitsFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+// float -> half 就近舍入、中间值取偶，与核函数中 Cast(CAST_NONE) 在有精度损失时的 CAST_RINT 一致。
+// 超过 half 表示范围的值得到 inf，NaN 置为 quiet NaN 并保留尾数的高 10 位（与 F16C / NEON 的转换指令一致）。
+inline uint16_t FloatToHalf(float value)
+{
+  const uint32_t F32_INF = 0xffU << 23;
+  const uint32_t F16_OVERFLOW = (127U + 16) << 23;                  // 2^16，不小于它的值一定舍入为 inf
+  const uint32_t DENORM_MAGIC = ((127U - 15) + (23 - 10) + 1) << 23;  // 加上它后尾数低位即为 half 的非规格化尾数
+  uint32_t bits = FloatBits(value);
+  uint32_t sign = bits & 0x80000000;
+  bits ^= sign;
+  uint16_t out;
+  if (bits >= F16_OVERFLOW) {
+    out = bits > F32_INF ? static_cast<uint16_t>(0x7e00 | ((bits >> 13) & 0x3ff)) : 0x7c00;
+  } else if (bits < (113U << 23)) {
+    // 结果为 0 或非规格化数：借助 float 加法的舍入完成就近取偶。
+    out = static_cast<uint16_t>(FloatBits(BitsFloat(bits) + BitsFloat(DENORM_MAGIC)) - DENORM_MAGIC);
+  } else {
+    uint32_t mantissaOdd = (bits >> 13) & 1;
+    bits += ((15U - 127) << 23) + 0xfff;
+    bits += mantissaOdd;
+    out = static_cast<uint16_t>(bits >> 13);
+  }
+  return static_cast<uint16_t>(out | (sign >> 16));
+}
+
+// bf16 -> float 只需补 16 个 0 位。
+inline float Bf16ToFloat(uint16_t bf16)
+{
+  return BitsFloat(static_cast<uint32_t>(bf16) << 16);
+}
+
+// float -> bf16 就近舍入、中间值远离 0，与核函数中 Cast(CAST_ROUND) 一致；NaN 保持为 quiet NaN。
+inline uint16_t FloatToBf16(float value)
+{
+  uint32_t bits = FloatBits(value);
+  if ((bits & 0x7fffffff) > 0x7f800000) {
+    return static_cast<uint16_t>((bits >> 16) | 0x40);
+  }
+  return static_cast<uint16_t>((bits + 0x8000) >> 16);
+}
+}  // namespace opcpu
+
+#endif  // CPU_DTYPE_H
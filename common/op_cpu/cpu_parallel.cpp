@@ -0,0 +1,97 @@
+#include "cpu_parallel.h"
+
+namespace opcpu {
+ThreadPool::ThreadPool(uint32_t workerNum)
+    : generation(0), stopping(false), job(nullptr), jobTotal(0), jobGrain(1), helpers(0), pending(0), nextChunk(0)
+{
+  for (uint32_t i = 0; i < workerNum; i++) {
+    workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+ThreadPool& ThreadPool::Instance()
+{
+  uint32_t hardware = std::thread::hardware_concurrency();
+  static ThreadPool pool(hardware > 1 ? hardware - 1 : 0);
+  return pool;
+}
+
+void ThreadPool::RunChunks()
+{
+  uint64_t chunkNum = (jobTotal + jobGrain - 1) / jobGrain;
+  for (uint64_t chunk = nextChunk.fetch_add(1); chunk < chunkNum; chunk = nextChunk.fetch_add(1)) {
+    uint64_t begin = chunk * jobGrain;
+    uint64_t end = begin + jobGrain < jobTotal ? begin + jobGrain : jobTotal;
+    (*job)(begin, end);
+  }
+}
+
+void ThreadPool::WorkerLoop(uint32_t index)
+{
+  uint64_t seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [&] { return stopping || generation != seen; });
+      if (stopping) {
+        return;
+      }
+      seen = generation;
+      if (index >= helpers) {
+        continue;
+      }
+    }
+    RunChunks();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pending--;
+    }
+    done.notify_one();
+  }
+}
+
+void ThreadPool::ParallelFor(uint64_t total, uint64_t grain, uint32_t threadNum,
+                             const std::function<void(uint64_t, uint64_t)>& fn)
+{
+  if (total == 0) {
+    return;
+  }
+  grain = grain > 0 ? grain : 1;
+  uint64_t chunkNum = (total + grain - 1) / grain;
+  uint64_t threads = (threadNum == 0 || threadNum > MaxThreads()) ? MaxThreads() : threadNum;
+  threads = threads < chunkNum ? threads : chunkNum;
+  if (threads <= 1) {
+    fn(0, total);
+    return;
+  }
+
+  std::lock_guard<std::mutex> call(callMutex);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    job = &fn;
+    jobTotal = total;
+    jobGrain = grain;
+    helpers = static_cast<uint32_t>(threads - 1);
+    pending = helpers;
+    nextChunk.store(0);
+    generation++;
+  }
+  wake.notify_all();
+  RunChunks();
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait(lock, [&] { return pending == 0; });
+  job = nullptr;
+}
+}  // namespace opcpu
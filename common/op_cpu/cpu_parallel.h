@@ -0,0 +1,59 @@
+#ifndef CPU_PARALLEL_H
+#define CPU_PARALLEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace opcpu {
+// 常驻线程池：工作线程在构造时创建，之后每次 ParallelFor 只需唤醒，避免小张量上反复创建线程的开销。
+// 同一时刻只执行一个任务，多个线程同时调用 ParallelFor 时依次执行；任务内不能再调用 ParallelFor。
+class ThreadPool {
+public:
+  explicit ThreadPool(uint32_t workerNum);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // 进程内共享的线程池，线程总数（含调用线程）为 CPU 的硬件线程数。
+  static ThreadPool& Instance();
+
+  // 可同时参与计算的线程数，含调用线程。
+  uint32_t MaxThreads() const
+  {
+    return static_cast<uint32_t>(workers.size()) + 1;
+  }
+
+  // 把 [0, total) 按 grain 切块，调用线程与工作线程动态领取，fn(begin, end) 返回前所有块都已完成。
+  // threadNum 为 0 时使用全部线程；只有一块或 threadNum 为 1 时直接在调用线程中执行。
+  void ParallelFor(uint64_t total, uint64_t grain, uint32_t threadNum,
+                   const std::function<void(uint64_t, uint64_t)>& fn);
+
+private:
+  void WorkerLoop(uint32_t index);
+  void RunChunks();
+
+  std::vector<std::thread> workers;
+  std::mutex callMutex;   // 串行化 ParallelFor 的调用方
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  uint64_t generation;
+  bool stopping;
+
+  // 当前任务，在 mutex 保护下由调用方设置。
+  const std::function<void(uint64_t, uint64_t)>* job;
+  uint64_t jobTotal;
+  uint64_t jobGrain;
+  uint32_t helpers;    // 参与当前任务的工作线程数
+  uint32_t pending;    // 尚未完成的工作线程数
+  std::atomic<uint64_t> nextChunk;
+};
+}  // namespace opcpu
+
+#endif  // CPU_PARALLEL_H
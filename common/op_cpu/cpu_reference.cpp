@@ -0,0 +1,493 @@
+#include "cpu_reference.h"
+
+#include <cmath>
+#include <limits>
+
+#include "cpu_parallel.h"
+#include "cpu_simd.h"
+#include "../op_host/broadcast_planner.h"
+#include "../op_host/broadcast_shape.h"
+
+namespace opcpu {
+namespace {
+const float FLOAT_INF = std::numeric_limits<float>::infinity();
+const float FLOAT_NAN = std::numeric_limits<float>::quiet_NaN();
+const float MAX_EXACT_INT = 16777216.0f;   // 2^24，绝对值不小于该值的 float 都是偶数
+const int32_t MAX_INT_EXPONENT = 32;       // 与 KernelPows_ScalarExp 一致，绝对值不超过该值的整数指数走平方-乘法
+const uint64_t CHUNK = 512;                // 一段内每次转换为 float 计算的元素数
+const uint64_t POWS_GRAIN = 16384;         // 线程池每次领取的输出元素数：pow 以 ln / exp 为主，粒度较小
+const uint64_t SELECT_GRAIN = 65536;       // select 只搬运数据，粒度较大以摊薄调度开销
+
+// 供 InferBroadcastShape / BroadcastPlanner 使用的形状。
+class RefShape {
+public:
+  RefShape() {}
+  explicit RefShape(const std::vector<int64_t>& dims) : dims(dims) {}
+
+  size_t GetDimNum() const { return dims.size(); }
+  int64_t GetDim(size_t i) const { return dims[i]; }
+  void SetDimNum(size_t n) { dims.resize(n); }
+  void SetDim(size_t i, int64_t v) { dims[i] = v; }
+  const std::vector<int64_t>& Dims() const { return dims; }
+
+private:
+  std::vector<int64_t> dims;
+};
+
+// 合并后形状的分段遍历：从输出下标 begin 到 end，按合并后的最内维切段，
+// 每段回调 fn(offsets, inner, yOffset, count)，offsets / inner 为各输入在该段的起始偏移与最内维步长（0 或 1）。
+// 行号只在段与段之间按里程表前进，段内没有除法与取模。
+class SegmentWalker {
+public:
+  SegmentWalker(const optiling::BroadcastPlanner& planner, uint32_t inputNum) : planner(planner), inputNum(inputNum)
+  {
+    dimNum = planner.DimNum();
+    rowLength = planner.OutShape()[dimNum - 1];
+    for (uint32_t k = 0; k < inputNum; k++) {
+      inner[k] = planner.Strides(k)[dimNum - 1];
+    }
+  }
+
+  template <typename Fn>
+  void Walk(uint64_t begin, uint64_t end, Fn fn) const
+  {
+    const uint32_t* shape = planner.OutShape();
+    uint64_t coord[optiling::BroadcastPlanner::MAX_DIM_NUM] = {0};
+    uint64_t rowOffsets[optiling::BroadcastPlanner::MAX_INPUT_NUM] = {0};
+    uint64_t offsets[optiling::BroadcastPlanner::MAX_INPUT_NUM];
+    uint64_t row = begin / rowLength;
+    uint64_t col = begin - row * rowLength;
+    for (int32_t j = static_cast<int32_t>(dimNum) - 2; j >= 0; j--) {
+      coord[j] = row % shape[j];
+      row /= shape[j];
+      for (uint32_t k = 0; k < inputNum; k++) {
+        rowOffsets[k] += coord[j] * planner.Strides(k)[j];
+      }
+    }
+    uint64_t index = begin;
+    while (index < end) {
+      uint64_t count = rowLength - col < end - index ? rowLength - col : end - index;
+      for (uint32_t k = 0; k < inputNum; k++) {
+        offsets[k] = rowOffsets[k] + col * inner[k];
+      }
+      fn(offsets, inner, index, count);
+      index += count;
+      col = 0;
+      for (int32_t j = static_cast<int32_t>(dimNum) - 2; j >= 0; j--) {
+        for (uint32_t k = 0; k < inputNum; k++) {
+          rowOffsets[k] += planner.Strides(k)[j];
+        }
+        if (++coord[j] < shape[j]) {
+          break;
+        }
+        for (uint32_t k = 0; k < inputNum; k++) {
+          rowOffsets[k] -= static_cast<uint64_t>(planner.Strides(k)[j]) * shape[j];
+        }
+        coord[j] = 0;
+      }
+    }
+  }
+
+private:
+  const optiling::BroadcastPlanner& planner;
+  uint32_t inputNum;
+  uint32_t dimNum;
+  uint64_t rowLength;
+  uint64_t inner[optiling::BroadcastPlanner::MAX_INPUT_NUM];
+};
+
+bool IsPowsType(DataType dtype)
+{
+  return dtype == DataType::FLOAT || dtype == DataType::FLOAT16 || dtype == DataType::BF16;
+}
+
+// y 的形状需等于各输入按 NumPy 规则广播后的形状；通过后按合并后的形状规划遍历。
+RefStatus PlanShapes(const std::vector<const std::vector<int64_t>*>& inputs, const std::vector<int64_t>& yShape,
+                     optiling::BroadcastPlanner& planner)
+{
+  std::vector<std::vector<int64_t>> shapes;
+  for (const std::vector<int64_t>* shape : inputs) {
+    shapes.push_back(*shape);
+  }
+  std::vector<int64_t> expected;
+  RefStatus status = BroadcastOutputShape(shapes, expected);
+  if (status != RefStatus::OK) {
+    return status;
+  }
+  if (expected != yShape) {
+    return RefStatus::SHAPE_MISMATCH;
+  }
+  for (const std::vector<int64_t>* shape : inputs) {
+    planner.AddInput(RefShape(*shape));
+  }
+  return planner.Plan() ? RefStatus::OK : RefStatus::INCOMPATIBLE_SHAPE;
+}
+
+// 读取 count 个元素到 float，stride 为 0 时整段都是 src[0]。
+void LoadFloat(DataType dtype, const uint8_t* src, uint64_t stride, float* dst, uint64_t count)
+{
+  if (stride == 0) {
+    float value;
+    if (dtype == DataType::FLOAT) {
+      std::memcpy(&value, src, sizeof(value));
+    } else {
+      uint16_t bits;
+      std::memcpy(&bits, src, sizeof(bits));
+      value = dtype == DataType::FLOAT16 ? HalfToFloat(bits) : Bf16ToFloat(bits);
+    }
+    for (uint64_t i = 0; i < count; i++) {
+      dst[i] = value;
+    }
+    return;
+  }
+  if (dtype == DataType::FLOAT) {
+    std::memcpy(dst, src, count * sizeof(float));
+  } else if (dtype == DataType::FLOAT16) {
+    HalfToFloat(reinterpret_cast<const uint16_t*>(src), dst, count);
+  } else {
+    Bf16ToFloat(reinterpret_cast<const uint16_t*>(src), dst, count);
+  }
+}
+
+void StoreFloat(DataType dtype, const float* src, uint8_t* dst, uint64_t count)
+{
+  if (dtype == DataType::FLOAT) {
+    std::memcpy(dst, src, count * sizeof(float));
+  } else if (dtype == DataType::FLOAT16) {
+    FloatToHalf(src, reinterpret_cast<uint16_t*>(dst), count);
+  } else {
+    FloatToBf16(src, reinterpret_cast<uint16_t*>(dst), count);
+  }
+}
+
+// 与 PowsSignFixup::Apply 相同的修正，res 为 exp(expo * ln|base|)。
+float SignFixup(float res, float base, float expo)
+{
+  bool keep = (std::fabs(base) != 1.0f || std::fabs(expo) != FLOAT_INF) && expo != 0.0f && base != 1.0f;
+  // 指数先截断到 ±2^24，再按 CAST_FLOOR 判断是否为整数、是否为奇数；NaN 不是整数。
+  float work = expo < MAX_EXACT_INT ? expo : MAX_EXACT_INT;
+  work = work > -MAX_EXACT_INT ? work : -MAX_EXACT_INT;
+  bool isInt = work == work && static_cast<float>(static_cast<int32_t>(std::floor(work))) == work;
+  float half = work * 0.5f;
+  bool odd = isInt && static_cast<float>(static_cast<int32_t>(std::floor(half))) != half;
+  // 奇数次幂按符号位取负（含 -0.0），非整数次幂只有有限的负底数为 NaN。
+  if (odd && std::signbit(base)) {
+    res = -res;
+  }
+  if (!isInt && base < 0.0f && base != -FLOAT_INF) {
+    res = FLOAT_NAN;
+  }
+  return keep ? res : 1.0f;
+}
+
+// 与 PowsSignFixup::ApplyScalar 相同的修正，奇偶性与是否为整数只由标量指数决定。
+float SignFixupScalar(float res, float base, float expo)
+{
+  float absExpo = std::fabs(expo);
+  if (absExpo == FLOAT_INF) {
+    return std::fabs(base) != 1.0f ? res : 1.0f;
+  }
+  if (expo != expo) {
+    return base != 1.0f ? res : 1.0f;
+  }
+  if (absExpo >= MAX_EXACT_INT || static_cast<float>(static_cast<int32_t>(expo)) == expo) {
+    bool isOdd = absExpo < MAX_EXACT_INT && (static_cast<int32_t>(expo) & 1) != 0;
+    return (isOdd && std::signbit(base)) ? -res : res;
+  }
+  return (base >= 0.0f || base == -FLOAT_INF) ? res : FLOAT_NAN;
+}
+
+// 与 op_kernel/pows.cpp 中 ScalarExpMode 一致。
+enum class ScalarExpMode { ONE, COPY, SQUARE, SQRT, RSQRT, RECIPROCAL, INTEGER, GENERAL };
+
+struct PowsMode {
+  bool signAware;
+  bool scalarExp;   // x2 只有一个元素，对应 KernelPows_ScalarExp
+  ScalarExpMode expMode;
+  float exponent;
+  int32_t intExponent;
+};
+
+void SetExponent(PowsMode& mode, float exponent)
+{
+  mode.exponent = exponent;
+  mode.intExponent = 0;
+  if (exponent == 0.0f) {
+    mode.expMode = ScalarExpMode::ONE;
+  } else if (exponent == 1.0f) {
+    mode.expMode = ScalarExpMode::COPY;
+  } else if (exponent == 2.0f) {
+    mode.expMode = ScalarExpMode::SQUARE;
+  } else if (exponent == 0.5f) {
+    mode.expMode = ScalarExpMode::SQRT;
+  } else if (exponent == -0.5f) {
+    mode.expMode = ScalarExpMode::RSQRT;
+  } else if (exponent == -1.0f) {
+    mode.expMode = ScalarExpMode::RECIPROCAL;
+  } else if (exponent >= -MAX_INT_EXPONENT && exponent <= MAX_INT_EXPONENT &&
+             static_cast<float>(static_cast<int32_t>(exponent)) == exponent) {
+    mode.intExponent = static_cast<int32_t>(exponent);
+    mode.expMode = ScalarExpMode::INTEGER;
+  } else {
+    mode.expMode = ScalarExpMode::GENERAL;
+  }
+}
+
+// 平方-乘法，乘法顺序与 PowsScalarCompute::PowerBySquaring 相同。
+float PowerBySquaring(float base, int32_t exponent)
+{
+  uint32_t n = exponent < 0 ? static_cast<uint32_t>(-exponent) : static_cast<uint32_t>(exponent);
+  float dst = 0.0f;
+  bool first = true;
+  while (n > 0) {
+    if (n & 1) {
+      dst = first ? base * 1.0f : dst * base;
+      first = false;
+    }
+    n >>= 1;
+    if (n > 0) {
+      base = base * base;
+    }
+  }
+  return exponent < 0 ? 1.0f / dst : dst;
+}
+
+float PowsScalarElement(const PowsMode& mode, float base)
+{
+  switch (mode.expMode) {
+    case ScalarExpMode::ONE:
+      return 1.0f;
+    case ScalarExpMode::COPY:
+      return base * 1.0f;
+    case ScalarExpMode::SQUARE:
+      return base * base;
+    case ScalarExpMode::SQRT:
+      // sign_aware 与 PowsSignFixup::UnsignedZero / ApplyNegInf 相同：-0.0 按 +0.0 开方，-inf 取 +inf。
+      if (mode.signAware) {
+        return base == -FLOAT_INF ? FLOAT_INF : std::sqrt(base + 0.0f);
+      }
+      return std::sqrt(base);
+    case ScalarExpMode::RSQRT:
+      if (mode.signAware) {
+        return base == -FLOAT_INF ? 0.0f : 1.0f / std::sqrt(base + 0.0f);
+      }
+      return 1.0f / std::sqrt(base);
+    case ScalarExpMode::RECIPROCAL:
+      return 1.0f / base;
+    case ScalarExpMode::INTEGER:
+      return PowerBySquaring(base, mode.intExponent);
+    default:
+      break;
+  }
+  if (mode.signAware) {
+    return SignFixupScalar(std::exp(std::log(std::fabs(base)) * mode.exponent), base, mode.exponent);
+  }
+  return std::exp(std::log(base) * mode.exponent);
+}
+
+float PowsElement(const PowsMode& mode, float base, float expo)
+{
+  if (mode.signAware) {
+    return SignFixup(std::exp(expo * std::log(std::fabs(base))), base, expo);
+  }
+  return std::exp(expo * std::log(base));
+}
+
+// 一段输出的 pow：x1、x2 的步长为 0 或 1，结果按 dtype 写入 y。
+void PowsSegment(const PowsMode& mode, DataType dtype, const uint8_t* x1, uint64_t s1, const uint8_t* x2, uint64_t s2,
+                 uint8_t* y, uint64_t count)
+{
+  size_t width = DataTypeSize(dtype);
+  float base[CHUNK];
+  float expo[CHUNK];
+  float res[CHUNK];
+  for (uint64_t done = 0; done < count; done += CHUNK) {
+    uint64_t n = count - done < CHUNK ? count - done : CHUNK;
+    LoadFloat(dtype, x1 + done * s1 * width, s1, base, n);
+    if (mode.scalarExp) {
+      for (uint64_t i = 0; i < n; i++) {
+        res[i] = PowsScalarElement(mode, base[i]);
+      }
+    } else {
+      LoadFloat(dtype, x2 + done * s2 * width, s2, expo, n);
+      for (uint64_t i = 0; i < n; i++) {
+        res[i] = PowsElement(mode, base[i], expo[i]);
+      }
+    }
+    StoreFloat(dtype, res, y + done * width, n);
+  }
+}
+
+void SelectByWidth(size_t width, const uint8_t* cond, uint64_t cs, const uint8_t* x1, uint64_t s1, const uint8_t* x2,
+                   uint64_t s2, uint8_t* y, uint64_t count)
+{
+  switch (width) {
+    case 1:
+      SelectSegment<1>(cond, cs, x1, s1, x2, s2, y, count);
+      break;
+    case 2:
+      SelectSegment<2>(cond, cs, x1, s1, x2, s2, y, count);
+      break;
+    case 4:
+      SelectSegment<4>(cond, cs, x1, s1, x2, s2, y, count);
+      break;
+    default:
+      SelectSegment<8>(cond, cs, x1, s1, x2, s2, y, count);
+      break;
+  }
+}
+}  // namespace
+
+RefStatus BroadcastOutputShape(const std::vector<std::vector<int64_t>>& shapes, std::vector<int64_t>& out)
+{
+  std::vector<RefShape> inputs;
+  std::vector<const RefShape*> pointers;
+  for (const std::vector<int64_t>& shape : shapes) {
+    for (int64_t dim : shape) {
+      if (dim < 0) {
+        return RefStatus::INCOMPATIBLE_SHAPE;
+      }
+    }
+    inputs.emplace_back(shape);
+  }
+  for (const RefShape& shape : inputs) {
+    pointers.push_back(&shape);
+  }
+  RefShape result;
+  if (ge::InferBroadcastShape(pointers.data(), static_cast<uint32_t>(pointers.size()),
+                              optiling::BroadcastPlanner::MAX_INPUT_DIM_NUM, result) != ge::BroadcastShapeStatus::OK) {
+    return RefStatus::INCOMPATIBLE_SHAPE;
+  }
+  out = result.Dims();
+  return RefStatus::OK;
+}
+
+RefStatus Pows(const ConstTensor& x1, const ConstTensor& x2, const Tensor& y, bool signAware, const RefOptions& options)
+{
+  if (!IsPowsType(x1.dtype) || x2.dtype != x1.dtype || y.dtype != x1.dtype) {
+    return RefStatus::UNSUPPORTED_DTYPE;
+  }
+  optiling::BroadcastPlanner planner;
+  RefStatus status = PlanShapes({&x1.shape, &x2.shape}, y.shape, planner);
+  if (status != RefStatus::OK || planner.OutSize() == 0) {
+    return status;
+  }
+  PowsMode mode = {signAware, planner.IsScalar(1), ScalarExpMode::GENERAL, 0.0f, 0};
+  if (mode.scalarExp) {
+    float exponent;
+    LoadFloat(x2.dtype, static_cast<const uint8_t*>(x2.data), 0, &exponent, 1);
+    SetExponent(mode, exponent);
+  }
+
+  size_t width = DataTypeSize(y.dtype);
+  const uint8_t* x1Data = static_cast<const uint8_t*>(x1.data);
+  const uint8_t* x2Data = static_cast<const uint8_t*>(x2.data);
+  uint8_t* yData = static_cast<uint8_t*>(y.data);
+  SegmentWalker walker(planner, 2);
+  ThreadPool::Instance().ParallelFor(planner.OutSize(), POWS_GRAIN, options.threadNum,
+      [&](uint64_t begin, uint64_t end) {
+        walker.Walk(begin, end, [&](const uint64_t* offsets, const uint64_t* inner, uint64_t index, uint64_t count) {
+          PowsSegment(mode, y.dtype, x1Data + offsets[0] * width, inner[0], x2Data + offsets[1] * width, inner[1],
+                      yData + index * width, count);
+        });
+      });
+  return RefStatus::OK;
+}
+
+RefStatus SelectV2(const ConstTensor& condition, const ConstTensor& x1, const ConstTensor& x2, const Tensor& y,
+                   bool packedCondition, const RefOptions& options)
+{
+  bool conditionOk = packedCondition ? condition.dtype == DataType::UINT8
+                                     : (condition.dtype == DataType::BOOL || condition.dtype == DataType::UINT8);
+  if (!conditionOk || x2.dtype != x1.dtype || y.dtype != x1.dtype) {
+    return RefStatus::UNSUPPORTED_DTYPE;
+  }
+  size_t width = DataTypeSize(y.dtype);
+  const uint8_t* conditionData = static_cast<const uint8_t*>(condition.data);
+  const uint8_t* x1Data = static_cast<const uint8_t*>(x1.data);
+  const uint8_t* x2Data = static_cast<const uint8_t*>(x2.data);
+  uint8_t* yData = static_cast<uint8_t*>(y.data);
+
+  optiling::BroadcastPlanner planner;
+  if (packedCondition) {
+    // 与 TilingFunc 相同：打包的 condition 不参与广播，x1、x2 需同形状，condition 恰好覆盖全部元素。
+    RefStatus status = PlanShapes({&x1.shape, &x2.shape}, y.shape, planner);
+    if (status != RefStatus::OK) {
+      return status;
+    }
+    uint64_t conditionSize = 1;
+    for (int64_t dim : condition.shape) {
+      conditionSize *= static_cast<uint64_t>(dim);
+    }
+    if (!planner.AllFull() || conditionSize != (planner.OutSize() + 7) / 8) {
+      return RefStatus::INCOMPATIBLE_SHAPE;
+    }
+    ThreadPool::Instance().ParallelFor(planner.OutSize(), SELECT_GRAIN, options.threadNum,
+        [&](uint64_t begin, uint64_t end) {
+          uint8_t bytes[CHUNK];
+          for (uint64_t index = begin; index < end; index += CHUNK) {
+            uint64_t n = end - index < CHUNK ? end - index : CHUNK;
+            for (uint64_t i = 0; i < n; i++) {
+              uint64_t bit = index + i;
+              bytes[i] = (conditionData[bit / 8] >> (bit % 8)) & 1;
+            }
+            SelectByWidth(width, bytes, 1, x1Data + index * width, 1, x2Data + index * width, 1,
+                          yData + index * width, n);
+          }
+        });
+    return RefStatus::OK;
+  }
+
+  RefStatus status = PlanShapes({&condition.shape, &x1.shape, &x2.shape}, y.shape, planner);
+  if (status != RefStatus::OK || planner.OutSize() == 0) {
+    return status;
+  }
+  SegmentWalker walker(planner, 3);
+  ThreadPool::Instance().ParallelFor(planner.OutSize(), SELECT_GRAIN, options.threadNum,
+      [&](uint64_t begin, uint64_t end) {
+        walker.Walk(begin, end, [&](const uint64_t* offsets, const uint64_t* inner, uint64_t index, uint64_t count) {
+          SelectByWidth(width, conditionData + offsets[0], inner[0], x1Data + offsets[1] * width, inner[1],
+                        x2Data + offsets[2] * width, inner[2], yData + index * width, count);
+        });
+      });
+  return RefStatus::OK;
+}
+
+RefStatus PowsSelect(const ConstTensor& condition, const ConstTensor& x1, const ConstTensor& x2, const ConstTensor& x3,
+                     const Tensor& y, bool signAware, const RefOptions& options)
+{
+  if (condition.dtype != DataType::BOOL || !IsPowsType(x1.dtype) || x2.dtype != x1.dtype || x3.dtype != x1.dtype ||
+      y.dtype != x1.dtype) {
+    return RefStatus::UNSUPPORTED_DTYPE;
+  }
+  optiling::BroadcastPlanner planner;
+  RefStatus status = PlanShapes({&condition.shape, &x1.shape, &x2.shape, &x3.shape}, y.shape, planner);
+  if (status != RefStatus::OK || planner.OutSize() == 0) {
+    return status;
+  }
+  // PowsSelect 的核函数没有标量指数分支，总是按 exp(x2 * ln(x1)) 计算。
+  PowsMode mode = {signAware, false, ScalarExpMode::GENERAL, 0.0f, 0};
+  size_t width = DataTypeSize(y.dtype);
+  const uint8_t* conditionData = static_cast<const uint8_t*>(condition.data);
+  const uint8_t* x1Data = static_cast<const uint8_t*>(x1.data);
+  const uint8_t* x2Data = static_cast<const uint8_t*>(x2.data);
+  const uint8_t* x3Data = static_cast<const uint8_t*>(x3.data);
+  uint8_t* yData = static_cast<uint8_t*>(y.data);
+  SegmentWalker walker(planner, 4);
+  ThreadPool::Instance().ParallelFor(planner.OutSize(), POWS_GRAIN, options.threadNum,
+      [&](uint64_t begin, uint64_t end) {
+        uint8_t powered[CHUNK * sizeof(float)];
+        walker.Walk(begin, end, [&](const uint64_t* offsets, const uint64_t* inner, uint64_t index, uint64_t count) {
+          for (uint64_t done = 0; done < count; done += CHUNK) {
+            uint64_t n = count - done < CHUNK ? count - done : CHUNK;
+            PowsSegment(mode, y.dtype, x1Data + (offsets[1] + done * inner[1]) * width, inner[1],
+                        x2Data + (offsets[2] + done * inner[2]) * width, inner[2], powered, n);
+            SelectByWidth(width, conditionData + offsets[0] + done * inner[0], inner[0], powered, 1,
+                          x3Data + (offsets[3] + done * inner[3]) * width, inner[3],
+                          yData + (index + done) * width, n);
+          }
+        });
+      });
+  return RefStatus::OK;
+}
+}  // namespace opcpu
@@ -0,0 +1,60 @@
+#ifndef CPU_REFERENCE_H
+#define CPU_REFERENCE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "cpu_dtype.h"
+
+namespace opcpu {
+// Pows、SelectV2、PowsSelect 的 CPU 参考实现，可在没有 NPU 的 Linux 机器上运行，作为核函数结果的比对基准。
+// 与算子的约定保持一致：
+//   广播：与 InferShape / TilingFunc 共用 common/op_host 中的 InferBroadcastShape 与 BroadcastPlanner；
+//   计算：按核函数的计算方式逐元素复现，half / bf16 先转换为 float，结果按 CAST_NONE / CAST_ROUND 转换回原类型；
+//     指数 x2 只有一个元素时与 KernelPows_ScalarExp 一样按指数取值选择平方、开方、倒数等计算方式；
+//     sign_aware 的修正与 PowsSignFixup 相同，指数的整数判断按 CAST_FLOOR 截断到 int32。
+//   select 只搬运数据的位，condition 不为 0 即取 x1。
+// 合并后的输出按元素均分给线程池，每段在合并后的最内维上连续处理，转换与选择使用 AVX2 / NEON（见 cpu_simd.h）。
+// ln / exp 使用 libm 的 float 版本，不做向量近似，保证参考结果的精度。
+
+enum class RefStatus {
+  OK,
+  UNSUPPORTED_DTYPE,    // dtype 不在算子注册的范围内，或输入输出 dtype 不一致
+  INCOMPATIBLE_SHAPE,   // 输入不满足广播规则、维度过多，或打包 condition 的长度不符
+  SHAPE_MISMATCH,       // y 的形状与广播后的输出形状不同
+};
+
+struct ConstTensor {
+  const void* data;
+  DataType dtype;
+  std::vector<int64_t> shape;
+};
+
+struct Tensor {
+  void* data;
+  DataType dtype;
+  std::vector<int64_t> shape;
+};
+
+struct RefOptions {
+  uint32_t threadNum = 0;   // 0 表示使用线程池中的全部线程
+};
+
+// 按 NumPy 规则推导多个输入广播后的形状，与各算子的 InferShape 一致。
+RefStatus BroadcastOutputShape(const std::vector<std::vector<int64_t>>& shapes, std::vector<int64_t>& out);
+
+// y = x1 ** x2，x1、x2、y 为同一 dtype（float / float16 / bf16）。
+RefStatus Pows(const ConstTensor& x1, const ConstTensor& x2, const Tensor& y, bool signAware = false,
+               const RefOptions& options = RefOptions());
+
+// y = condition ? x1 : x2。condition 为 bool / uint8；packedCondition 时 condition 为 PackCondition 的输出
+// （每个字节 8 个元素，低位在前），x1、x2 需与 y 同形状。
+RefStatus SelectV2(const ConstTensor& condition, const ConstTensor& x1, const ConstTensor& x2, const Tensor& y,
+                   bool packedCondition = false, const RefOptions& options = RefOptions());
+
+// y = condition ? x1 ** x2 : x3，pow 的结果先转换为 y 的 dtype 再选择，与 PowsSelect 的核函数一致。
+RefStatus PowsSelect(const ConstTensor& condition, const ConstTensor& x1, const ConstTensor& x2, const ConstTensor& x3,
+                     const Tensor& y, bool signAware = false, const RefOptions& options = RefOptions());
+}  // namespace opcpu
+
+#endif  // CPU_REFERENCE_H
@@ -0,0 +1,274 @@
+#ifndef CPU_SIMD_H
+#define CPU_SIMD_H
+
+#include <cstdint>
+#include <cstring>
+
+#include "cpu_dtype.h"
+
+#if defined(__AVX2__) && defined(__F16C__)
+#include <immintrin.h>
+#define OPCPU_SIMD_AVX2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define OPCPU_SIMD_NEON 1
+#endif
+
+namespace opcpu {
+// CPU 参考实现的向量化内核：类型转换与按 condition 选择。
+// 编译时按目标指令集选择 AVX2 + F16C、AArch64 NEON 或标量实现，三者结果逐位一致。
+
+inline const char* SimdName()
+{
+#if defined(OPCPU_SIMD_AVX2)
+  return "avx2";
+#elif defined(OPCPU_SIMD_NEON)
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
+
+// count 个 half 转换为 float。
+inline void HalfToFloat(const uint16_t* src, float* dst, uint64_t count)
+{
+  uint64_t i = 0;
+#if defined(OPCPU_SIMD_AVX2)
+  for (; i + 8 <= count; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+  }
+#elif defined(OPCPU_SIMD_NEON)
+  for (; i + 4 <= count; i += 4) {
+    vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+  }
+#endif
+  for (; i < count; i++) {
+    dst[i] = HalfToFloat(src[i]);
+  }
+}
+
+// count 个 float 转换为 half，就近取偶。
+inline void FloatToHalf(const float* src, uint16_t* dst, uint64_t count)
+{
+  uint64_t i = 0;
+#if defined(OPCPU_SIMD_AVX2)
+  for (; i + 8 <= count; i += 8) {
+    __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), half);
+  }
+#elif defined(OPCPU_SIMD_NEON)
+  for (; i + 4 <= count; i += 4) {
+    vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+  }
+#endif
+  for (; i < count; i++) {
+    dst[i] = FloatToHalf(src[i]);
+  }
+}
+
+inline void Bf16ToFloat(const uint16_t* src, float* dst, uint64_t count)
+{
+  uint64_t i = 0;
+#if defined(OPCPU_SIMD_AVX2)
+  for (; i + 8 <= count; i += 8) {
+    __m256i wide = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+    _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(_mm256_slli_epi32(wide, 16)));
+  }
+#elif defined(OPCPU_SIMD_NEON)
+  for (; i + 4 <= count; i += 4) {
+    vst1q_f32(dst + i, vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(src + i), 16)));
+  }
+#endif
+  for (; i < count; i++) {
+    dst[i] = Bf16ToFloat(src[i]);
+  }
+}
+
+// count 个 float 转换为 bf16，就近舍入、中间值远离 0（CAST_ROUND）。
+inline void FloatToBf16(const float* src, uint16_t* dst, uint64_t count)
+{
+  uint64_t i = 0;
+#if defined(OPCPU_SIMD_AVX2)
+  const __m256i absMask = _mm256_set1_epi32(0x7fffffff);
+  const __m256i inf = _mm256_set1_epi32(0x7f800000);
+  const __m256i roundBias = _mm256_set1_epi32(0x8000);
+  const __m256i quiet = _mm256_set1_epi32(0x40);
+  for (; i + 8 <= count; i += 8) {
+    __m256i bits = _mm256_castps_si256(_mm256_loadu_ps(src + i));
+    __m256i isNan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, absMask), inf);
+    __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(bits, roundBias), 16);
+    __m256i nan = _mm256_or_si256(_mm256_srli_epi32(bits, 16), quiet);
+    __m256i out = _mm256_blendv_epi8(rounded, nan, isNan);
+    // packus 在两个 128 位通道内分别打包，再把两个通道的低 64 位拼到一起。
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(out, out), 0xD8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_castsi256_si128(packed));
+  }
+#elif defined(OPCPU_SIMD_NEON)
+  const uint32x4_t inf = vdupq_n_u32(0x7f800000);
+  const uint32x4_t roundBias = vdupq_n_u32(0x8000);
+  const uint32x4_t quiet = vdupq_n_u32(0x40);
+  for (; i + 4 <= count; i += 4) {
+    uint32x4_t bits = vreinterpretq_u32_f32(vld1q_f32(src + i));
+    uint32x4_t isNan = vcgtq_u32(vandq_u32(bits, vdupq_n_u32(0x7fffffff)), inf);
+    uint32x4_t rounded = vshrq_n_u32(vaddq_u32(bits, roundBias), 16);
+    uint32x4_t nan = vorrq_u32(vshrq_n_u32(bits, 16), quiet);
+    vst1_u16(dst + i, vmovn_u32(vbslq_u32(isNan, nan, rounded)));
+  }
+#endif
+  for (; i < count; i++) {
+    dst[i] = FloatToBf16(src[i]);
+  }
+}
+
+// 按 condition 选择宽度为 W 字节的元素：y[i] = cond[i * cs] != 0 ? x1[i * s1] : x2[i * s2]。
+// 步长只取 0（该输入沿这一段被广播）或 1，condition 为每个元素一个字节。
+template <uint32_t W>
+struct SelectKernel {
+  static void Scalar(const uint8_t* cond, uint64_t cs, const uint8_t* x1, uint64_t s1, const uint8_t* x2, uint64_t s2,
+                     uint8_t* y, uint64_t begin, uint64_t count)
+  {
+    for (uint64_t i = begin; i < count; i++) {
+      const uint8_t* src = cond[i * cs] != 0 ? x1 + i * s1 * W : x2 + i * s2 * W;
+      std::memcpy(y + i * W, src, W);
+    }
+  }
+
+#if defined(OPCPU_SIMD_AVX2)
+  static __m256i Load(const uint8_t* x, uint64_t stride, uint64_t i)
+  {
+    if (stride != 0) {
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i * W));
+    }
+    if (W == 1) {
+      return _mm256_set1_epi8(static_cast<char>(x[0]));
+    }
+    if (W == 2) {
+      uint16_t v;
+      std::memcpy(&v, x, sizeof(v));
+      return _mm256_set1_epi16(static_cast<short>(v));
+    }
+    if (W == 4) {
+      uint32_t v;
+      std::memcpy(&v, x, sizeof(v));
+      return _mm256_set1_epi32(static_cast<int>(v));
+    }
+    uint64_t v;
+    std::memcpy(&v, x, sizeof(v));
+    return _mm256_set1_epi64x(static_cast<long long>(v));
+  }
+
+  // 32 字节中每个元素的 condition 是否为 0，展开到元素宽度。
+  static __m256i ZeroMask(const uint8_t* cond)
+  {
+    const __m256i zero = _mm256_setzero_si256();
+    if (W == 1) {
+      return _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(cond)), zero);
+    }
+    if (W == 2) {
+      __m256i c = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cond)));
+      return _mm256_cmpeq_epi16(c, zero);
+    }
+    if (W == 4) {
+      __m256i c = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(cond)));
+      return _mm256_cmpeq_epi32(c, zero);
+    }
+    int32_t four;
+    std::memcpy(&four, cond, sizeof(four));
+    return _mm256_cmpeq_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(four)), zero);
+  }
+
+  static void Run(const uint8_t* cond, uint64_t cs, const uint8_t* x1, uint64_t s1, const uint8_t* x2, uint64_t s2,
+                  uint8_t* y, uint64_t count)
+  {
+    const uint64_t LANES = 32 / W;
+    uint64_t i = 0;
+    if (cs != 0) {
+      for (; i + LANES <= count; i += LANES) {
+        __m256i out = _mm256_blendv_epi8(Load(x1, s1, i), Load(x2, s2, i), ZeroMask(cond + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + i * W), out);
+      }
+    }
+    Scalar(cond, cs, x1, s1, x2, s2, y, i, count);
+  }
+#elif defined(OPCPU_SIMD_NEON)
+  static uint8x16_t Load(const uint8_t* x, uint64_t stride, uint64_t i)
+  {
+    if (stride != 0) {
+      return vld1q_u8(x + i * W);
+    }
+    if (W == 1) {
+      return vdupq_n_u8(x[0]);
+    }
+    if (W == 2) {
+      return vreinterpretq_u8_u16(vld1q_dup_u16(reinterpret_cast<const uint16_t*>(x)));
+    }
+    if (W == 4) {
+      return vreinterpretq_u8_u32(vld1q_dup_u32(reinterpret_cast<const uint32_t*>(x)));
+    }
+    return vreinterpretq_u8_u64(vld1q_dup_u64(reinterpret_cast<const uint64_t*>(x)));
+  }
+
+  // 16 字节中每个元素的 condition 是否不为 0，展开到元素宽度。
+  static uint8x16_t NonZeroMask(const uint8_t* cond)
+  {
+    if (W == 1) {
+      uint8x16_t c = vld1q_u8(cond);
+      return vtstq_u8(c, c);
+    }
+    uint8_t bytes[8] = {0};
+    std::memcpy(bytes, cond, 16 / W);
+    uint16x8_t c16 = vmovl_u8(vld1_u8(bytes));
+    if (W == 2) {
+      return vreinterpretq_u8_u16(vtstq_u16(c16, c16));
+    }
+    uint32x4_t c32 = vmovl_u16(vget_low_u16(c16));
+    if (W == 4) {
+      return vreinterpretq_u8_u32(vtstq_u32(c32, c32));
+    }
+    uint64x2_t c64 = vmovl_u32(vget_low_u32(c32));
+    return vreinterpretq_u8_u64(vtstq_u64(c64, c64));
+  }
+
+  static void Run(const uint8_t* cond, uint64_t cs, const uint8_t* x1, uint64_t s1, const uint8_t* x2, uint64_t s2,
+                  uint8_t* y, uint64_t count)
+  {
+    const uint64_t LANES = 16 / W;
+    uint64_t i = 0;
+    if (cs != 0) {
+      for (; i + LANES <= count; i += LANES) {
+        vst1q_u8(y + i * W, vbslq_u8(NonZeroMask(cond + i), Load(x1, s1, i), Load(x2, s2, i)));
+      }
+    }
+    Scalar(cond, cs, x1, s1, x2, s2, y, i, count);
+  }
+#else
+  static void Run(const uint8_t* cond, uint64_t cs, const uint8_t* x1, uint64_t s1, const uint8_t* x2, uint64_t s2,
+                  uint8_t* y, uint64_t count)
+  {
+    Scalar(cond, cs, x1, s1, x2, s2, y, 0, count);
+  }
+#endif
+};
+
+// 一段输出的选择。condition 沿这一段被广播时整段取同一个输入，退化为拷贝或填充。
+template <uint32_t W>
+inline void SelectSegment(const uint8_t* cond, uint64_t cs, const uint8_t* x1, uint64_t s1, const uint8_t* x2,
+                          uint64_t s2, uint8_t* y, uint64_t count)
+{
+  if (cs == 0) {
+    const uint8_t* src = cond[0] != 0 ? x1 : x2;
+    uint64_t stride = cond[0] != 0 ? s1 : s2;
+    if (stride != 0) {
+      std::memmove(y, src, count * W);
+      return;
+    }
+    for (uint64_t i = 0; i < count; i++) {
+      std::memcpy(y + i * W, src, W);
+    }
+    return;
+  }
+  SelectKernel<W>::Run(cond, cs, x1, s1, x2, s2, y, count);
+}
+}  // namespace opcpu
+
+#endif  // CPU_SIMD_H
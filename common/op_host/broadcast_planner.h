@@ -0,0 +1,170 @@
+#ifndef BROADCAST_PLANNER_H
+#define BROADCAST_PLANNER_H
+
+#include <algorithm>
+#include <cstdint>
+
+namespace optiling {
+// 多输入广播的形状合并与步长预计算，供各算子的 TilingFunc 共用。
+// 各输入右对齐后：
+//   1. 去掉输出长度为 1 的维度；
+//   2. 把广播模式（每个输入在该维上是否与输出等长）相同的相邻维度合并为一维；
+//   3. 按合并后的形状计算每个输入在各维上的元素步长，广播维的步长为 0。
+// 合并后的维度数不超过 MAX_DIM_NUM 即可，输入原始维度数可以更多（中间的长度 1 维度会被去掉）。
+class BroadcastPlanner {
+public:
+  static const uint32_t MAX_DIM_NUM = 8;
+  static const uint32_t MAX_INPUT_NUM = 4;
+  static const uint32_t MAX_INPUT_DIM_NUM = 32;
+
+  BroadcastPlanner() : inputNum(0), dimNum(0), outSize(0), rejected(false) {}
+
+  // 按顺序添加输入形状，ShapeT 需提供 GetDimNum() / GetDim(i)，如 gert::Shape。
+  template <typename ShapeT>
+  bool AddInput(const ShapeT& shape)
+  {
+    if (inputNum == MAX_INPUT_NUM || shape.GetDimNum() > MAX_INPUT_DIM_NUM) {
+      rejected = true;
+      return false;
+    }
+    rawDimNum[inputNum] = static_cast<uint32_t>(shape.GetDimNum());
+    for (uint32_t i = 0; i < rawDimNum[inputNum]; i++) {
+      rawDims[inputNum][i] = shape.GetDim(i);
+    }
+    inputNum++;
+    return true;
+  }
+
+  // 形状不满足广播规则、维度长度为负或合并后维度数超过 MAX_DIM_NUM 时返回 false。
+  bool Plan()
+  {
+    if (inputNum == 0 || rejected) {
+      return false;
+    }
+    uint32_t maxDimNum = 0;
+    for (uint32_t k = 0; k < inputNum; k++) {
+      maxDimNum = rawDimNum[k] > maxDimNum ? rawDimNum[k] : maxDimNum;
+    }
+    dimNum = 0;
+    outSize = 1;
+    uint32_t lastMode = 0;
+    for (uint32_t i = 0; i < maxDimNum; i++) {
+      int64_t dims[MAX_INPUT_NUM];
+      int64_t outDim = 1;
+      for (uint32_t k = 0; k < inputNum; k++) {
+        dims[k] = (i + rawDimNum[k] < maxDimNum) ? 1 : rawDims[k][i + rawDimNum[k] - maxDimNum];
+        if (dims[k] < 0) {
+          return false;
+        }
+        if (dims[k] != 1) {
+          if (outDim != 1 && dims[k] != outDim) {
+            return false;
+          }
+          outDim = dims[k];
+        }
+      }
+      if (outDim == 1) {
+        continue;
+      }
+      // mode 的第 k 位表示输入 k 在该维上是否与输出等长（即不需要广播）。
+      uint32_t mode = 0;
+      for (uint32_t k = 0; k < inputNum; k++) {
+        mode |= (dims[k] == outDim ? 1U : 0U) << k;
+      }
+      if (dimNum > 0 && mode == lastMode) {
+        outShape[dimNum - 1] *= static_cast<uint32_t>(outDim);
+        for (uint32_t k = 0; k < inputNum; k++) {
+          inShape[k][dimNum - 1] *= static_cast<uint32_t>(dims[k]);
+        }
+      } else {
+        if (dimNum == MAX_DIM_NUM) {
+          return false;
+        }
+        outShape[dimNum] = static_cast<uint32_t>(outDim);
+        for (uint32_t k = 0; k < inputNum; k++) {
+          inShape[k][dimNum] = static_cast<uint32_t>(dims[k]);
+        }
+        dimNum++;
+      }
+      lastMode = mode;
+      outSize *= static_cast<uint64_t>(outDim);
+    }
+    // 所有维度长度均为 1（含标量）时按一维、长度 1 处理。
+    if (dimNum == 0) {
+      outShape[0] = 1;
+      for (uint32_t k = 0; k < inputNum; k++) {
+        inShape[k][0] = 1;
+      }
+      dimNum = 1;
+    }
+    for (uint32_t k = 0; k < inputNum; k++) {
+      uint32_t stride = 1;
+      for (int32_t j = static_cast<int32_t>(dimNum) - 1; j >= 0; j--) {
+        strides[k][j] = (inShape[k][j] == 1 && outShape[j] != 1) ? 0 : stride;
+        stride *= inShape[k][j];
+      }
+      for (uint32_t j = dimNum; j < MAX_DIM_NUM; j++) {
+        strides[k][j] = 0;
+      }
+    }
+    for (uint32_t j = dimNum; j < MAX_DIM_NUM; j++) {
+      outShape[j] = 1;
+    }
+    return true;
+  }
+
+  uint32_t DimNum() const { return dimNum; }
+  uint64_t OutSize() const { return outSize; }
+  // 合并后的输出形状，MAX_DIM_NUM 个元素，dimNum 之后补 1。
+  const uint32_t* OutShape() const { return outShape; }
+  // 合并后输入 k 在各维上的元素步长，MAX_DIM_NUM 个元素，广播维与 dimNum 之后为 0。
+  const uint32_t* Strides(uint32_t k) const { return strides[k]; }
+  const uint32_t* InShape(uint32_t k) const { return inShape[k]; }
+
+  // 输入 k 与输出同形状（不需要广播，可按连续数据处理）。
+  bool IsFull(uint32_t k) const
+  {
+    for (uint32_t j = 0; j < dimNum; j++) {
+      if (inShape[k][j] != outShape[j]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // 输入 k 只有一个元素。
+  bool IsScalar(uint32_t k) const
+  {
+    for (uint32_t j = 0; j < dimNum; j++) {
+      if (inShape[k][j] != 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // 所有输入都与输出同形状。
+  bool AllFull() const
+  {
+    for (uint32_t k = 0; k < inputNum; k++) {
+      if (!IsFull(k)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  uint32_t inputNum;
+  uint32_t rawDimNum[MAX_INPUT_NUM];
+  int64_t rawDims[MAX_INPUT_NUM][MAX_INPUT_DIM_NUM];
+  uint32_t dimNum;
+  uint64_t outSize;
+  bool rejected;
+  uint32_t outShape[MAX_DIM_NUM];
+  uint32_t inShape[MAX_INPUT_NUM][MAX_DIM_NUM];
+  uint32_t strides[MAX_INPUT_NUM][MAX_DIM_NUM];
+};
+}
+
+#endif  // BROADCAST_PLANNER_H
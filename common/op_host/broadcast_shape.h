@@ -0,0 +1,116 @@
+#ifndef BROADCAST_SHAPE_H
+#define BROADCAST_SHAPE_H
+
+#include <cstdint>
+#include <string>
+
+namespace ge {
+// 多输入按 NumPy 规则推导广播后的输出形状，供各算子的 InferShape 共用。
+// 各输入右对齐，每一维的输出长度为各输入中不为 1 的长度，它们必须相等；
+// 动态 shape 下长度 -1（未知）不参与冲突检查：有确定的非 1 长度时取该长度，否则输出也为 -1；
+// 任一输入为未知维度数（-2）时输出同样为未知维度数。
+enum class BroadcastShapeStatus {
+  OK,
+  RANK_TOO_LARGE,   // 输出维度数超过 maxDimNum
+  INCOMPATIBLE,     // 同一维上出现两个不同的非 1 长度
+};
+
+const int64_t BROADCAST_UNKNOWN_DIM = -1;
+const int64_t BROADCAST_UNKNOWN_RANK = -2;
+
+// 推导失败的位置：RANK_TOO_LARGE 时为维度数最多的输入，INCOMPATIBLE 时为与前面的输入冲突的输入及其所在的输出维。
+struct BroadcastShapeError {
+  uint32_t input = 0;
+  uint32_t dim = 0;
+};
+
+// ShapeT 需提供 GetDimNum() / GetDim(i) / SetDimNum(n) / SetDim(i, v)，如 gert::Shape。
+// error 不为 nullptr 时，失败的位置写入 error。
+template <typename ShapeT>
+BroadcastShapeStatus InferBroadcastShape(const ShapeT* const* inputs, uint32_t inputNum, uint32_t maxDimNum,
+                                         ShapeT& out, BroadcastShapeError* error = nullptr)
+{
+  uint32_t widest = 0;
+  uint32_t outDimNum = 0;
+  for (uint32_t k = 0; k < inputNum; k++) {
+    const ShapeT& shape = *inputs[k];
+    if (shape.GetDimNum() == 1 && shape.GetDim(0) == BROADCAST_UNKNOWN_RANK) {
+      out.SetDimNum(1);
+      out.SetDim(0, BROADCAST_UNKNOWN_RANK);
+      return BroadcastShapeStatus::OK;
+    }
+    if (shape.GetDimNum() > outDimNum) {
+      outDimNum = static_cast<uint32_t>(shape.GetDimNum());
+      widest = k;
+    }
+  }
+  if (outDimNum > maxDimNum) {
+    if (error != nullptr) {
+      error->input = widest;
+      error->dim = outDimNum;
+    }
+    return BroadcastShapeStatus::RANK_TOO_LARGE;
+  }
+
+  out.SetDimNum(outDimNum);
+  for (uint32_t i = 0; i < outDimNum; i++) {
+    int64_t outDim = 1;
+    bool unknown = false;
+    for (uint32_t k = 0; k < inputNum; k++) {
+      const ShapeT& shape = *inputs[k];
+      uint32_t dimNum = static_cast<uint32_t>(shape.GetDimNum());
+      if (i + dimNum < outDimNum) {
+        continue;
+      }
+      int64_t dim = shape.GetDim(i + dimNum - outDimNum);
+      if (dim == BROADCAST_UNKNOWN_DIM) {
+        unknown = true;
+      } else if (dim != 1) {
+        if (outDim != 1 && dim != outDim) {
+          if (error != nullptr) {
+            error->input = k;
+            error->dim = i;
+          }
+          return BroadcastShapeStatus::INCOMPATIBLE;
+        }
+        outDim = dim;
+      }
+    }
+    // 未知长度只能是 1 或与确定的长度相等，两者都取确定的长度即可。
+    out.SetDim(i, (unknown && outDim == 1) ? BROADCAST_UNKNOWN_DIM : outDim);
+  }
+  return BroadcastShapeStatus::OK;
+}
+
+template <typename ShapeT>
+std::string FormatShape(const ShapeT& shape)
+{
+  std::string text = "[";
+  for (size_t i = 0; i < shape.GetDimNum(); i++) {
+    text += (i == 0 ? "" : ", ") + std::to_string(shape.GetDim(i));
+  }
+  return text + "]";
+}
+
+// InferBroadcastShape 失败时的说明：出错的输入（下标与名称）、原因与全部输入的形状。
+// names 与 inputs 一一对应；indexBase 为 inputs[0] 在算子输入中的下标。
+template <typename ShapeT>
+std::string BroadcastShapeMessage(const char* const* names, const ShapeT* const* inputs, uint32_t inputNum,
+                                  uint32_t indexBase, uint32_t maxDimNum, BroadcastShapeStatus status,
+                                  const BroadcastShapeError& error)
+{
+  std::string text = "input " + std::to_string(indexBase + error.input) + " (" + names[error.input] + ") ";
+  if (status == BroadcastShapeStatus::RANK_TOO_LARGE) {
+    text += "has " + std::to_string(error.dim) + " dims, more than " + std::to_string(maxDimNum);
+  } else {
+    text += "cannot be broadcast with the preceding inputs at output dim " + std::to_string(error.dim);
+  }
+  text += "; input shapes:";
+  for (uint32_t k = 0; k < inputNum; k++) {
+    text += std::string(k == 0 ? " " : ", ") + names[k] + " " + FormatShape(*inputs[k]);
+  }
+  return text;
+}
+}  // namespace ge
+
+#endif  // BROADCAST_SHAPE_H
@@ -0,0 +1,102 @@
+#ifndef ELEMENTWISE_TILING_H
+#define ELEMENTWISE_TILING_H
+
+#include <cstdint>
+
+namespace optiling {
+// 逐元素连续分支的核间切分，与 common/op_kernel/elementwise_pipeline.h 中 ElementwisePipeline::Init 对应。
+// 切分粒度 coreUnit 保证每个核的 GM 起始地址 32 字节对齐（如 ALIGN_NUM * 8 个元素，打包掩码为 256 个元素）：
+//   coreSize   每个核至少处理的元素数，是 coreUnit 的整数倍；
+//   coreRemain 均分后剩余的完整粒度个数，依次补给前 coreRemain 个核，每核多处理一个 coreUnit；
+//   coreTail   不足一个 coreUnit 的尾部元素，全部由最后一个核处理。
+// 每个核至少分到一个完整的切分粒度，元素不足一个 coreUnit 时只用一个核。
+struct ElementwiseSplit {
+  uint32_t coreNum;
+  uint32_t coreSize;
+  uint32_t coreRemain;
+  uint32_t coreTail;
+};
+
+inline ElementwiseSplit SplitElementwise(uint32_t totalLength, uint32_t coreNum, uint32_t coreUnit)
+{
+  ElementwiseSplit split;
+  uint32_t unitNum = totalLength / coreUnit;
+  split.coreNum = coreNum < unitNum ? coreNum : unitNum;
+  split.coreNum = split.coreNum >= 1 ? split.coreNum : 1;
+  split.coreSize = unitNum / split.coreNum * coreUnit;
+  split.coreRemain = unitNum % split.coreNum;
+  split.coreTail = totalLength - unitNum * coreUnit;
+  return split;
+}
+
+// 连续分支流水线的队列深度：2 为双缓冲，3 为三缓冲。三缓冲的 TilingKey 在双缓冲的基础上加 TILING_KEY_TRIPLE_BUFFER。
+const uint32_t PIPELINE_DEPTH_DOUBLE = 2;
+const uint32_t PIPELINE_DEPTH_TRIPLE = 3;
+const uint32_t TILING_KEY_TRIPLE_BUFFER = 100;
+const uint64_t MIN_DEEP_TILE_BYTES = 8192;   // 三缓冲时每个 Tile 的输出不小于 8 KB，避免搬运粒度过小
+
+// 按 UB 容量在 Tile 大小与队列深度之间取舍：更深的队列能让后续 Tile 的搬入与当前 Tile 的计算重叠，
+// 但同样的 UB 下每个 Tile 更小，搬运与指令的固定开销占比更高。
+// 三缓冲下 Tile 仍不小于 MIN_DEEP_TILE_BYTES、且每个核至少能分到 PIPELINE_DEPTH_TRIPLE 个 Tile（流水能填满）时选 3，否则选 2。
+// tileLengthOf(depth) 返回核函数在该深度下的 Tile 长度（0 表示放不下），coreLength 为单核处理的元素数。
+template <typename TileLengthFn>
+inline uint32_t ChoosePipelineDepth(uint32_t coreLength, uint32_t outBytes, TileLengthFn tileLengthOf, uint32_t& tileLength)
+{
+  uint32_t deepTile = tileLengthOf(PIPELINE_DEPTH_TRIPLE);
+  if (deepTile != 0 && static_cast<uint64_t>(deepTile) * outBytes >= MIN_DEEP_TILE_BYTES &&
+      coreLength >= static_cast<uint64_t>(deepTile) * PIPELINE_DEPTH_TRIPLE) {
+    tileLength = deepTile;
+    return PIPELINE_DEPTH_TRIPLE;
+  }
+  tileLength = tileLengthOf(PIPELINE_DEPTH_DOUBLE);
+  return PIPELINE_DEPTH_DOUBLE;
+}
+
+const uint32_t COPY_BLOCK_BYTES = 32;        // DataCopy 的对齐粒度
+const uint32_t MAX_COPY_BLOCK_COUNT = 4095;  // DataCopyPad 单次最多搬运的行数
+const uint32_t COMPARE_ALIGN = 128;         // SelectCompute 把 condition 转为 half 后 Compare，256 字节对应 128 个元素
+
+// 广播分支的行切分，与 common/op_kernel/kernel_split.h 中 BroadcastTiler 对应。输出看作 [rowNum, rowLength]：
+// 行较短时一个 Tile 处理 rowTile 整行（每行在 UB 中按 rowAlign 个元素补齐）；
+// 行较长时一个 Tile 只处理一行中的 colTile 个元素。tileNum 为 Tile 总数，核数不应超过它。
+struct BroadcastRowSplit {
+  uint32_t rowTile;
+  uint32_t colTile;
+  uint32_t tileNum;
+};
+
+inline BroadcastRowSplit SplitBroadcastRows(uint32_t totalLength, uint32_t rowLength, uint32_t rowAlign,
+                                            uint32_t tileLength)
+{
+  BroadcastRowSplit split;
+  uint32_t rowNum = totalLength / rowLength;
+  uint32_t rowPad = (rowLength + rowAlign - 1) / rowAlign * rowAlign;
+  if (rowPad <= tileLength) {
+    split.rowTile = tileLength / rowPad < MAX_COPY_BLOCK_COUNT ? tileLength / rowPad : MAX_COPY_BLOCK_COUNT;
+    split.colTile = rowLength;
+  } else {
+    split.rowTile = 1;
+    split.colTile = tileLength;
+  }
+  split.tileNum = (rowNum + split.rowTile - 1) / split.rowTile * ((rowLength + split.colTile - 1) / split.colTile);
+  return split;
+}
+
+// Tile 按核均分时使用的核数：不超过 Tile 数，至少为 1。
+inline uint32_t BroadcastCoreNum(uint32_t coreNum, const BroadcastRowSplit& split)
+{
+  uint32_t used = coreNum < split.tileNum ? coreNum : split.tileNum;
+  return used >= 1 ? used : 1;
+}
+
+// 写入 TilingData 中同名的 core_size / core_remain / core_tail 字段。
+template <typename TilingDataT>
+inline void SetElementwiseSplit(TilingDataT& tiling, const ElementwiseSplit& split)
+{
+  tiling.set_core_size(split.coreSize);
+  tiling.set_core_remain(split.coreRemain);
+  tiling.set_core_tail(split.coreTail);
+}
+}
+
+#endif  // ELEMENTWISE_TILING_H
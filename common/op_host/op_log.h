@@ -0,0 +1,10 @@
+#ifndef OP_LOG_H
+#define OP_LOG_H
+
+#include <cstdio>
+
+// InferShape / InferDataType / TilingFunc 失败时的错误日志，格式为 "[ERROR] <算子名>: <信息>"。
+// 自定义算子包不链接 CANN 的日志库，这里直接写 stderr，由调用框架的进程日志收集。
+#define OP_HOST_LOGE(opName, fmt, ...) std::fprintf(stderr, "[ERROR] %s: " fmt "\n", (opName), ##__VA_ARGS__)
+
+#endif  // OP_LOG_H
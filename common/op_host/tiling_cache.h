@@ -0,0 +1,192 @@
+#ifndef TILING_CACHE_H
+#define TILING_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace optiling {
+// 缓存的键：依次追加输入形状、dtype、属性、SoC、核数、UB 大小等所有影响切分结果的量。
+// 定长数组存放，构造过程不分配内存；追加时按字同步计算哈希。超过容量的签名标记为无效，不走缓存。
+class TilingSignature {
+public:
+  static const size_t MAX_WORDS = 64;
+
+  TilingSignature() : count(0), hash(HASH_OFFSET), valid(true) {}
+
+  TilingSignature& Append(int64_t value)
+  {
+    if (count == MAX_WORDS) {
+      valid = false;
+      return *this;
+    }
+    words[count++] = value;
+    hash = (hash ^ static_cast<uint64_t>(value)) * HASH_PRIME;
+    hash ^= hash >> 29;
+    return *this;
+  }
+
+  // ShapeT 需提供 GetDimNum() / GetDim(i)，如 gert::Shape。
+  template <typename ShapeT>
+  TilingSignature& AppendShape(const ShapeT& shape)
+  {
+    Append(static_cast<int64_t>(shape.GetDimNum()));
+    for (size_t i = 0; i < shape.GetDimNum(); i++) {
+      Append(static_cast<int64_t>(shape.GetDim(i)));
+    }
+    return *this;
+  }
+
+  bool Valid() const { return valid; }
+  uint64_t Hash() const { return hash; }
+  size_t Size() const { return count; }
+  const int64_t* Words() const { return words; }
+
+private:
+  static const uint64_t HASH_OFFSET = 0xcbf29ce484222325ULL;
+  static const uint64_t HASH_PRIME = 0x9e3779b97f4a7c15ULL;
+
+  int64_t words[MAX_WORDS];
+  size_t count;
+  uint64_t hash;
+  bool valid;
+};
+
+// TilingFunc 的结果：序列化后的 TilingData 与 TilingKey、核数、workspace 大小。
+struct TilingPlan {
+  std::vector<uint8_t> data;
+  uint64_t tilingKey = 0;
+  uint32_t blockDim = 0;
+  uint64_t workspaceSize = 0;
+};
+
+// 从 TilingContext 中取出 TilingFunc 已经写入的结果。
+template <typename ContextT>
+bool CaptureTilingPlan(ContextT* context, TilingPlan& plan)
+{
+  auto rawTilingData = context->GetRawTilingData();
+  const size_t* workspaceSizes = context->GetWorkspaceSizes(1);
+  if (rawTilingData == nullptr || workspaceSizes == nullptr) {
+    return false;
+  }
+  const uint8_t* data = static_cast<const uint8_t*>(rawTilingData->GetData());
+  plan.data.assign(data, data + rawTilingData->GetDataSize());
+  plan.tilingKey = context->GetTilingKey();
+  plan.blockDim = context->GetBlockDim();
+  plan.workspaceSize = workspaceSizes[0];
+  return true;
+}
+
+// 把缓存的结果写回 TilingContext，等价于重新执行一次 TilingFunc。
+template <typename ContextT>
+bool ApplyTilingPlan(ContextT* context, const TilingPlan& plan)
+{
+  auto rawTilingData = context->GetRawTilingData();
+  size_t* workspaceSizes = context->GetWorkspaceSizes(1);
+  if (rawTilingData == nullptr || workspaceSizes == nullptr || rawTilingData->GetCapacity() < plan.data.size()) {
+    return false;
+  }
+  std::memcpy(rawTilingData->GetData(), plan.data.data(), plan.data.size());
+  rawTilingData->SetDataSize(plan.data.size());
+  context->SetTilingKey(plan.tilingKey);
+  context->SetBlockDim(plan.blockDim);
+  workspaceSizes[0] = plan.workspaceSize;
+  return true;
+}
+
+// 有界 LRU 缓存，多线程并发调用 TilingFunc 时由互斥锁保护。
+// 按签名哈希索引，命中时再逐字比较签名；哈希冲突按未命中处理并覆盖旧条目。
+class TilingPlanCache {
+public:
+  explicit TilingPlanCache(size_t capacity) : capacity(capacity), hits(0), misses(0) {}
+
+  // 命中时直接把缓存的结果写入 context，返回 true。
+  template <typename ContextT>
+  bool LookupAndApply(const TilingSignature& signature, ContextT* context)
+  {
+    if (signature.Valid()) {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = index.find(signature.Hash());
+      if (it != index.end() && SameKey(it->second->key, signature)) {
+        entries.splice(entries.begin(), entries, it->second);
+        if (ApplyTilingPlan(context, it->second->plan)) {
+          hits.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+      }
+    }
+    misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  void Insert(const TilingSignature& signature, const TilingPlan& plan)
+  {
+    if (capacity == 0 || !signature.Valid()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(signature.Hash());
+    if (it != index.end()) {
+      it->second->key.assign(signature.Words(), signature.Words() + signature.Size());
+      it->second->plan = plan;
+      entries.splice(entries.begin(), entries, it->second);
+      return;
+    }
+    if (entries.size() >= capacity) {
+      index.erase(entries.back().hash);
+      entries.pop_back();
+    }
+    entries.push_front(Entry());
+    Entry& entry = entries.front();
+    entry.hash = signature.Hash();
+    entry.key.assign(signature.Words(), signature.Words() + signature.Size());
+    entry.plan = plan;
+    index[entry.hash] = entries.begin();
+  }
+
+  void Clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+    hits.store(0, std::memory_order_relaxed);
+    misses.store(0, std::memory_order_relaxed);
+  }
+
+  uint64_t Hits() const { return hits.load(std::memory_order_relaxed); }
+  uint64_t Misses() const { return misses.load(std::memory_order_relaxed); }
+
+  size_t Size()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+  }
+
+private:
+  struct Entry {
+    uint64_t hash;
+    std::vector<int64_t> key;
+    TilingPlan plan;
+  };
+  typedef std::list<Entry> EntryList;
+
+  static bool SameKey(const std::vector<int64_t>& key, const TilingSignature& signature)
+  {
+    return key.size() == signature.Size() &&
+           std::memcmp(key.data(), signature.Words(), key.size() * sizeof(int64_t)) == 0;
+  }
+
+  size_t capacity;
+  std::mutex mutex;
+  EntryList entries;
+  std::unordered_map<uint64_t, EntryList::iterator> index;
+  std::atomic<uint64_t> hits;
+  std::atomic<uint64_t> misses;
+};
+}
+
+#endif  // TILING_CACHE_H
@@ -0,0 +1,116 @@
+#ifndef TUNED_TILING_H
+#define TUNED_TILING_H
+
+#include <cstdint>
+#include "broadcast_planner.h"
+#include "elementwise_tiling.h"
+
+namespace optiling {
+// 离线调优的切分表：tools/tiling_autotune 按 (算子, 元素宽度, TilingKey, 广播方式, 规模档位, 平台) 扫描
+// Tile 长度、核数与队列深度，把优于公式的方案写入 tuned_tiling_table.h。
+// 各算子的 Plan*Tiling 先查表，命中时按表项覆盖公式的结果，未命中（或平台的 UB 大小、核数不同）时按公式计算。
+// 表项中的 0 表示该项沿用公式。
+
+const uint8_t TUNE_OP_POWS = 1;
+const uint8_t TUNE_OP_SELECT_V2 = 2;
+const uint8_t TUNE_OP_POWS_SELECT = 3;
+
+// 广播方式：按第一个既不与输出同形状、也不是标量的输入的最内维区分行广播与列广播。
+const uint8_t TUNE_CLASS_FULL = 0;     // 所有输入与输出同形状
+const uint8_t TUNE_CLASS_SCALAR = 1;   // 只有标量输入需要广播
+const uint8_t TUNE_CLASS_ROW = 2;      // 广播输入的最内维连续，如 [1, C]
+const uint8_t TUNE_CLASS_COL = 3;      // 广播输入的最内维被广播，如 [R, 1]
+
+// 规模档位：4K 个元素以下为 0，之后每 4 倍一档，16M 及以上为 TUNE_SIZE_BUCKET_NUM - 1。
+const uint32_t TUNE_SIZE_BUCKET_NUM = 8;
+const uint32_t TUNE_SIZE_BUCKET_MIN_LOG2 = 12;
+
+struct TunedTiling {
+  uint8_t op;              // TUNE_OP_*，0 为表尾
+  uint8_t elemBytes;       // 元素宽度
+  uint16_t baseKey;        // 不含 TILING_KEY_TRIPLE_BUFFER 的 TilingKey
+  uint8_t bcastClass;      // TUNE_CLASS_*
+  uint8_t sizeBucket;      // TuneSizeBucket
+  uint32_t platformCores;  // 调优时平台的核数
+  uint64_t ubSize;         // 调优时平台的 UB 字节数
+  uint32_t tileLength;     // Tile 长度上限（元素个数），0 为 UB 能容纳的最大长度
+  uint32_t coreNum;        // 使用的核数上限，0 为不限
+  uint32_t depth;          // 连续分支的队列深度，0 为按 ChoosePipelineDepth 选择
+};
+}
+
+#include "tuned_tiling_table.h"
+
+namespace optiling {
+inline uint8_t TuneSizeBucket(uint64_t totalLength)
+{
+  uint32_t bucket = 0;
+  uint64_t bound = 1ULL << TUNE_SIZE_BUCKET_MIN_LOG2;
+  while (bucket + 1 < TUNE_SIZE_BUCKET_NUM && totalLength >= bound) {
+    bucket++;
+    bound <<= 2;
+  }
+  return static_cast<uint8_t>(bucket);
+}
+
+inline uint8_t TuneClassOf(const BroadcastPlanner& planner, uint32_t inputNum)
+{
+  uint8_t bcastClass = TUNE_CLASS_FULL;
+  for (uint32_t k = 0; k < inputNum; k++) {
+    if (planner.IsFull(k)) {
+      continue;
+    }
+    if (!planner.IsScalar(k)) {
+      return planner.Strides(k)[planner.DimNum() - 1] == 0 ? TUNE_CLASS_COL : TUNE_CLASS_ROW;
+    }
+    bcastClass = TUNE_CLASS_SCALAR;
+  }
+  return bcastClass;
+}
+
+// 按顺序查找第一个匹配的表项，未命中返回 nullptr。表很小，且 TilingFunc 的结果由 TilingPlanCache 缓存。
+inline const TunedTiling* FindTunedTiling(uint8_t op, uint32_t elemBytes, uint32_t baseKey, uint8_t bcastClass,
+                                          uint64_t totalLength, uint64_t ubSize, uint32_t coreNum)
+{
+  uint8_t bucket = TuneSizeBucket(totalLength);
+  for (const TunedTiling* entry = TUNED_TILING_TABLE; entry->op != 0; entry++) {
+    if (entry->op == op && entry->elemBytes == elemBytes && entry->baseKey == baseKey &&
+        entry->bcastClass == bcastClass && entry->sizeBucket == bucket && entry->ubSize == ubSize &&
+        entry->platformCores == coreNum) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+// 表项的 Tile 长度不超过当前深度下 UB 能容纳的 maxTile，并向下对齐到 align；不足一个 align 时取 align。
+inline uint32_t TunedTileLength(const TunedTiling& tuned, uint32_t maxTile, uint32_t align)
+{
+  if (tuned.tileLength == 0 || tuned.tileLength >= maxTile) {
+    return maxTile;
+  }
+  uint32_t tile = tuned.tileLength / align * align;
+  return tile >= align ? tile : align;
+}
+
+inline uint32_t TunedCoreNum(const TunedTiling& tuned, uint32_t coreNum)
+{
+  return (tuned.coreNum != 0 && tuned.coreNum < coreNum) ? tuned.coreNum : coreNum;
+}
+
+// 连续分支的队列深度：表项指定且该深度下 UB 放得下时采用，否则按 ChoosePipelineDepth 选择。
+template <typename TileLengthFn>
+inline uint32_t TunedPipelineDepth(const TunedTiling& tuned, uint32_t coreLength, uint32_t outBytes,
+                                   TileLengthFn tileLengthOf, uint32_t& tileLength)
+{
+  if (tuned.depth == PIPELINE_DEPTH_DOUBLE || tuned.depth == PIPELINE_DEPTH_TRIPLE) {
+    tileLength = tileLengthOf(tuned.depth);
+    if (tileLength != 0) {
+      return tuned.depth;
+    }
+  }
+  return ChoosePipelineDepth(coreLength, outBytes, tileLengthOf, tileLength);
+}
+}
+
+#endif  // TUNED_TILING_H
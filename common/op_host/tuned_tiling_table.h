@@ -0,0 +1,39 @@
+// 由 tools/tiling_autotune 生成，请勿手工修改。
+//   tiling_autotune --output common/op_host/tuned_tiling_table.h
+// 代价模型：gm_bw=800 core_bw=64 copy_latency=600 tile_overhead=200（字节 / 周期、周期）
+#ifndef TUNED_TILING_TABLE_H
+#define TUNED_TILING_TABLE_H
+
+namespace optiling {
+const TunedTiling TUNED_TILING_TABLE[] = {
+  // op, elemBytes, baseKey, bcastClass, sizeBucket, platformCores, ubSize, tileLength, coreNum, depth
+  {1, 2, 1, 0, 4, 1, 262144, 0, 0, 2},   // pows, 3.1%
+  {1, 2, 1, 0, 5, 1, 262144, 0, 0, 2},   // pows, 3.9%
+  {1, 2, 1, 0, 6, 1, 262144, 0, 0, 2},   // pows, 4.1%
+  {1, 2, 1, 0, 7, 1, 262144, 0, 0, 2},   // pows, 4.1%
+  {1, 2, 3, 1, 4, 1, 262144, 0, 0, 2},   // pows, 2.5%
+  {1, 2, 3, 1, 5, 1, 262144, 0, 0, 2},   // pows, 2.9%
+  {1, 2, 3, 1, 6, 1, 262144, 0, 0, 2},   // pows, 3.1%
+  {1, 2, 3, 1, 7, 1, 262144, 0, 0, 2},   // pows, 3.2%
+  {1, 4, 11, 0, 3, 1, 262144, 0, 0, 2},   // pows, 2.0%
+  {1, 4, 11, 0, 4, 1, 262144, 0, 0, 2},   // pows, 3.1%
+  {1, 4, 11, 0, 5, 1, 262144, 0, 0, 2},   // pows, 3.3%
+  {1, 4, 11, 0, 6, 1, 262144, 0, 0, 2},   // pows, 3.4%
+  {1, 4, 11, 0, 7, 1, 262144, 0, 0, 2},   // pows, 3.4%
+  {1, 4, 13, 1, 5, 1, 262144, 0, 0, 2},   // pows, 2.2%
+  {1, 4, 13, 1, 6, 1, 262144, 0, 0, 2},   // pows, 2.3%
+  {1, 4, 13, 1, 7, 1, 262144, 0, 0, 2},   // pows, 2.3%
+  {2, 1, 5, 1, 2, 1, 262144, 0, 0, 3},   // select_v2, 2.9%
+  {2, 2, 1, 0, 2, 1, 262144, 0, 0, 3},   // select_v2, 3.3%
+  {3, 2, 1, 0, 1, 1, 262144, 4608, 0, 3},   // pows_select, 2.8%
+  {3, 4, 11, 0, 1, 1, 262144, 0, 0, 3},   // pows_select, 2.3%
+  {3, 4, 11, 0, 3, 1, 262144, 0, 0, 2},   // pows_select, 3.4%
+  {3, 4, 11, 0, 4, 1, 262144, 0, 0, 2},   // pows_select, 3.8%
+  {3, 4, 11, 0, 5, 1, 262144, 0, 0, 2},   // pows_select, 3.8%
+  {3, 4, 11, 0, 6, 1, 262144, 0, 0, 2},   // pows_select, 4.0%
+  {3, 4, 11, 0, 7, 1, 262144, 0, 0, 2},   // pows_select, 4.0%
+  {0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+};
+}
+
+#endif  // TUNED_TILING_TABLE_H
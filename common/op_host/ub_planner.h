@@ -0,0 +1,80 @@
+#ifndef UB_PLANNER_H
+#define UB_PLANNER_H
+
+#include <cstdint>
+
+namespace optiling {
+// 按核函数实际申请的 Buffer 计算 UB 能容纳的最大 Tile 长度（元素个数）。
+// 每个 TQue 按 depth 块计入，每个 TBuf 按 1 块计入，按位存放的掩码每个元素占 1 bit。
+// Buffer 起始地址按 32 字节对齐，每块最多浪费 32 字节，一并预留。
+// Host 侧的声明需要与核函数 Init 中的 InitBuffer 保持一致。
+class UbPlanner {
+public:
+  static const uint32_t UB_ALIGN = 32;
+
+  UbPlanner() : bitsPerElem(0), fixedBytes(0) {}
+
+  // 输入/输出队列：每个元素 bytes 字节，共 depth 块。
+  UbPlanner& Queue(uint32_t bytes, uint32_t depth)
+  {
+    bitsPerElem += static_cast<uint64_t>(bytes) * 8 * depth;
+    fixedBytes += static_cast<uint64_t>(UB_ALIGN) * depth;
+    return *this;
+  }
+
+  // 临时 Buffer（TBuf）：每个元素 bytes 字节。
+  UbPlanner& Buffer(uint32_t bytes, uint32_t num = 1)
+  {
+    bitsPerElem += static_cast<uint64_t>(bytes) * 8 * num;
+    fixedBytes += static_cast<uint64_t>(UB_ALIGN) * num;
+    return *this;
+  }
+
+  // 按位存放的掩码 Buffer（Compare 的输出），每个元素 1 bit。
+  UbPlanner& BitMask(uint32_t num = 1)
+  {
+    bitsPerElem += num;
+    fixedBytes += static_cast<uint64_t>(UB_ALIGN) * num;
+    return *this;
+  }
+
+  // 按位存放的输入/输出队列（如打包后的 condition），每个元素 1 bit，共 depth 块。
+  UbPlanner& BitQueue(uint32_t depth)
+  {
+    bitsPerElem += depth;
+    fixedBytes += static_cast<uint64_t>(UB_ALIGN) * depth;
+    return *this;
+  }
+
+  // 与 Tile 长度无关的固定大小 Buffer。
+  UbPlanner& Reserve(uint64_t bytes)
+  {
+    fixedBytes += (bytes + UB_ALIGN - 1) / UB_ALIGN * UB_ALIGN;
+    return *this;
+  }
+
+  // 能放下所有 Buffer 的最大 Tile 长度，向下取整到 align 个元素的整数倍；放不下一个 align 时返回 0。
+  uint32_t TileLength(uint64_t ubSize, uint32_t align) const
+  {
+    if (bitsPerElem == 0 || align == 0 || ubSize <= fixedBytes) {
+      return 0;
+    }
+    uint64_t tile = (ubSize - fixedBytes) * 8 / bitsPerElem;
+    tile = tile / align * align;
+    const uint64_t maxTile = 0xFFFFFFFFULL / align * align;
+    return static_cast<uint32_t>(tile < maxTile ? tile : maxTile);
+  }
+
+  // 给定 Tile 长度时实际占用的 UB 字节数上界。
+  uint64_t UsedBytes(uint32_t tileLength) const
+  {
+    return (bitsPerElem * tileLength + 7) / 8 + fixedBytes;
+  }
+
+private:
+  uint64_t bitsPerElem;
+  uint64_t fixedBytes;
+};
+}
+
+#endif  // UB_PLANNER_H
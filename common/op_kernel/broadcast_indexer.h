@@ -0,0 +1,89 @@
+#ifndef BROADCAST_INDEXER_H
+#define BROADCAST_INDEXER_H
+
+// 定义 BROADCAST_INDEXER_HOST_SIM 时可在 Host 上编译，供 tools/broadcast_index_bench 做 CPU 仿真对比。
+#ifdef BROADCAST_INDEXER_HOST_SIM
+#include <cstdint>
+#ifndef __aicore__
+#define __aicore__
+#endif
+#else
+#include "kernel_operator.h"
+#endif
+
+constexpr int32_t BROADCAST_INDEXER_MAX_DIM = 8;   // 与 TilingFunc 中合并后形状的最大维度数一致
+
+// 广播下标的多维计数器（里程表）：按输出的连续顺序逐个前进，同时维护 INPUT_NUM 个输入的偏移。
+// 只有 Seek 需要除法（每核或每个 Tile 一次），Next 只做加减：最内维加一，满了向外层进位，
+// 各输入偏移按该维步长增加，进位时减去该维一整圈的跨度。
+template<int32_t INPUT_NUM>
+class BroadcastIndexer {
+public:
+    __aicore__ inline BroadcastIndexer() {}
+
+    // shape 为参与计数的各维长度（外层在前），dimNum 可以为 0，此时所有偏移恒为 0。
+    __aicore__ inline void Init(uint32_t dimNum, const uint64_t* shape)
+    {
+        this->dimNum = static_cast<int32_t>(dimNum);
+        for (int32_t j = 0; j < this->dimNum; j++) {
+            this->shape[j] = shape[j];
+        }
+    }
+
+    // 第 k 个输入在各维上的步长（广播维为 0），需在 Init 之后调用。
+    __aicore__ inline void SetStrides(int32_t k, const uint64_t* strides)
+    {
+        for (int32_t j = 0; j < this->dimNum; j++) {
+            this->stride[k][j] = strides[j];
+            this->wrap[k][j] = strides[j] * this->shape[j];
+        }
+    }
+
+    // 定位到输出的第 linear 个位置。
+    __aicore__ inline void Seek(uint64_t linear)
+    {
+        for (int32_t k = 0; k < INPUT_NUM; k++) {
+            this->offset[k] = 0;
+        }
+        for (int32_t j = this->dimNum - 1; j >= 0; j--) {
+            uint64_t next = linear / this->shape[j];
+            this->index[j] = linear - next * this->shape[j];
+            linear = next;
+            for (int32_t k = 0; k < INPUT_NUM; k++) {
+                this->offset[k] += this->index[j] * this->stride[k][j];
+            }
+        }
+    }
+
+    // 前进到输出的下一个位置。
+    __aicore__ inline void Next()
+    {
+        for (int32_t j = this->dimNum - 1; j >= 0; j--) {
+            for (int32_t k = 0; k < INPUT_NUM; k++) {
+                this->offset[k] += this->stride[k][j];
+            }
+            if (++this->index[j] < this->shape[j]) {
+                return;
+            }
+            this->index[j] = 0;
+            for (int32_t k = 0; k < INPUT_NUM; k++) {
+                this->offset[k] -= this->wrap[k][j];
+            }
+        }
+    }
+
+    __aicore__ inline uint64_t Offset(int32_t k) const
+    {
+        return this->offset[k];
+    }
+
+private:
+    int32_t dimNum = 0;
+    uint64_t shape[BROADCAST_INDEXER_MAX_DIM];
+    uint64_t index[BROADCAST_INDEXER_MAX_DIM];
+    uint64_t stride[INPUT_NUM][BROADCAST_INDEXER_MAX_DIM];
+    uint64_t wrap[INPUT_NUM][BROADCAST_INDEXER_MAX_DIM];    // 该维走满一圈的跨度 stride * shape
+    uint64_t offset[INPUT_NUM] = {};
+};
+
+#endif  // BROADCAST_INDEXER_H
@@ -0,0 +1,91 @@
+#ifndef BROADCAST_TILE_H
+#define BROADCAST_TILE_H
+
+#include "kernel_operator.h"
+#include "copy_utils.h"
+#include "kernel_split.h"
+
+// 广播分支的搬运：BroadcastTile / BroadcastTiler 见 kernel_split.h。
+
+// 把标量 value 按位填充到 dst 的前 count 个元素。按同宽度的无符号整数搬运，bf16 等类型也能直接使用；
+// 1 字节类型两两拼成 uint16 填充，count 为奇数时会多写一个元素；
+// 8 字节类型没有对应的 Duplicate，按 uint32 用隔位掩码分别填充低、高 32 位，按整个 repeat（32 个元素）写入。
+// 多写的部分落在补齐空间内，调用方需保证 UB 中有补齐空间。
+template<typename T>
+__aicore__ inline void DuplicateValue(const AscendC::LocalTensor<T>& dst, T value, uint32_t count)
+{
+    if constexpr (sizeof(T) == sizeof(uint64_t)) {
+        constexpr uint32_t LANES = 256 / sizeof(uint32_t);   // 一次 repeat 处理 64 个 uint32
+        constexpr uint32_t MAX_REPEAT = 255;
+        uint64_t bits = *reinterpret_cast<uint64_t*>(&value);
+        uint64_t lowMask[2] = {0x5555555555555555ULL, 0};
+        uint64_t highMask[2] = {0xAAAAAAAAAAAAAAAAULL, 0};
+        auto dst32 = dst.template ReinterpretCast<uint32_t>();
+        uint32_t repeat = (count * 2 + LANES - 1) / LANES;
+        for (uint32_t done = 0; done < repeat; done += MAX_REPEAT) {
+            uint8_t times = static_cast<uint8_t>(repeat - done < MAX_REPEAT ? repeat - done : MAX_REPEAT);
+            AscendC::Duplicate(dst32[done * LANES], static_cast<uint32_t>(bits), lowMask, times, 1, 8);
+            AscendC::Duplicate(dst32[done * LANES], static_cast<uint32_t>(bits >> 32), highMask, times, 1, 8);
+        }
+    } else if constexpr (sizeof(T) == sizeof(uint8_t)) {
+        uint16_t byte = *reinterpret_cast<uint8_t*>(&value);
+        AscendC::Duplicate(dst.template ReinterpretCast<uint16_t>(), static_cast<uint16_t>(byte | (byte << 8)),
+                           (count + 1) / 2);
+    } else if constexpr (sizeof(T) == sizeof(uint16_t)) {
+        uint16_t bits = *reinterpret_cast<uint16_t*>(&value);
+        AscendC::Duplicate(dst.template ReinterpretCast<uint16_t>(), bits, count);
+    } else {
+        uint32_t bits = *reinterpret_cast<uint32_t*>(&value);
+        AscendC::Duplicate(dst.template ReinterpretCast<uint32_t>(), bits, count);
+    }
+}
+
+// UB 中相邻两行之间空出的 32 字节块数：一行有效数据按 32 字节补齐后，距 colPad 还差的部分。
+template<typename T>
+__aicore__ inline uint32_t RowGapBlocks(const BroadcastTile& tile)
+{
+    return (tile.colPad * sizeof(T) - AlignUp(tile.cols * sizeof(T), COPY_ALIGN_BYTES)) / COPY_ALIGN_BYTES;
+}
+
+// 与输出同形状的输入：Tile 内各行在 GM 中等间隔排布，一次搬入。
+// 读取的区间与 CopyOutTile 写回的区间完全相同，因此这样的输入可以与输出共用同一块 GM（原地执行）；
+// 广播输入的元素会被多个 Tile 重复读取，不能与输出共用。
+template<typename T>
+__aicore__ inline void CopyInTile(const AscendC::LocalTensor<T>& local, const AscendC::GlobalTensor<T>& gm,
+                                  uint32_t rowLength, const BroadcastTile& tile)
+{
+    AscendC::DataCopyExtParams copyParams{static_cast<uint16_t>(tile.rows),
+        static_cast<uint32_t>(tile.cols * sizeof(T)),
+        static_cast<uint32_t>((rowLength - tile.cols) * sizeof(T)), RowGapBlocks<T>(tile), 0};
+    AscendC::DataCopyPadExtParams<T> padParams{false, 0, 0, 0};
+    AscendC::DataCopyPad(local, gm[static_cast<uint64_t>(tile.rowStart) * rowLength + tile.colStart],
+                         copyParams, padParams);
+}
+
+// 广播输入的一行：offset 为该行在输入中的起始偏移，innerStride 为该输入最内维的步长。
+template<typename T>
+__aicore__ inline void CopyInRow(const AscendC::LocalTensor<T>& local, const AscendC::GlobalTensor<T>& gm,
+                                 uint64_t offset, uint64_t innerStride, const BroadcastTile& tile)
+{
+    if (innerStride == 0) {
+        // 最内维被广播：整行都是同一个值。
+        DuplicateValue(local, gm.GetValue(offset), tile.cols);
+        return;
+    }
+    AscendC::DataCopyExtParams copyParams{1, static_cast<uint32_t>(tile.cols * sizeof(T)), 0, 0, 0};
+    AscendC::DataCopyPadExtParams<T> padParams{false, 0, 0, 0};
+    AscendC::DataCopyPad(local, gm[offset + tile.colStart], copyParams, padParams);
+}
+
+// 一个 Tile 的输出写回 GM，只写有效的 cols 个元素，各核写的区间互不重叠。
+template<typename T>
+__aicore__ inline void CopyOutTile(const AscendC::GlobalTensor<T>& gm, const AscendC::LocalTensor<T>& local,
+                                   uint32_t rowLength, const BroadcastTile& tile)
+{
+    AscendC::DataCopyExtParams copyParams{static_cast<uint16_t>(tile.rows),
+        static_cast<uint32_t>(tile.cols * sizeof(T)), RowGapBlocks<T>(tile),
+        static_cast<uint32_t>((rowLength - tile.cols) * sizeof(T)), 0};
+    AscendC::DataCopyPad(gm[static_cast<uint64_t>(tile.rowStart) * rowLength + tile.colStart], local, copyParams);
+}
+
+#endif  // BROADCAST_TILE_H
@@ -0,0 +1,40 @@
+#ifndef COPY_UTILS_H
+#define COPY_UTILS_H
+
+#include "kernel_operator.h"
+
+constexpr uint32_t COPY_ALIGN_BYTES = 32;   // DataCopy 要求搬运长度 32 字节对齐
+
+// 把 length 向上对齐到 align 的整数倍。
+__aicore__ inline uint32_t AlignUp(uint32_t length, uint32_t align)
+{
+    return (length + align - 1) / align * align;
+}
+
+// GM -> UB 搬入恰好 length 个元素：长度 32 字节对齐时用 DataCopy，否则用 DataCopyPad，不会读到 GM 上 length 之后的数据。
+// DataCopyPad 时 UB 中补齐到 32 字节的部分数据无效，参与计算不影响有效结果。
+template<typename T>
+__aicore__ inline void CopyInExact(const AscendC::LocalTensor<T>& dst, const AscendC::GlobalTensor<T>& src, uint32_t length)
+{
+    if (length * sizeof(T) % COPY_ALIGN_BYTES == 0) {
+        AscendC::DataCopy(dst, src, length);
+        return;
+    }
+    AscendC::DataCopyExtParams copyParams{1, static_cast<uint32_t>(length * sizeof(T)), 0, 0, 0};
+    AscendC::DataCopyPadExtParams<T> padParams{false, 0, 0, 0};
+    AscendC::DataCopyPad(dst, src, copyParams, padParams);
+}
+
+// UB -> GM 搬出恰好 length 个元素，不会写到 GM 上 length 之后的数据。
+template<typename T>
+__aicore__ inline void CopyOutExact(const AscendC::GlobalTensor<T>& dst, const AscendC::LocalTensor<T>& src, uint32_t length)
+{
+    if (length * sizeof(T) % COPY_ALIGN_BYTES == 0) {
+        AscendC::DataCopy(dst, src, length);
+        return;
+    }
+    AscendC::DataCopyExtParams copyParams{1, static_cast<uint32_t>(length * sizeof(T)), 0, 0, 0};
+    AscendC::DataCopyPad(dst, src, copyParams);
+}
+
+#endif  // COPY_UTILS_H
@@ -0,0 +1,196 @@
+#ifndef ELEMENTWISE_PIPELINE_H
+#define ELEMENTWISE_PIPELINE_H
+
+#include "kernel_operator.h"
+#include "op_profiler.h"
+#include "copy_utils.h"
+#include "kernel_split.h"
+
+// 逐元素算子连续分支的公共流水线：核间切分、Tile 循环、尾块处理、输入输出队列与性能打点集中在这里，
+// 各算子只提供计算类 COMPUTE，需实现：
+//   Init(pipe, tileLength)                                    申请计算用的临时 Buffer；
+//   Compute(yLocal, x0Local, x1Local, ..., length)            按 TYPE_X 的顺序接收各输入的 Tensor。
+// 只有一个元素的标量输入不进入流水线，由算子在 Init 之后读取并交给计算类（见 Computer()）。
+
+// 按位打包的输入（如 PackCondition 输出的 condition），每个元素 1 bit，按 uint8 搬运。
+struct PackedBits {};
+
+// 输入在 GM / UB 中的存储类型，Units(count) 为 count 个元素占用的 Type 个数。
+template<typename T>
+struct PipelineElement {
+    using Type = T;
+    __aicore__ static inline uint32_t Units(uint32_t count)
+    {
+        return count;
+    }
+};
+
+template<>
+struct PipelineElement<PackedBits> {
+    using Type = uint8_t;
+    __aicore__ static inline uint32_t Units(uint32_t count)
+    {
+        return (count + 7) / 8;
+    }
+};
+
+// 各输入的队列与 GlobalTensor，按 TYPE_X 的顺序递归展开。
+template<int32_t DEPTH, typename... TYPE_X>
+struct PipelineInputs {
+    __aicore__ inline void Init(AscendC::TPipe& pipe, const GM_ADDR* inputs, uint32_t blockOffset, uint32_t blockLength,
+                                uint32_t tileLength) {}
+    __aicore__ inline void CopyIn(uint32_t offset, uint32_t length) {}
+    __aicore__ inline uint64_t Bytes(uint32_t length) const
+    {
+        return 0;
+    }
+
+    // 所有输入都已 DeQue，按顺序交给计算类。
+    template<typename COMPUTE, typename TYPE_Y, typename... LOCALS>
+    __aicore__ inline void Compute(COMPUTE& computer, const AscendC::LocalTensor<TYPE_Y>& yLocal, uint32_t length,
+                                   const LOCALS&... locals)
+    {
+        computer.Compute(yLocal, locals..., length);
+    }
+};
+
+template<int32_t DEPTH, typename HEAD, typename... REST>
+struct PipelineInputs<DEPTH, HEAD, REST...> {
+    using T = typename PipelineElement<HEAD>::Type;
+
+    __aicore__ inline void Init(AscendC::TPipe& pipe, const GM_ADDR* inputs, uint32_t blockOffset, uint32_t blockLength,
+                                uint32_t tileLength)
+    {
+        gm.SetGlobalBuffer((__gm__ T*)inputs[0] + PipelineElement<HEAD>::Units(blockOffset),
+                           PipelineElement<HEAD>::Units(blockLength));
+        pipe.InitBuffer(queue, DEPTH, PipelineElement<HEAD>::Units(tileLength) * sizeof(T));
+        rest.Init(pipe, inputs + 1, blockOffset, blockLength, tileLength);
+    }
+
+    __aicore__ inline void CopyIn(uint32_t offset, uint32_t length)
+    {
+        AscendC::LocalTensor<T> local = queue.template AllocTensor<T>();
+        CopyInExact(local, gm[PipelineElement<HEAD>::Units(offset)], PipelineElement<HEAD>::Units(length));
+        queue.EnQue(local);
+        rest.CopyIn(offset, length);
+    }
+
+    // 一个 Tile 实际从 GM 读取的字节数，仅用于性能打点。
+    __aicore__ inline uint64_t Bytes(uint32_t length) const
+    {
+        return PipelineElement<HEAD>::Units(length) * sizeof(T) + rest.Bytes(length);
+    }
+
+    template<typename COMPUTE, typename TYPE_Y, typename... LOCALS>
+    __aicore__ inline void Compute(COMPUTE& computer, const AscendC::LocalTensor<TYPE_Y>& yLocal, uint32_t length,
+                                   const LOCALS&... locals)
+    {
+        AscendC::LocalTensor<T> local = queue.template DeQue<T>();
+        rest.Compute(computer, yLocal, length, locals..., local);
+        queue.FreeTensor(local);
+    }
+
+    AscendC::TQue<AscendC::QuePosition::VECIN, DEPTH> queue;
+    AscendC::GlobalTensor<T> gm;
+    PipelineInputs<DEPTH, REST...> rest;
+};
+
+// 连续分支的 CopyIn -> Compute -> CopyOut 流水线，队列深度为 DEPTH（2 为双缓冲，3 为三缓冲），由 TilingKey 选择。
+// 核间切分见 kernel_split.h 中的 ElementwiseBlock，与 op_host 中 SplitElementwise 一致。
+// 最后一个 Tile 只搬入、搬出有效元素，计算按 32 字节对齐后的长度进行，补齐部分的结果不会被搬出。
+// 支持原地执行（y 与某个同形状、同类型的输入为同一块 GM）：每个 Tile 先整块搬入再搬出同一区间，
+// 预取的只是后面尚未写回的 Tile，各核的区间互不重叠，因此任何元素都在被写回之前读取。
+// y 与标量输入共用同一块 GM 时，调用方传入 serial = true，由 0 号核串行处理全部元素（见 ElementwiseBlock::InitSerial）。
+template<typename COMPUTE, typename TYPE_Y, int32_t DEPTH, typename... TYPE_X>
+class ElementwisePipeline {
+public:
+    __aicore__ inline ElementwisePipeline() {}
+
+    // inputs 按 TYPE_X 的顺序给出各输入的 GM 地址。
+    __aicore__ inline void Init(const GM_ADDR* inputs, GM_ADDR y, uint32_t coreUnit,
+                                uint32_t block_size, uint32_t core_size, uint32_t core_remain, uint32_t core_tail,
+                                GM_ADDR workspace, bool serial = false)
+    {
+        if (serial) {
+            block.InitSerial(coreUnit, block_size, core_size, core_remain, core_tail);
+        } else {
+            block.Init(coreUnit, block_size, core_size, core_remain, core_tail);
+        }
+
+        this->inputs.Init(pipe, inputs, block.offset, block.length, block.tileLength);
+        yGm.SetGlobalBuffer((__gm__ TYPE_Y*)y + block.offset, block.length);
+        pipe.InitBuffer(outQueueY, DEPTH, block.tileLength * sizeof(TYPE_Y));
+        computer.Init(pipe, block.tileLength);
+        profiler.Init(workspace);
+    }
+
+    // 标量输入等需要在 Init 之后交给计算类的参数通过它设置。
+    __aicore__ inline COMPUTE& Computer()
+    {
+        return computer;
+    }
+
+    // 软件流水：Tile i 计算之前已发出 Tile i + 1 ... i + DEPTH - 1 的搬入，搬入与计算、搬出在不同的流水上重叠。
+    // 各输入队列中同时最多有 DEPTH 个 Tile，与 InitBuffer 的块数一致。
+    // 打点按循环的每一轮记录，COPY_IN 段是为后面的 Tile 发出的搬入。
+    __aicore__ inline void Process()
+    {
+        uint32_t prefetch = (static_cast<uint32_t>(DEPTH - 1) < block.tileNum) ? DEPTH - 1 : block.tileNum;
+        // 序言：发出前 prefetch 个 Tile 的搬入。
+        for (uint32_t i = 0; i < prefetch; i++) {
+            inputs.CopyIn(i * block.tileLength, block.TileLength(i));
+        }
+        // 稳态：搬入 Tile i + prefetch，计算并搬出 Tile i。
+        uint32_t steady = block.tileNum - prefetch;
+        for (uint32_t i = 0; i < steady; i++) {
+            profiler.TileBegin();
+            inputs.CopyIn((i + prefetch) * block.tileLength, block.TileLength(i + prefetch));
+            profiler.Mark(OP_PROFILE_COPY_IN);
+            ProcessTile(i);
+        }
+        // 尾声：剩余的 prefetch 个 Tile 已在队列中，只计算与搬出。
+        for (uint32_t i = steady; i < block.tileNum; i++) {
+            profiler.TileBegin();
+            profiler.Mark(OP_PROFILE_COPY_IN);
+            ProcessTile(i);
+        }
+        profiler.Finish();
+    }
+
+private:
+    __aicore__ inline void ProcessTile(uint32_t progress)
+    {
+        uint32_t length = block.TileLength(progress);
+        Compute(length);
+        profiler.Mark(OP_PROFILE_COMPUTE);
+        CopyOut(progress * block.tileLength, length);
+        profiler.Mark(OP_PROFILE_COPY_OUT);
+        profiler.AddBytes(inputs.Bytes(length), length * sizeof(TYPE_Y));
+    }
+
+    __aicore__ inline void Compute(uint32_t length)
+    {
+        AscendC::LocalTensor<TYPE_Y> yLocal = outQueueY.template AllocTensor<TYPE_Y>();
+        inputs.Compute(computer, yLocal, AlignUp(length, COPY_ALIGN_BYTES / sizeof(TYPE_Y)));
+        outQueueY.EnQue(yLocal);
+    }
+
+    __aicore__ inline void CopyOut(uint32_t offset, uint32_t length)
+    {
+        AscendC::LocalTensor<TYPE_Y> yLocal = outQueueY.template DeQue<TYPE_Y>();
+        CopyOutExact(yGm[offset], yLocal, length);
+        outQueueY.FreeTensor(yLocal);
+    }
+
+private:
+    ElementwiseBlock block;
+
+    AscendC::TPipe pipe;
+    PipelineInputs<DEPTH, TYPE_X...> inputs;
+    AscendC::TQue<AscendC::QuePosition::VECOUT, DEPTH> outQueueY;
+    AscendC::GlobalTensor<TYPE_Y> yGm;
+    COMPUTE computer;
+    OpProfiler profiler;
+};
+
+#endif  // ELEMENTWISE_PIPELINE_H
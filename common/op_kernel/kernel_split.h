@@ -0,0 +1,152 @@
+#ifndef KERNEL_SPLIT_H
+#define KERNEL_SPLIT_H
+
+// 核函数的核间与核内切分，只做整数运算：
+//   ElementwiseBlock：连续分支按 op_host 中 SplitElementwise 的结果求本核的区间与 Tile 划分；
+//   BroadcastTiler  ：广播分支按 SplitBroadcastRows 的行切分求本核负责的 Tile 区间并定位每个 Tile。
+// 定义 KERNEL_SPLIT_HOST_SIM 时可在 Host 上编译，tools/split_coverage_check 与 tools/inplace_schedule_check
+// 直接用这里的实现重放各核的读写区间。
+#ifdef KERNEL_SPLIT_HOST_SIM
+#include <cstdint>
+#ifndef __aicore__
+#define __aicore__
+#endif
+#else
+#include "kernel_operator.h"
+#endif
+
+// 连续分支本核负责的区间：前 core_remain 个核各多处理一个 coreUnit，最后一个核额外处理不足 coreUnit 的尾部元素。
+// 除最后一个核外每个核的长度都是 coreUnit 的整数倍，各核在 GM 上的起始地址保持 32 字节对齐。
+struct ElementwiseBlock {
+    uint32_t offset;       // 本核第一个元素在输出中的下标
+    uint32_t length;       // 本核处理的元素数
+    uint32_t tileLength;
+    uint32_t tileNum;
+
+    __aicore__ inline void Init(uint32_t blockIdx, uint32_t blockNum, uint32_t coreUnit, uint32_t block_size,
+                                uint32_t core_size, uint32_t core_remain, uint32_t core_tail)
+    {
+        this->offset = blockIdx * core_size + (blockIdx < core_remain ? blockIdx : core_remain) * coreUnit;
+        this->length = core_size + (blockIdx < core_remain ? coreUnit : 0);
+        if (blockIdx == blockNum - 1) {
+            this->length += core_tail;
+        }
+        this->tileLength = block_size;
+        this->tileNum = (this->length + this->tileLength - 1) / this->tileLength;
+    }
+
+    // 串行回退：0 号核按顺序处理全部元素，其余核不处理。y 与标量输入共用同一块 GM 时使用：
+    // 标量在 Init 中读取，多核并行时其他核可能在 0 号核写回 y[0] 之后才读到它。
+    __aicore__ inline void InitSerial(uint32_t blockIdx, uint32_t blockNum, uint32_t coreUnit, uint32_t block_size,
+                                      uint32_t core_size, uint32_t core_remain, uint32_t core_tail)
+    {
+        this->offset = 0;
+        this->length = (blockIdx == 0) ? core_size * blockNum + core_remain * coreUnit + core_tail : 0;
+        this->tileLength = block_size;
+        this->tileNum = (this->length + this->tileLength - 1) / this->tileLength;
+    }
+
+#ifndef KERNEL_SPLIT_HOST_SIM
+    __aicore__ inline void Init(uint32_t coreUnit, uint32_t block_size, uint32_t core_size, uint32_t core_remain,
+                                uint32_t core_tail)
+    {
+        Init(AscendC::GetBlockIdx(), AscendC::GetBlockNum(), coreUnit, block_size, core_size, core_remain, core_tail);
+    }
+
+    __aicore__ inline void InitSerial(uint32_t coreUnit, uint32_t block_size, uint32_t core_size, uint32_t core_remain,
+                                      uint32_t core_tail)
+    {
+        InitSerial(AscendC::GetBlockIdx(), AscendC::GetBlockNum(), coreUnit, block_size, core_size, core_remain,
+                   core_tail);
+    }
+#endif
+
+    // 最后一个 Tile 可能不满 tileLength。
+    __aicore__ inline uint32_t TileLength(uint32_t progress) const
+    {
+        return (progress == this->tileNum - 1) ? this->length - progress * this->tileLength : this->tileLength;
+    }
+};
+
+// 广播分支的行切分：输出按合并后的最内维看作 [rowNum, rowLength]，
+// 行较短时一个 Tile 处理若干整行，行较长时一个 Tile 处理一行中的一段。
+// 每行在 UB 中占 colPad 个元素（cols 向上对齐到 rowAlign），保证每行起始地址 32 字节对齐。
+struct BroadcastTile {
+    uint32_t rowStart;
+    uint32_t rows;
+    uint32_t colStart;
+    uint32_t cols;
+    uint32_t colPad;
+};
+
+// 行切分参数与本核负责的 Tile 区间。Tile 按行组优先编号，连续区间分给同一个核，
+// 因此各核负责的是输出在外层维度上相邻的一段。核函数按 Locate(Order(i))，i 从 tileStart 到 tileEnd 处理。
+struct BroadcastTiler {
+    uint32_t rowNum, rowLength, rowTile, colTile, colTileNum, rowAlign;
+    uint32_t tileStart, tileEnd;
+    bool reverse;
+
+    __aicore__ inline void Init(uint64_t totalLength, uint32_t row_length, uint32_t row_tile, uint32_t col_tile,
+                                uint32_t row_align, uint32_t blockIdx, uint32_t blockNum)
+    {
+        this->rowLength = row_length;
+        this->rowNum = totalLength / row_length;
+        this->rowTile = row_tile;
+        this->colTile = col_tile;
+        this->colTileNum = (row_length + col_tile - 1) / col_tile;
+        this->rowAlign = row_align;
+
+        // Tile 按核均分：前 tileRemain 个核各多处理一个 Tile。
+        uint32_t tileNum = (this->rowNum + this->rowTile - 1) / this->rowTile * this->colTileNum;
+        uint32_t tilePerCore = tileNum / blockNum;
+        uint32_t tileRemain = tileNum % blockNum;
+        this->tileStart = blockIdx * tilePerCore + (blockIdx < tileRemain ? blockIdx : tileRemain);
+        this->tileEnd = this->tileStart + tilePerCore + (blockIdx < tileRemain ? 1 : 0);
+        this->reverse = false;
+    }
+
+    // 串行倒序回退：0 号核从最后一个 Tile 倒序处理全部 Tile，其余核不处理。y 与广播输入共用同一块 GM 时使用。
+    // 广播输入第 e 个输出元素读取的下标不大于 e，Tile 是输出上连续的一段，
+    // 倒序时每个 Tile 读取的区间都还没有被写回，与搬入、搬出之间的先后无关。
+    __aicore__ inline void Serialize(uint32_t blockIdx)
+    {
+        uint32_t tileNum = (this->rowNum + this->rowTile - 1) / this->rowTile * this->colTileNum;
+        this->tileStart = 0;
+        this->tileEnd = (blockIdx == 0) ? tileNum : 0;
+        this->reverse = true;
+    }
+
+#ifndef KERNEL_SPLIT_HOST_SIM
+    __aicore__ inline void Init(uint64_t totalLength, uint32_t row_length, uint32_t row_tile, uint32_t col_tile,
+                                uint32_t row_align)
+    {
+        Init(totalLength, row_length, row_tile, col_tile, row_align, AscendC::GetBlockIdx(), AscendC::GetBlockNum());
+    }
+
+    __aicore__ inline void Serialize()
+    {
+        Serialize(AscendC::GetBlockIdx());
+    }
+#endif
+
+    // 第 i 个处理的 Tile 的编号。
+    __aicore__ inline uint32_t Order(uint32_t i) const
+    {
+        return this->reverse ? this->tileStart + this->tileEnd - 1 - i : i;
+    }
+
+    __aicore__ inline BroadcastTile Locate(uint32_t progress) const
+    {
+        BroadcastTile tile;
+        uint32_t rowGroup = progress / this->colTileNum;
+        uint32_t colIdx = progress - rowGroup * this->colTileNum;
+        tile.rowStart = rowGroup * this->rowTile;
+        tile.rows = (this->rowNum - tile.rowStart < this->rowTile) ? (this->rowNum - tile.rowStart) : this->rowTile;
+        tile.colStart = colIdx * this->colTile;
+        tile.cols = (this->rowLength - tile.colStart < this->colTile) ? (this->rowLength - tile.colStart) : this->colTile;
+        tile.colPad = (tile.cols + this->rowAlign - 1) / this->rowAlign * this->rowAlign;
+        return tile;
+    }
+};
+
+#endif  // KERNEL_SPLIT_H
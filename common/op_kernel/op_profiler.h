@@ -0,0 +1,103 @@
+#ifndef OP_PROFILER_H
+#define OP_PROFILER_H
+
+#include "kernel_operator.h"
+#include "op_profile_layout.h"
+
+#ifndef OP_PROFILING
+#define OP_PROFILING 0
+#endif
+
+// 逐核、逐 Tile 记录 CopyIn / Compute / CopyOut 的 cycle 数，写入用户 workspace（布局见 op_profile_layout.h）。
+// 编译时 OP_PROFILING=0（默认）时所有接口为空实现，不产生任何开销。
+// 开启后每个阶段结束都会 PipeBarrier<PIPE_ALL>，各阶段不再重叠，测得的是各阶段的独立耗时；
+// 每个 Tile 的 TileBegin 与上一次 Mark 之间的时间（标量计算、队列等待等）计入停顿。
+class OpProfiler {
+public:
+    __aicore__ inline OpProfiler() {}
+
+#if OP_PROFILING
+    __aicore__ inline void Init(GM_ADDR workspace)
+    {
+        GM_ADDR userWorkspace = AscendC::GetUserWorkspace(workspace);
+        this->recordGm.SetGlobalBuffer((__gm__ uint64_t*)(userWorkspace) + AscendC::GetBlockIdx() * OP_PROFILE_REGION_WORDS,
+                                       OP_PROFILE_REGION_WORDS);
+        this->tileNum = 0;
+        this->readBytes = 0;
+        this->writeBytes = 0;
+        for (uint32_t i = 0; i < OP_PROFILE_STAGE_NUM; i++) {
+            this->stageCycles[i] = 0;
+        }
+        AscendC::PipeBarrier<PIPE_ALL>();
+        this->startCycle = static_cast<uint64_t>(AscendC::GetSystemCycle());
+        this->lastCycle = this->startCycle;
+    }
+
+    __aicore__ inline void TileBegin()
+    {
+        AscendC::PipeBarrier<PIPE_ALL>();
+        this->lastCycle = static_cast<uint64_t>(AscendC::GetSystemCycle());
+    }
+
+    // 记录从上一次 TileBegin / Mark 到当前的耗时，CopyOut 阶段结束时一个 Tile 记录完成。
+    __aicore__ inline void Mark(uint32_t stage)
+    {
+        AscendC::PipeBarrier<PIPE_ALL>();
+        uint64_t now = static_cast<uint64_t>(AscendC::GetSystemCycle());
+        uint64_t cost = now - this->lastCycle;
+        this->lastCycle = now;
+        this->stageCycles[stage] += cost;
+        uint32_t base = OP_PROFILE_HEADER_WORDS + this->tileNum * OP_PROFILE_TILE_WORDS;
+        if (this->tileNum < OP_PROFILE_MAX_TILES) {
+            this->recordGm.SetValue(base + stage, cost);
+        }
+        if (stage == OP_PROFILE_COPY_OUT) {
+            if (this->tileNum < OP_PROFILE_MAX_TILES) {
+                this->recordGm.SetValue(base + OP_PROFILE_T_END_CYCLE, now);
+            }
+            this->tileNum++;
+        }
+    }
+
+    __aicore__ inline void AddBytes(uint64_t read, uint64_t write)
+    {
+        this->readBytes += read;
+        this->writeBytes += write;
+    }
+
+    __aicore__ inline void Finish()
+    {
+        AscendC::PipeBarrier<PIPE_ALL>();
+        uint64_t endCycle = static_cast<uint64_t>(AscendC::GetSystemCycle());
+        this->recordGm.SetValue(OP_PROFILE_H_MAGIC, OP_PROFILE_MAGIC);
+        this->recordGm.SetValue(OP_PROFILE_H_VERSION, OP_PROFILE_VERSION);
+        this->recordGm.SetValue(OP_PROFILE_H_BLOCK_IDX, AscendC::GetBlockIdx());
+        this->recordGm.SetValue(OP_PROFILE_H_BLOCK_NUM, AscendC::GetBlockNum());
+        this->recordGm.SetValue(OP_PROFILE_H_TILE_NUM, this->tileNum);
+        this->recordGm.SetValue(OP_PROFILE_H_START_CYCLE, this->startCycle);
+        this->recordGm.SetValue(OP_PROFILE_H_END_CYCLE, endCycle);
+        for (uint32_t i = 0; i < OP_PROFILE_STAGE_NUM; i++) {
+            this->recordGm.SetValue(OP_PROFILE_H_STAGE_CYCLES + i, this->stageCycles[i]);
+        }
+        this->recordGm.SetValue(OP_PROFILE_H_READ_BYTES, this->readBytes);
+        this->recordGm.SetValue(OP_PROFILE_H_WRITE_BYTES, this->writeBytes);
+        // 标量写 GM 经过 DCache，需要刷回 GM 后 Host 才能读到。
+        AscendC::DataCacheCleanAndInvalid<uint64_t, AscendC::CacheLine::ENTIRE_DATA_CACHE>(this->recordGm);
+    }
+
+private:
+    AscendC::GlobalTensor<uint64_t> recordGm;
+    uint64_t stageCycles[OP_PROFILE_STAGE_NUM];
+    uint64_t startCycle, lastCycle;
+    uint64_t readBytes, writeBytes;
+    uint32_t tileNum;
+#else
+    __aicore__ inline void Init(GM_ADDR workspace) {}
+    __aicore__ inline void TileBegin() {}
+    __aicore__ inline void Mark(uint32_t stage) {}
+    __aicore__ inline void AddBytes(uint64_t read, uint64_t write) {}
+    __aicore__ inline void Finish() {}
+#endif
+};
+
+#endif  // OP_PROFILER_H
@@ -0,0 +1,281 @@
+#ifndef POWS_COMPUTE_H
+#define POWS_COMPUTE_H
+
+#include "kernel_operator.h"
+
+// Pows 的逐元素计算，供 Pows 与 PowsSelect 的核函数共用。
+
+constexpr uint32_t FLOAT_NAN_BITS = 0x7fc00000;
+constexpr uint32_t FLOAT_INF_BITS = 0x7f800000;
+constexpr float MAX_EXACT_INT = 16777216.0f;   // 2^24，绝对值不小于该值的 float 都是偶数
+constexpr uint32_t MASK_ALIGN = 64;            // Compare 按 256 字节处理，float 对应 64 个元素
+
+__aicore__ inline float BitsToFloat(uint32_t bits)
+{
+    union {
+        uint32_t u;
+        float f;
+    } value;
+    value.u = bits;
+    return value.f;
+}
+
+// sign-aware 模式：先在 |x1| 上计算 exp(x2 * ln|x1|)，再按 std::pow 语义在 Tile 内用向量 Compare/Select 修正：
+//   x1 的符号位为 1 且 x2 为奇数 -> 取负（含 -0.0，pow(-0.0, 负奇数) 为 -inf）
+//   x1 < 0 且 x2 不是整数    -> NaN（x1 为 -inf 时除外，结果与 +inf 相同）
+//   x2 == 0 或 x1 == 1       -> 1
+//   |x1| == 1 且 x2 为 ±inf  -> 1
+// 各掩码按位存放（每个元素 1 bit），与 Select 的输入格式一致。
+class PowsSignFixup {
+public:
+    __aicore__ inline PowsSignFixup() {}
+
+    __aicore__ inline void Init(AscendC::TPipe& pipe, uint32_t tileLength)
+    {
+        uint32_t maskBytes = (tileLength / 8 + 31) / 32 * 32;
+        pipe.InitBuffer(B_abs, tileLength * sizeof(float));
+        pipe.InitBuffer(B_tmp, tileLength * sizeof(float));
+        pipe.InitBuffer(B_int, tileLength * sizeof(int32_t));
+        pipe.InitBuffer(B_mask0, maskBytes);
+        pipe.InitBuffer(B_mask1, maskBytes);
+        pipe.InitBuffer(B_mask2, maskBytes);
+        pipe.InitBuffer(B_mask3, maskBytes);
+    }
+
+    // 返回 |base|，供调用方计算 Ln。
+    __aicore__ inline AscendC::LocalTensor<float> AbsBase(const AscendC::LocalTensor<float>& base, uint32_t length)
+    {
+        auto absBase = B_abs.Get<float>();
+        AscendC::Abs(absBase, base, AlignCount(length));
+        return absBase;
+    }
+
+    // res 中已是 |base| ** expo，按逐元素指数修正。
+    __aicore__ inline void Apply(const AscendC::LocalTensor<float>& res, const AscendC::LocalTensor<float>& base,
+                                 const AscendC::LocalTensor<float>& expo, uint32_t length)
+    {
+        uint32_t count = AlignCount(length);
+        uint32_t maskCount = count / 16;
+        auto work = B_abs.Get<float>();
+        auto tmp = B_tmp.Get<float>();
+        auto tmpInt = B_int.Get<int32_t>();
+        auto keep = B_mask0.Get<uint8_t>();
+        auto isInt = B_mask1.Get<uint8_t>();
+        auto odd = B_mask2.Get<uint8_t>();
+        auto neg = B_mask3.Get<uint8_t>();
+        auto keep16 = keep.ReinterpretCast<uint16_t>();
+        auto isInt16 = isInt.ReinterpretCast<uint16_t>();
+        auto odd16 = odd.ReinterpretCast<uint16_t>();
+        auto neg16 = neg.ReinterpretCast<uint16_t>();
+
+        // keep：结果不需要置 1 的位置。此时 work 中仍是 |base|。
+        AscendC::CompareScalar(keep, work, 1.0f, AscendC::CMPMODE::NE, count);
+        AscendC::Abs(work, expo, count);
+        AscendC::CompareScalar(odd, work, BitsToFloat(FLOAT_INF_BITS), AscendC::CMPMODE::NE, count);
+        AscendC::Or(keep16, keep16, odd16, maskCount);
+        AscendC::CompareScalar(odd, expo, 0.0f, AscendC::CMPMODE::NE, count);
+        AscendC::And(keep16, keep16, odd16, maskCount);
+        AscendC::CompareScalar(odd, base, 1.0f, AscendC::CMPMODE::NE, count);
+        AscendC::And(keep16, keep16, odd16, maskCount);
+
+        // isInt / odd：指数先截断到 ±2^24 再判断，超出该范围的 float 都是偶数。
+        AscendC::Mins(work, expo, MAX_EXACT_INT, count);
+        AscendC::Maxs(work, work, -MAX_EXACT_INT, count);
+        AscendC::Cast(tmpInt, work, AscendC::RoundMode::CAST_FLOOR, count);
+        AscendC::Cast(tmp, tmpInt, AscendC::RoundMode::CAST_NONE, count);
+        AscendC::Compare(isInt, tmp, work, AscendC::CMPMODE::EQ, count);
+        AscendC::Muls(work, work, 0.5f, count);
+        AscendC::Cast(tmpInt, work, AscendC::RoundMode::CAST_FLOOR, count);
+        AscendC::Cast(tmp, tmpInt, AscendC::RoundMode::CAST_NONE, count);
+        AscendC::Compare(odd, tmp, work, AscendC::CMPMODE::NE, count);
+        AscendC::And(odd16, odd16, isInt16, maskCount);
+
+        // 符号位为 1 的底数（含 -0.0）奇数次幂取负；有限负底数的非整数次幂结果无定义，其余位置保持（isInt 改为“结果有效”掩码）。
+        SignBitMask(neg, base, work, tmp, count);
+        AscendC::And(odd16, odd16, neg16, maskCount);
+        AscendC::CompareScalar(neg, base, -BitsToFloat(FLOAT_INF_BITS), AscendC::CMPMODE::EQ, count);
+        AscendC::Or(isInt16, isInt16, neg16, maskCount);
+        AscendC::CompareScalar(neg, base, 0.0f, AscendC::CMPMODE::LT, count);
+        AscendC::Not(neg16, neg16, maskCount);
+        AscendC::Or(isInt16, isInt16, neg16, maskCount);
+
+        AscendC::Muls(tmp, res, -1.0f, count);
+        AscendC::Select(res, odd, tmp, res, AscendC::SELMODE::VSEL_TENSOR_TENSOR_MODE, count);
+        AscendC::Select(res, isInt, res, BitsToFloat(FLOAT_NAN_BITS), AscendC::SELMODE::VSEL_TENSOR_SCALAR_MODE, count);
+        AscendC::Select(res, keep, res, 1.0f, AscendC::SELMODE::VSEL_TENSOR_SCALAR_MODE, count);
+    }
+
+    // 标量指数版本：奇偶性与是否为整数在标量侧确定，只需对底数做判断。
+    __aicore__ inline void ApplyScalar(const AscendC::LocalTensor<float>& res, const AscendC::LocalTensor<float>& base,
+                                       float expo, uint32_t length)
+    {
+        uint32_t count = AlignCount(length);
+        auto tmp = B_tmp.Get<float>();
+        auto mask = B_mask0.Get<uint8_t>();
+        float absExpo = expo < 0 ? -expo : expo;
+        if (absExpo == BitsToFloat(FLOAT_INF_BITS)) {
+            // |x1| == 1 时 ±inf 次幂为 1。此时 B_abs 中仍是 |base|。
+            AscendC::CompareScalar(mask, B_abs.Get<float>(), 1.0f, AscendC::CMPMODE::NE, count);
+            AscendC::Select(res, mask, res, 1.0f, AscendC::SELMODE::VSEL_TENSOR_SCALAR_MODE, count);
+        } else if (expo != expo) {
+            AscendC::CompareScalar(mask, base, 1.0f, AscendC::CMPMODE::NE, count);
+            AscendC::Select(res, mask, res, 1.0f, AscendC::SELMODE::VSEL_TENSOR_SCALAR_MODE, count);
+        } else if (absExpo >= MAX_EXACT_INT || static_cast<float>(static_cast<int32_t>(expo)) == expo) {
+            bool isOdd = absExpo < MAX_EXACT_INT && (static_cast<int32_t>(expo) & 1) != 0;
+            if (isOdd) {
+                SignBitMask(mask, base, B_abs.Get<float>(), tmp, count);
+                AscendC::Muls(tmp, res, -1.0f, count);
+                AscendC::Select(res, mask, tmp, res, AscendC::SELMODE::VSEL_TENSOR_TENSOR_MODE, count);
+            }
+        } else {
+            auto negInf = B_mask1.Get<uint8_t>();
+            AscendC::CompareScalar(mask, base, 0.0f, AscendC::CMPMODE::GE, count);
+            AscendC::CompareScalar(negInf, base, -BitsToFloat(FLOAT_INF_BITS), AscendC::CMPMODE::EQ, count);
+            AscendC::Or(mask.ReinterpretCast<uint16_t>(), mask.ReinterpretCast<uint16_t>(),
+                        negInf.ReinterpretCast<uint16_t>(), count / 16);
+            AscendC::Select(res, mask, res, BitsToFloat(FLOAT_NAN_BITS), AscendC::SELMODE::VSEL_TENSOR_SCALAR_MODE, count);
+        }
+    }
+
+    // 标量指数为 ±0.5 时的 Sqrt / Rsqrt 快速路径：-0.0 加 0 后为 +0.0，开方得 +0（Rsqrt 为 +inf），与 std::pow 一致。
+    // 返回的 Tensor 占用 B_abs。
+    __aicore__ inline AscendC::LocalTensor<float> UnsignedZero(const AscendC::LocalTensor<float>& base, uint32_t length)
+    {
+        auto work = B_abs.Get<float>();
+        AscendC::Adds(work, base, 0.0f, AlignCount(length));
+        return work;
+    }
+
+    // 快速路径中 Sqrt(-inf) / Rsqrt(-inf) 为 NaN，std::pow 取 +inf（0.5 次幂）或 +0（-0.5 次幂），由 value 给出。
+    __aicore__ inline void ApplyNegInf(const AscendC::LocalTensor<float>& res, const AscendC::LocalTensor<float>& base,
+                                       float value, uint32_t length)
+    {
+        uint32_t count = AlignCount(length);
+        auto mask = B_mask0.Get<uint8_t>();
+        AscendC::CompareScalar(mask, base, -BitsToFloat(FLOAT_INF_BITS), AscendC::CMPMODE::NE, count);
+        AscendC::Select(res, mask, res, value, AscendC::SELMODE::VSEL_TENSOR_SCALAR_MODE, count);
+    }
+
+private:
+    // 底数符号位为 1 的掩码。CompareScalar(LT, 0) 对 -0.0 为假，这里按位把底数变为同号的 ±1.0 再比较：
+    // (base | 1.0f) & -1.0f 只保留符号位与 1.0f 的指数位。work、tmp 为 count 个 float 的临时空间。
+    __aicore__ inline void SignBitMask(const AscendC::LocalTensor<uint8_t>& mask, const AscendC::LocalTensor<float>& base,
+                                       const AscendC::LocalTensor<float>& work, const AscendC::LocalTensor<float>& tmp,
+                                       uint32_t count)
+    {
+        auto base16 = base.ReinterpretCast<uint16_t>();
+        auto work16 = work.ReinterpretCast<uint16_t>();
+        auto tmp16 = tmp.ReinterpretCast<uint16_t>();
+        AscendC::Duplicate(tmp, 1.0f, count);
+        AscendC::Or(work16, base16, tmp16, count * 2);
+        AscendC::Duplicate(tmp, -1.0f, count);
+        AscendC::And(work16, work16, tmp16, count * 2);
+        AscendC::CompareScalar(mask, work, 0.0f, AscendC::CMPMODE::LT, count);
+    }
+
+    __aicore__ inline uint32_t AlignCount(uint32_t length)
+    {
+        return (length + MASK_ALIGN - 1) / MASK_ALIGN * MASK_ALIGN;
+    }
+
+private:
+    AscendC::TBuf<AscendC::QuePosition::VECCALC> B_abs, B_tmp, B_int;
+    AscendC::TBuf<AscendC::QuePosition::VECCALC> B_mask0, B_mask1, B_mask2, B_mask3;
+};
+
+// Pows 的逐元素计算 y = exp(x2 * ln(x1))，由连续分支与广播分支共用。
+// half / bf16 先转换为 float 计算，结果再转换回原类型。
+// SIGN_AWARE 为 true 时按 std::pow 语义处理负底数与 0/1 等特殊值（见 PowsSignFixup）。
+template<typename TYPE_X1, typename TYPE_X2, typename TYPE_Y, bool SIGN_AWARE = false> class PowsCompute {
+public:
+    __aicore__ inline PowsCompute() {}
+
+    // 申请的 Buffer 需与 op_host/pows.cpp 中 PowsTileLength 的统计一致。
+    __aicore__ inline void Init(AscendC::TPipe& pipe, uint32_t tileLength)
+    {
+        if constexpr (SIGN_AWARE) {
+            fixup.Init(pipe, tileLength);
+            if constexpr (!std::is_same_v<TYPE_Y, float32_t>) {
+                pipe.InitBuffer(B_x1, tileLength * sizeof(float));
+                pipe.InitBuffer(B_x2, tileLength * sizeof(float));
+                pipe.InitBuffer(B_y, tileLength * sizeof(float));
+            }
+            return;
+        }
+        // float 直接在输出队列的 Tensor 上计算；half / bf16 需要 x1、x2 的 float 中间结果，结果复用 x1 的 Buffer。
+        if constexpr (!std::is_same_v<TYPE_Y, float32_t>) {
+            pipe.InitBuffer(B_x1, tileLength * sizeof(float));
+            pipe.InitBuffer(B_x2, tileLength * sizeof(float));
+        }
+    }
+
+    __aicore__ inline void Compute(const AscendC::LocalTensor<TYPE_Y>& yLocal, const AscendC::LocalTensor<TYPE_X1>& x1Local,
+                                   const AscendC::LocalTensor<TYPE_X2>& x2Local, uint32_t length)
+    {
+        if constexpr (SIGN_AWARE) {
+            ComputeSignAware(yLocal, x1Local, x2Local, length);
+            return;
+        }
+        if constexpr (std::is_same_v<TYPE_Y, float32_t>) {
+            AscendC::Ln(yLocal, x1Local, length);
+            AscendC::Mul(yLocal, x2Local, yLocal, length);
+            AscendC::Exp(yLocal, yLocal, length);
+        }
+        else if constexpr (std::is_same_v<TYPE_Y, float16_t>) {
+            auto tmp_x1 = B_x1.Get<float32_t>();
+            auto tmp_x2 = B_x2.Get<float32_t>();
+            AscendC::Cast(tmp_x1, x1Local, AscendC::RoundMode::CAST_NONE, length);
+            AscendC::Cast(tmp_x2, x2Local, AscendC::RoundMode::CAST_NONE, length);
+            AscendC::Ln(tmp_x1, tmp_x1, length);
+            AscendC::Mul(tmp_x1, tmp_x2, tmp_x1, length);
+            AscendC::Exp(tmp_x1, tmp_x1, length);
+            AscendC::Cast(yLocal, tmp_x1, AscendC::RoundMode::CAST_NONE, length);
+
+        }
+        else if constexpr (std::is_same_v<TYPE_Y, bfloat16_t>){
+            auto tmp_x1 = B_x1.Get<float>();
+            auto tmp_x2 = B_x2.Get<float>();
+            AscendC::Cast(tmp_x1, x1Local, AscendC::RoundMode::CAST_NONE, length);
+            AscendC::Cast(tmp_x2, x2Local, AscendC::RoundMode::CAST_NONE, length);
+            AscendC::Ln(tmp_x1, tmp_x1, length);
+            AscendC::Mul(tmp_x1, tmp_x1, tmp_x2, length);
+            AscendC::Exp(tmp_x1, tmp_x1, length);
+            AscendC::Cast(yLocal, tmp_x1, AscendC::RoundMode::CAST_ROUND, length);
+        }
+    }
+
+private:
+    __aicore__ inline void ComputeSignAware(const AscendC::LocalTensor<TYPE_Y>& yLocal, const AscendC::LocalTensor<TYPE_X1>& x1Local,
+                                            const AscendC::LocalTensor<TYPE_X2>& x2Local, uint32_t length)
+    {
+        if constexpr (std::is_same_v<TYPE_Y, float32_t>) {
+            auto absBase = fixup.AbsBase(x1Local, length);
+            AscendC::Ln(yLocal, absBase, length);
+            AscendC::Mul(yLocal, x2Local, yLocal, length);
+            AscendC::Exp(yLocal, yLocal, length);
+            fixup.Apply(yLocal, x1Local, x2Local, length);
+        } else {
+            auto tmp_x1 = B_x1.Get<float>();
+            auto tmp_x2 = B_x2.Get<float>();
+            auto tmp_y = B_y.Get<float>();
+            AscendC::Cast(tmp_x1, x1Local, AscendC::RoundMode::CAST_NONE, length);
+            AscendC::Cast(tmp_x2, x2Local, AscendC::RoundMode::CAST_NONE, length);
+            auto absBase = fixup.AbsBase(tmp_x1, length);
+            AscendC::Ln(tmp_y, absBase, length);
+            AscendC::Mul(tmp_y, tmp_x2, tmp_y, length);
+            AscendC::Exp(tmp_y, tmp_y, length);
+            fixup.Apply(tmp_y, tmp_x1, tmp_x2, length);
+            if constexpr (std::is_same_v<TYPE_Y, bfloat16_t>) {
+                AscendC::Cast(yLocal, tmp_y, AscendC::RoundMode::CAST_ROUND, length);
+            } else {
+                AscendC::Cast(yLocal, tmp_y, AscendC::RoundMode::CAST_NONE, length);
+            }
+        }
+    }
+
+private:
+    AscendC::TBuf<AscendC::QuePosition::VECCALC> B_x1, B_x2, B_y;
+    PowsSignFixup fixup;
+};
+
+#endif  // POWS_COMPUTE_H
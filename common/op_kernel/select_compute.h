@@ -0,0 +1,294 @@
+#ifndef SELECT_COMPUTE_H
+#define SELECT_COMPUTE_H
+
+#include "kernel_operator.h"
+#include "copy_utils.h"
+#include "broadcast_tile.h"
+
+// SelectV2 的逐元素计算，供 SelectV2 与 PowsSelect 的核函数共用。
+
+constexpr uint32_t COMPARE_ALIGN = 128;   // Compare 按 256 字节处理，half 对应 128 个元素
+
+// KernelSelect 的输入形式，与 TilingKey 对应。
+constexpr int32_t SELECT_TENSOR = 0;      // condition、x1、x2 均为同形状张量（TilingKey 1）
+constexpr int32_t SELECT_PACKED = 1;      // condition 为打包的按位掩码（TilingKey 3）
+constexpr int32_t SELECT_SCALAR_X2 = 2;   // x2 为标量，如 where(mask, x, -inf)（TilingKey 5）
+constexpr int32_t SELECT_SCALAR_X1 = 3;   // x1 为标量（TilingKey 6）
+constexpr int32_t SELECT_UNIFORM = 4;     // 同 SELECT_TENSOR，condition 全 1 / 全 0 的 Tile 只搬入用到的输入（TilingKey 7）
+
+// SelectCompute::Classify 的结果。
+constexpr int32_t TILE_MIXED = 0;
+constexpr int32_t TILE_ALL_TRUE = 1;
+constexpr int32_t TILE_ALL_FALSE = 2;
+
+// select 只搬运数据的位，不做数值转换，只按元素宽度区分，KernelSelect 与 KernelSelect_Broadcast 共用：
+//   4 / 2 字节类型（float、int32 / half、bf16、int16）：condition 转为 half 后与 0 比较得到按位掩码，
+//     数据按同宽度的 float / half 解释后直接 Select，整数不经过浮点转换，超过 2^24 的 int32 也不会失真；
+//   8 字节类型（int64）：按 float 看作 2 * length 个元素，掩码需每个元素 2 位（ExpandMask），
+//     condition 的 half 先与 1 取 Mins 规整为 0 / 1，转为 int32 后乘 0x3C003C00，按 half 看即为两个相同的 0 / 1.0，再与 0 比较；
+//   1 字节类型（int8、uint8、bool）：Select 没有 1 字节版本，把相邻两个元素看作一个 int16，
+//     condition 规整为 0 / 1 后乘 0xFF 展开为逐字节掩码 m，y = (x1 & m) | (x2 & ~m)。
+// condition 中 1 以外的非零字节（如 0xFF）一律按 true 处理，与 Compare NE 0 的 2 / 4 字节类型一致。
+// SELECT_PACKED 时 condition 已按 Select 的掩码格式每个元素 1 bit 打包（见 PackCondition 算子）：
+//   4 / 2 字节类型直接用它 Select，省去 Cast 与 Compare；
+//   1 字节类型用它在常量 0xFF（B_full）与 0 之间按 half Select，再转换为逐字节掩码；
+//   8 字节类型用它在常量 1.0（B_full）与 0 之间按 half Select，再按 ExpandMask 展开为每个元素 2 位。
+// SELECT_SCALAR_X1 / SELECT_SCALAR_X2 时标量在 Init 中读取一次（SetScalar），每个 Tile 只搬入另一个输入：
+//   4 / 2 字节类型按 VSEL_TENSOR_SCALAR_MODE 选择，x1 为标量时用 EQ 比较使掩码取反；
+//   1 / 8 字节类型的标量放不进 Select 的标量参数，预先填满一个 Tile（B_scalar）后按张量选择。
+// SELECT_UNIFORM 的计算同 SELECT_TENSOR，另用 Classify 对 condition 做 ReduceMax / ReduceMin 判断整个 Tile 是否一致。
+template<typename TYPE_X1, typename TYPE_X2, typename TYPE_Y, int32_t MODE = SELECT_TENSOR> class SelectCompute {
+    static_assert(sizeof(TYPE_Y) == 1 || sizeof(TYPE_Y) == 2 || sizeof(TYPE_Y) == 4 || sizeof(TYPE_Y) == 8,
+                  "SelectV2 supports 1 / 2 / 4 / 8 byte elements");
+    // 每个元素在 Select 中占用的掩码位数：8 字节类型按 2 个 float 选择。
+    static constexpr uint32_t MASK_LANES = sizeof(TYPE_Y) == sizeof(uint64_t) ? 2 : 1;
+    static constexpr bool WIDE = sizeof(TYPE_Y) != sizeof(uint8_t);
+    static constexpr bool SCALAR_TILE = (MODE == SELECT_SCALAR_X1 || MODE == SELECT_SCALAR_X2) &&
+                                        (sizeof(TYPE_Y) == sizeof(uint8_t) || sizeof(TYPE_Y) == sizeof(uint64_t));
+
+public:
+    __aicore__ inline SelectCompute() {}
+
+    // 申请的 Buffer 需与 op_host/select_v2.cpp 中 SelectTileLength 的统计一致。
+    __aicore__ inline void Init(AscendC::TPipe& pipe, uint32_t tileLength)
+    {
+        this->tileLength = tileLength;
+        if constexpr (MODE == SELECT_PACKED) {
+            if constexpr (sizeof(TYPE_Y) == sizeof(uint8_t)) {
+                pipe.InitBuffer(B_full, tileLength * sizeof(half));
+                pipe.InitBuffer(B_mask_half, tileLength * sizeof(half));
+                pipe.InitBuffer(B_mask, tileLength * sizeof(uint8_t));
+                AscendC::Duplicate(B_full.Get<half>(), static_cast<half>(0xFF), tileLength);
+            } else if constexpr (MASK_LANES == 2) {
+                pipe.InitBuffer(B_full, tileLength * sizeof(half));
+                pipe.InitBuffer(B_con_half, tileLength * sizeof(half));
+                pipe.InitBuffer(B_con_int, tileLength * sizeof(int32_t));
+                pipe.InitBuffer(B_bits, (tileLength * MASK_LANES / 8 + 31) / 32 * 32);
+                this->con_half = B_con_half.Get<half>();
+                AscendC::Duplicate(B_full.Get<half>(), static_cast<half>(1), tileLength);
+            }
+        } else if constexpr (WIDE) {
+            pipe.InitBuffer(B_bits, (tileLength * MASK_LANES / 8 + 31) / 32 * 32);
+            pipe.InitBuffer(B_con_half, tileLength * sizeof(half));
+            this->con_half = B_con_half.Get<half>();
+            if constexpr (MASK_LANES == 2) {
+                pipe.InitBuffer(B_con_int, tileLength * sizeof(int32_t));
+            }
+        } else {
+            // 1 字节类型：ByteMask 经 half 把 condition 规整为 0 / 1，SELECT_UNIFORM 的 Classify 也用它。
+            pipe.InitBuffer(B_con_half, tileLength * sizeof(half));
+            this->con_half = B_con_half.Get<half>();
+        }
+        if constexpr (SCALAR_TILE) {
+            pipe.InitBuffer(B_scalar, tileLength * sizeof(TYPE_Y));
+        }
+        if constexpr (MODE == SELECT_UNIFORM) {
+            // ReduceMax / ReduceMin 的中间结果约为 tileLength / 64 个 half，按位掩码的大小足够。
+            pipe.InitBuffer(B_reduce, (tileLength / 8 + 31) / 32 * 32);
+            pipe.InitBuffer(B_reduce_dst, 2 * 32);
+        }
+    }
+
+    // 标量输入的值，SELECT_SCALAR_X1 / SELECT_SCALAR_X2 时在 Init 之后调用一次。
+    __aicore__ inline void SetScalar(TYPE_Y value)
+    {
+        this->scalarValue = value;
+        if constexpr (SCALAR_TILE) {
+            DuplicateValue(B_scalar.Get<TYPE_Y>(), value, this->tileLength);
+        }
+    }
+
+    // 补齐部分的数据无效，一起参与计算不影响有效结果，且不会被搬出。
+    // Compare 按 256 字节处理，长度向上对齐到 COMPARE_ALIGN 个元素；Tile 长度是其整数倍，不会越界。
+    // 1 字节类型的计算会原地改写 conditionLocal、x1Local、x2Local，调用方在计算后只释放它们。
+    __aicore__ inline void Compute(const AscendC::LocalTensor<TYPE_Y>& yLocal, const AscendC::LocalTensor<uint8_t>& conditionLocal,
+                                   const AscendC::LocalTensor<TYPE_X1>& x1Local, const AscendC::LocalTensor<TYPE_X2>& x2Local,
+                                   uint32_t length)
+    {
+        if constexpr (MODE == SELECT_PACKED) {
+            ComputePacked(yLocal, conditionLocal, x1Local, x2Local, length);
+            return;
+        }
+        if constexpr (sizeof(TYPE_Y) == sizeof(uint8_t)) {
+            uint32_t pairLength = AlignUp(length, COPY_ALIGN_BYTES) / 2;
+            auto mask = ByteMask(conditionLocal, pairLength);
+            ByteSelect(yLocal, mask, x1Local, x2Local, pairLength);
+            return;
+        }
+        auto bits = CompareMask(conditionLocal, AscendC::CMPMODE::NE, length);
+        WideSelect(yLocal, bits, x1Local, x2Local, length);
+    }
+
+    // 判断 condition 的前 length 个元素是否全为 1（TILE_ALL_TRUE）或全为 0（TILE_ALL_FALSE）。
+    // 结果需要标量单元读取，等待向量计算完成，同一个 Tile 的 x1 / x2 搬入会排在判断之后。
+    __aicore__ inline int32_t Classify(const AscendC::LocalTensor<uint8_t>& conditionLocal, uint32_t length)
+    {
+        auto work = B_reduce.Get<half>();
+        auto dst = B_reduce_dst.Get<half>();
+        AscendC::Cast(con_half, conditionLocal, AscendC::RoundMode::CAST_NONE, length);
+        AscendC::ReduceMax(dst, con_half, work, length, false);
+        AscendC::ReduceMin(dst[16], con_half, work, length, false);
+        event_t eventIdVToS = static_cast<event_t>(GetTPipePtr()->FetchEventID(AscendC::HardEvent::V_S));
+        AscendC::SetFlag<AscendC::HardEvent::V_S>(eventIdVToS);
+        AscendC::WaitFlag<AscendC::HardEvent::V_S>(eventIdVToS);
+        if (static_cast<float>(dst.GetValue(16)) != 0.0f) {
+            return TILE_ALL_TRUE;
+        }
+        if (static_cast<float>(dst.GetValue(0)) == 0.0f) {
+            return TILE_ALL_FALSE;
+        }
+        return TILE_MIXED;
+    }
+
+    // 一个输入为标量时：tensorLocal 为另一个输入（SELECT_SCALAR_X2 时为 x1，SELECT_SCALAR_X1 时为 x2）。
+    // 与张量版本同名，ElementwisePipeline 按流水线中的输入个数调用。
+    template<typename T>
+    __aicore__ inline void Compute(const AscendC::LocalTensor<TYPE_Y>& yLocal, const AscendC::LocalTensor<uint8_t>& conditionLocal,
+                                   const AscendC::LocalTensor<T>& tensorLocal, uint32_t length)
+    {
+        if constexpr (sizeof(TYPE_Y) == sizeof(uint8_t)) {
+            uint32_t pairLength = AlignUp(length, COPY_ALIGN_BYTES) / 2;
+            auto mask = ByteMask(conditionLocal, pairLength);
+            auto tensorPair = tensorLocal.template ReinterpretCast<int16_t>();
+            auto scalarPair = B_scalar.Get<int16_t>();
+            auto yPair = yLocal.template ReinterpretCast<int16_t>();
+            if constexpr (MODE == SELECT_SCALAR_X2) {
+                // y = (x1 & m) | (s & ~m)
+                AscendC::And(tensorPair, tensorPair, mask, pairLength);
+                AscendC::Not(mask, mask, pairLength);
+                AscendC::And(mask, mask, scalarPair, pairLength);
+                AscendC::Or(yPair, tensorPair, mask, pairLength);
+            } else {
+                // y = (s & m) | (x2 & ~m)
+                AscendC::And(yPair, mask, scalarPair, pairLength);
+                AscendC::Not(mask, mask, pairLength);
+                AscendC::And(tensorPair, tensorPair, mask, pairLength);
+                AscendC::Or(yPair, yPair, tensorPair, pairLength);
+            }
+            return;
+        }
+        // 掩码为 1 的位置取张量、为 0 的位置取标量：x1 为标量时按 condition == 0 取掩码。
+        auto bits = CompareMask(conditionLocal, MODE == SELECT_SCALAR_X2 ? AscendC::CMPMODE::NE : AscendC::CMPMODE::EQ,
+                                length);
+        if constexpr (MASK_LANES == 2) {
+            WideSelect(yLocal, bits, tensorLocal, B_scalar.Get<TYPE_Y>(), length);
+            return;
+        }
+        length = AlignUp(length, COPY_ALIGN_BYTES / sizeof(TYPE_Y));
+        TYPE_Y value = this->scalarValue;
+        if constexpr (sizeof(TYPE_Y) == sizeof(float)) {
+            AscendC::Select(yLocal.template ReinterpretCast<float>(), bits, tensorLocal.template ReinterpretCast<float>(),
+                            *reinterpret_cast<float*>(&value), AscendC::SELMODE::VSEL_TENSOR_SCALAR_MODE, length);
+        } else {
+            AscendC::Select(yLocal.template ReinterpretCast<half>(), bits, tensorLocal.template ReinterpretCast<half>(),
+                            *reinterpret_cast<half*>(&value), AscendC::SELMODE::VSEL_TENSOR_SCALAR_MODE, length);
+        }
+    }
+
+private:
+    // condition 转为 half 后与 0 比较，得到 Select 使用的按位掩码。
+    __aicore__ inline AscendC::LocalTensor<uint8_t> CompareMask(const AscendC::LocalTensor<uint8_t>& conditionLocal,
+                                                                AscendC::CMPMODE cmpMode, uint32_t length)
+    {
+        uint32_t cmpLength = AlignUp(length, COMPARE_ALIGN);
+        //将bool转换为half
+        AscendC::Cast(con_half, conditionLocal, AscendC::RoundMode::CAST_NONE, cmpLength);
+        if constexpr (MASK_LANES == 2) {
+            // ExpandMask 要求 0 / 1：k 为 64 的倍数等取值乘 0x3C003C00 后低 16 位为 0，两位掩码会不一致。
+            AscendC::Mins(con_half, con_half, static_cast<half>(1), cmpLength);
+            return ExpandMask(cmpMode, cmpLength);
+        }
+        auto bits = B_bits.Get<uint8_t>();  
+        AscendC::CompareScalar(bits, con_half, half(0), cmpMode, cmpLength);
+        return bits;
+    }
+
+    // 8 字节类型：con_half 中的 0 / 1（调用方已规整）转为 int32 后乘 0x3C003C00，按 half 看每个元素为两个相同的 0 / 1.0，
+    // 比较后每个元素对应 2 位掩码。cmpLength 是 COMPARE_ALIGN 的整数倍，2 * cmpLength 个 half 仍按 256 字节对齐。
+    __aicore__ inline AscendC::LocalTensor<uint8_t> ExpandMask(AscendC::CMPMODE cmpMode, uint32_t cmpLength)
+    {
+        auto conInt = B_con_int.Get<int32_t>();
+        AscendC::Cast(conInt, con_half, AscendC::RoundMode::CAST_ROUND, cmpLength);
+        AscendC::Muls(conInt, conInt, static_cast<int32_t>(0x3C003C00), cmpLength);
+        auto bits = B_bits.Get<uint8_t>();
+        AscendC::CompareScalar(bits, conInt.template ReinterpretCast<half>(), half(0), cmpMode, cmpLength * MASK_LANES);
+        return bits;
+    }
+
+    // 先经 half 与 1 取 Mins 把每个字节规整为 0 / 1（补齐的无效字节同样规整），
+    // 再乘 0xFF 得到 0x00 / 0xFF，不会向高字节进位，结果原地写回 conditionLocal。
+    __aicore__ inline AscendC::LocalTensor<int16_t> ByteMask(const AscendC::LocalTensor<uint8_t>& conditionLocal,
+                                                             uint32_t pairLength)
+    {
+        uint32_t byteLength = pairLength * 2;
+        AscendC::Cast(con_half, conditionLocal, AscendC::RoundMode::CAST_NONE, byteLength);
+        AscendC::Mins(con_half, con_half, static_cast<half>(1), byteLength);
+        AscendC::Cast(conditionLocal, con_half, AscendC::RoundMode::CAST_NONE, byteLength);
+        auto mask = conditionLocal.template ReinterpretCast<int16_t>();
+        AscendC::Muls(mask, mask, static_cast<int16_t>(0xFF), pairLength);
+        return mask;
+    }
+
+    // 2 / 4 / 8 字节类型按 half / float / 两个 float 解释后 Select，只搬运位；length 为元素个数，按 32 字节对齐后处理。
+    template<typename T1, typename T2>
+    __aicore__ inline void WideSelect(const AscendC::LocalTensor<TYPE_Y>& yLocal, const AscendC::LocalTensor<uint8_t>& bits,
+                                      const AscendC::LocalTensor<T1>& x1Local, const AscendC::LocalTensor<T2>& x2Local,
+                                      uint32_t length)
+    {
+        length = AlignUp(length, COPY_ALIGN_BYTES / sizeof(TYPE_Y)) * MASK_LANES;
+        if constexpr (sizeof(TYPE_Y) != sizeof(half)) {
+            AscendC::Select(yLocal.template ReinterpretCast<float>(), bits, x1Local.template ReinterpretCast<float>(),
+                            x2Local.template ReinterpretCast<float>(), AscendC::SELMODE::VSEL_TENSOR_TENSOR_MODE, length);
+        } else {
+            AscendC::Select(yLocal.template ReinterpretCast<half>(), bits, x1Local.template ReinterpretCast<half>(),
+                            x2Local.template ReinterpretCast<half>(), AscendC::SELMODE::VSEL_TENSOR_TENSOR_MODE, length);
+        }
+    }
+
+    // 1 字节类型：相邻两个元素看作一个 int16，按逐字节掩码 mask（0x00 / 0xFF）原地 And / Or，会改写 mask、x1、x2。
+    __aicore__ inline void ByteSelect(const AscendC::LocalTensor<TYPE_Y>& yLocal, const AscendC::LocalTensor<int16_t>& mask,
+                                      const AscendC::LocalTensor<TYPE_X1>& x1Local, const AscendC::LocalTensor<TYPE_X2>& x2Local,
+                                      uint32_t pairLength)
+    {
+        auto x1Pair = x1Local.template ReinterpretCast<int16_t>();
+        auto x2Pair = x2Local.template ReinterpretCast<int16_t>();
+        AscendC::And(x1Pair, x1Pair, mask, pairLength);
+        AscendC::Not(mask, mask, pairLength);
+        AscendC::And(x2Pair, x2Pair, mask, pairLength);
+        AscendC::Or(yLocal.template ReinterpretCast<int16_t>(), x1Pair, x2Pair, pairLength);
+    }
+
+    // condition 已打包为按位掩码：Tile 长度是 PACKED_UNIT 的整数倍，补齐部分的位无效，不影响有效结果。
+    __aicore__ inline void ComputePacked(const AscendC::LocalTensor<TYPE_Y>& yLocal, const AscendC::LocalTensor<uint8_t>& bits,
+                                         const AscendC::LocalTensor<TYPE_X1>& x1Local, const AscendC::LocalTensor<TYPE_X2>& x2Local,
+                                         uint32_t length)
+    {
+        if constexpr (sizeof(TYPE_Y) == sizeof(uint8_t)) {
+            uint32_t selLength = AlignUp(length, COMPARE_ALIGN);
+            auto maskHalf = B_mask_half.Get<half>();
+            auto mask = B_mask.Get<uint8_t>();
+            AscendC::Select(maskHalf, bits, B_full.Get<half>(), static_cast<half>(0),
+                            AscendC::SELMODE::VSEL_TENSOR_SCALAR_MODE, selLength);
+            AscendC::Cast(mask, maskHalf, AscendC::RoundMode::CAST_NONE, selLength);
+            ByteSelect(yLocal, mask.template ReinterpretCast<int16_t>(), x1Local, x2Local,
+                       AlignUp(length, COPY_ALIGN_BYTES) / 2);
+        } else if constexpr (MASK_LANES == 2) {
+            uint32_t selLength = AlignUp(length, COMPARE_ALIGN);
+            AscendC::Select(con_half, bits, B_full.Get<half>(), static_cast<half>(0),
+                            AscendC::SELMODE::VSEL_TENSOR_SCALAR_MODE, selLength);
+            WideSelect(yLocal, ExpandMask(AscendC::CMPMODE::NE, selLength), x1Local, x2Local, length);
+        } else {
+            WideSelect(yLocal, bits, x1Local, x2Local, length);
+        }
+    }
+
+    uint32_t tileLength;
+    TYPE_Y scalarValue;
+    AscendC::TBuf<AscendC::QuePosition::VECCALC> B_con_half, B_bits, B_con_int;
+    AscendC::TBuf<AscendC::QuePosition::VECCALC> B_full, B_mask_half, B_mask;
+    AscendC::TBuf<AscendC::QuePosition::VECCALC> B_scalar;
+    AscendC::TBuf<AscendC::QuePosition::VECCALC> B_reduce, B_reduce_dst;
+    AscendC::LocalTensor<half> con_half;
+};
+
+#endif  // SELECT_COMPUTE_H
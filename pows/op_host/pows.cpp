@@ -2,157 +2,128 @@
 #include "pows_tiling.h"
 #include "register/op_def_registry.h"
 #include "tiling/platform/platform_ascendc.h"
+#include "../../common/include/op_profile_layout.h"
+#include "../../common/op_host/tiling_cache.h"
+#include "../../common/op_host/broadcast_planner.h"
+#include "../../common/op_host/broadcast_shape.h"
+#include "../../common/op_host/op_log.h"
+#include "../../common/op_host/elementwise_tiling.h"
+#include "pows_plan.h"
 
 
 namespace optiling {
-const uint32_t BLOCK_SIZE = 32;
-static ge::graphStatus TilingFunc(gert::TilingContext* context)
+const uint32_t MAX_DIM_NUM = BroadcastPlanner::MAX_DIM_NUM;
+const size_t TILING_CACHE_CAPACITY = 256;
+
+static ge::graphStatus ComputeTiling(gert::TilingContext* context)
 {
 
   PowsTilingData tiling;
 
-  uint32_t sizeofdatatype;
-  int32_t NUM = 24;
-
   auto ascendcPlatform = platform_ascendc::PlatformAscendC(context->GetPlatformInfo());
   auto socVersion = ascendcPlatform.GetSocVersion();
   uint64_t ub_size;
   ascendcPlatform.GetCoreMemSize(platform_ascendc::CoreMemType::UB, ub_size); 
   auto aivNum = ascendcPlatform.GetCoreNum();
-  uint32_t input_num=2;
-  uint32_t expend_max_dim=10;
-  //用于存维度数
-  uint32_t shapeInf[input_num * expend_max_dim] = {};
-  uint32_t inputLength[input_num] = {};
-  uint32_t length = 0;  
-  // 获取最大维度数
-  for (int i = 0; i < input_num; ++i) 
-      length = std::max<uint32_t>(length, context->GetInputShape(i)->GetStorageShape().GetDimNum());
-  // 获取输入形状，维度数，以及输入数据大小
-  for (int i = 0; i < input_num; ++i) { 
-      const gert::StorageShape* shape = context->GetInputShape(i);
-      inputLength[i] = context->GetInputTensor(i)->GetShapeSize();        
-      shapeInf[i*expend_max_dim+0]=shape->GetStorageShape().GetDimNum();             
-      for (int j = 1; j <= shape->GetStorageShape().GetDimNum(); j++) {  
-          shapeInf[i*expend_max_dim+j] = shape->GetStorageShape().GetDim(j-1);                   
-      } 
-  }  
-  // 获取最大元素值
-  uint32_t total_length = 0;
-  for (int i = 0; i < input_num; ++i) {  
-      total_length = std::max<uint32_t>(total_length, context->GetInputTensor(i)->GetShapeSize());
-  }    
-  //判断是否需要广播
-  int32_t boardCast = 1;    
-  if (inputLength[0] != total_length ||       
-      inputLength[1] != total_length ) {    
-      boardCast = 2;  
-  }  
-  context->SetTilingKey(boardCast);
-  //用于存数据元素个数
-  uint32_t totalLength = total_length;
+  // 合并两个输入的广播形状，得到合并后的输出形状与 x1/x2 的步长（广播维步长为 0）
+  BroadcastPlanner planner;
+  planner.AddInput(context->GetInputShape(0)->GetStorageShape());
+  planner.AddInput(context->GetInputShape(1)->GetStorageShape());
+  if (!planner.Plan()) {
+      return ge::GRAPH_FAILED;
+  }
+  // 可选属性 sign_aware：按 std::pow 语义处理负底数与 0/1 等特殊值，TilingKey 加 10。
+  const gert::RuntimeAttrs* attrs = context->GetAttrs();
+  const bool* signAwareAttr = attrs->GetAttrPointer<bool>(0);
+  bool sign_aware = (signAwareAttr != nullptr) && *signAwareAttr;
   
-  // 获取第一个输入的数据类型。
-  auto inputx1 = context->GetInputTensor(0)->GetDataType();
-  uint32_t tmp_x = 2;
-  if (inputx1 == ge::DT_FLOAT16) {
-      // 设置数据类型大小为 2 字节。
-      sizeofdatatype = 2;
-      // 将经验参数 NUM 调整为 9。
-      NUM = 6;
-  // 如果数据类型是 INT32 (ge::DT_INT32)。
-  } else if (inputx1 == ge::DT_FLOAT) {
-      // 默认设置数据类型大小为 2 字节。
-      sizeofdatatype = 4;
-      // 默认将经验参数 NUM 调整为 9。
-      NUM = 4;
-  } else if (inputx1 == ge::DT_BF16) {
-    // 默认设置数据类型大小为 2 字节。
-    sizeofdatatype = 2;
-    // 默认将经验参数 NUM 调整为 9。
-    NUM = 6;
-  } else { 
-      // 默认设置数据类型大小为 2 字节。
-      sizeofdatatype = 2;
-      // 默认将经验参数 NUM 调整为 9。
-      NUM = 6;
+  // 获取第一个输入的数据类型：float 为 4 字节，float16 / bf16 为 2 字节。
+  uint32_t sizeofdatatype = (context->GetInputDesc(0)->GetDataType() == ge::DT_FLOAT) ? 4 : 2;
+  // 分支、Tile 大小、队列深度与核间切分见 pows_plan.h。
+  PowsTilingPlan plan;
+  if (!PlanPowsTiling(planner, sizeofdatatype, sign_aware, ub_size, aivNum, plan)) {
+      return ge::GRAPH_FAILED;
   }
-  uint8_t ALIGN_NUM = BLOCK_SIZE / sizeofdatatype;
-  uint32_t tiling_size = ((ub_size) / BLOCK_SIZE / 2) / NUM;  // tmp_x固定为2
-  tiling_size = tiling_size <= 8 ? tiling_size : (tiling_size / 8) * 8;
-  uint32_t block_size = tiling_size * ALIGN_NUM;
-//   // 计算 ALIGN_NUM：一个 BLOCK_SIZE (32 字节) 可以容纳多少个当前数据类型的元素。
-//   // 这是数据对齐的基本单位（元素个数）。
-//   uint8_t ALIGN_NUM = BLOCK_SIZE / sizeofdatatype;
-//   // 计算 tiling_size：这是 Tiling 的核心参数之一。
-//   // 它估算在 UB 内存限制下，单次处理（或单核单次迭代）可以处理多少个 BLOCK_SIZE 块。
-//   // (总 UB 大小 / 每个块大小 / 调整因子 tmp_x) / 经验参数 NUM
-//   uint32_t tiling_size = ((ub_size) / BLOCK_SIZE / tmp_x) / NUM;
-//   // 调整 tiling_size：如果 tiling_size 大于 8，则将其向下取整到最近的 8 的倍数。
-//   // 这通常是为了匹配硬件的向量处理能力（例如，一次处理 8 个向量）。
-//   tiling_size = tiling_size <= 8 ? tiling_size : tiling_size / 8 * 8;
-//   // 计算 block_size：将 tiling_size（块的数量）乘以 ALIGN_NUM（每块的元素数），
-//   // 得到核函数内部处理的基本数据块的大小（单位：元素数量）。
-//   uint32_t block_size = tiling_size * ALIGN_NUM;
-//   // 调整要使用的 AI Core 数量 aivNum：
-//   // 取“物理可用核心数”和“总工作量 / 每个块的大小 所需的块数”中的较小值。
-//   // 防止分配的核心数超过实际工作所需的数量。
-  aivNum = (aivNum < totalLength / block_size) ? aivNum : (totalLength / block_size);
-  aivNum = aivNum >= 1 ? aivNum : 1;
-
-  // 计算 core_size：每个 AI Core 负责处理的主要（对齐）部分的数据量（单位：元素数量）。
-  // (总元素数 / 使用的核心数) 先得到每个核心大致处理量，
-  // 然后除以 (ALIGN_NUM * 8) 再乘以 (ALIGN_NUM * 8)，实现向下对齐到 ALIGN_NUM * 8 的倍数。
-  // ALIGN_NUM * 8 可能是一个更优的处理粒度。
-  uint32_t core_size = (totalLength / aivNum) / (ALIGN_NUM * 8) * (ALIGN_NUM * 8);
-  // 计算 core_remain：总元素数量减去所有核心处理的对齐部分的总和，
-  // 得到剩余的、未能被对齐处理的元素数量。这些通常需要特殊处理。
-  uint32_t core_remain = totalLength - aivNum * core_size;
-
-  // 将计算出的 ALIGN_NUM 保存到 tiling 对象中。
-  tiling.set_ALIGN_NUM(ALIGN_NUM);
-
-  // 将计算出的核内处理块大小 block_size 保存到 tiling 对象中。
-  tiling.set_block_size(block_size);
-
-  // 将计算出的每个核心主要处理量 core_size 保存到 tiling 对象中。
-  tiling.set_core_size(core_size);
-
-  // 将计算出的剩余元素数量 core_remain 保存到 tiling 对象中。
-  tiling.set_core_remain(core_remain);
-
-  // 将之前获取并存储的输入形状信息 shapeInf 保存到 tiling 对象中。
-  tiling.set_shapeInf(shapeInf);
+  uint32_t tiling_key = plan.tilingKey;
+  aivNum = plan.blockDim;
+
+  // 将 ALIGN_NUM、block_size、核间切分、合并后的形状与步长、广播分支的 Tile 划分保存到 tiling 对象中。
+  FillPowsTilingData(planner, plan, tiling);
 
+  context->SetTilingKey(tiling_key);
   context->SetBlockDim(aivNum);
   tiling.SaveToBuffer(context->GetRawTilingData()->GetData(), context->GetRawTilingData()->GetCapacity());
   context->GetRawTilingData()->SetDataSize(tiling.GetDataSize());
   // 获取用于设置 Workspace（工作空间，临时内存）大小的数组指针。参数 1 表示需要 1 个 Workspace 区域。
   size_t *currentWorkspace = context->GetWorkspaceSizes(1);
 
-  // 设置第一个（也是唯一一个）Workspace 的大小为 0。
-  // 表示根据当前的 Tiling 计算，该算子执行不需要额外的临时内存。
-  currentWorkspace[0] = 0;
+  // 算子本身不需要额外的临时内存；开启 OP_PROFILING 时在系统 workspace 之后为每个核预留打点区域。
+  uint64_t profileSize = OpProfileWorkspaceSize(aivNum);
+  currentWorkspace[0] = profileSize == 0 ? 0 : ascendcPlatform.GetLibApiWorkSpaceSize() + profileSize;
 
   return ge::GRAPH_SUCCESS;
 }
+
+static TilingPlanCache& PlanCache()
+{
+  static TilingPlanCache cache(TILING_CACHE_CAPACITY);
+  return cache;
+}
+
+// 切分结果只取决于输入形状、dtype、sign_aware 属性与平台信息，相同签名直接复用缓存的 TilingData。
+static ge::graphStatus TilingFunc(gert::TilingContext* context)
+{
+  auto ascendcPlatform = platform_ascendc::PlatformAscendC(context->GetPlatformInfo());
+  uint64_t ub_size;
+  ascendcPlatform.GetCoreMemSize(platform_ascendc::CoreMemType::UB, ub_size);
+  const gert::RuntimeAttrs* attrs = context->GetAttrs();
+  const bool* signAwareAttr = attrs->GetAttrPointer<bool>(0);
+
+  TilingSignature signature;
+  signature.AppendShape(context->GetInputShape(0)->GetStorageShape())
+           .AppendShape(context->GetInputShape(1)->GetStorageShape())
+           .Append(context->GetInputDesc(0)->GetDataType())
+           .Append((signAwareAttr != nullptr) && *signAwareAttr)
+           .Append(static_cast<int64_t>(ascendcPlatform.GetSocVersion()))
+           .Append(ascendcPlatform.GetCoreNum())
+           .Append(static_cast<int64_t>(ub_size));
+
+  if (PlanCache().LookupAndApply(signature, context)) {
+    return ge::GRAPH_SUCCESS;
+  }
+  ge::graphStatus ret = ComputeTiling(context);
+  TilingPlan plan;
+  if (ret == ge::GRAPH_SUCCESS && CaptureTilingPlan(context, plan)) {
+    PlanCache().Insert(signature, plan);
+  }
+  return ret;
+}
 }
 
 
 namespace ge {
+// y 为 x1、x2 按 NumPy 规则广播后的形状，维度数超限或形状不兼容时推导失败，日志中给出出错的输入与各输入的形状。
 static ge::graphStatus InferShape(gert::InferShapeContext* context)
 {
-    const gert::Shape* x1_shape = context->GetInputShape(0);
+    static const char* const NAMES[] = {"x1", "x2"};
+    const gert::Shape* inputs[] = {context->GetInputShape(0), context->GetInputShape(1)};
     gert::Shape* y_shape = context->GetOutputShape(0);
-    *y_shape = *x1_shape;
+    BroadcastShapeError error;
+    BroadcastShapeStatus status =
+        InferBroadcastShape(inputs, 2, optiling::BroadcastPlanner::MAX_INPUT_DIM_NUM, *y_shape, &error);
+    if (status != BroadcastShapeStatus::OK) {
+        OP_HOST_LOGE("Pows", "InferShape failed: %s", BroadcastShapeMessage(NAMES, inputs, 2, 0,
+                     optiling::BroadcastPlanner::MAX_INPUT_DIM_NUM, status, error).c_str());
+        return GRAPH_FAILED;
+    }
     return GRAPH_SUCCESS;
 }
-// static ge::graphStatus InferDataType(gert::InferDataTypeContext *context)
-// {
-// const auto inputDataType = context->GetInputDataType(0);
-// context->SetOutputDataType(0, inputDataType);
-// return ge::GRAPH_SUCCESS;
-// }
+static ge::graphStatus InferDataType(gert::InferDataTypeContext *context)
+{
+    const auto inputDataType = context->GetInputDataType(0);
+    context->SetOutputDataType(0, inputDataType);
+    return ge::GRAPH_SUCCESS;
+}
 }
 
 
@@ -176,13 +147,22 @@ public:
             .DataType({ge::DT_FLOAT, ge::DT_FLOAT16, ge::DT_BF16})
             .Format({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND})
             .UnknownShapeFormat({ge::FORMAT_ND, ge::FORMAT_ND, ge::FORMAT_ND});
-
-        // this->SetInferShape(ge::InferShape).SetInferDataType(ge::InferDataType);
-        this->SetInferShape(ge::InferShape);
+        this->Attr("sign_aware").AttrType(OPTIONAL).Bool(false);
+        // y 可以与 x1 或 x2 共用同一块内存（原地执行）。该输入与 y 同形状时各核并行，每个元素都在写回之前读取；
+        // 该输入被广播或为标量时，核函数比较 GM 地址后改为 0 号核串行处理（广播分支按 Tile 倒序），保证结果正确。
+        this->SetInferShape(ge::InferShape).SetInferDataType(ge::InferDataType);
 
         this->AICore()
             .SetTiling(optiling::TilingFunc);
-        this->AICore().AddConfig("ascend310b");
+        // 动态 shape：核函数按 dtype / TilingKey 只编译一次，shape 变化时只需重新调用 TilingFunc。
+        OpAICoreConfig aicConfig;
+        aicConfig.DynamicCompileStaticFlag(true)
+            .DynamicFormatFlag(false)
+            .DynamicRankSupportFlag(true)
+            .DynamicShapeSupportFlag(true)
+            .NeedCheckSupportFlag(false)
+            .PrecisionReduceFlag(true);
+        this->AICore().AddConfig("ascend310b", aicConfig);
 
     }
 };
@@ -0,0 +1,151 @@
+#ifndef POWS_PLAN_H
+#define POWS_PLAN_H
+
+#include <algorithm>
+#include <cstdint>
+#include "../../common/op_host/ub_planner.h"
+#include "../../common/op_host/broadcast_planner.h"
+#include "../../common/op_host/elementwise_tiling.h"
+#include "../../common/op_host/tuned_tiling.h"
+
+namespace optiling {
+// Pows 的切分方案只取决于合并后的形状、dtype 宽度、sign_aware 属性与平台的 UB 大小和核数，
+// 这里不依赖 TilingContext，TilingFunc 与 tools 中的 CPU 仿真基准共用同一套计算。
+
+// 核函数的分支，TilingKey 在此基础上 sign_aware 时加 10、三缓冲时加 TILING_KEY_TRIPLE_BUFFER。
+const int32_t POWS_BRANCH_TENSOR = 1;       // x1、x2 同形状，逐元素
+const int32_t POWS_BRANCH_BROADCAST = 2;    // 需要广播
+const int32_t POWS_BRANCH_SCALAR_EXP = 3;   // 指数 x2 只有一个元素
+const uint32_t POWS_KEY_SIGN_AWARE = 10;
+
+struct PowsTilingPlan {
+  int32_t branch;
+  uint32_t tilingKey;
+  uint8_t alignNum;      // 一个 32 字节块容纳的元素数
+  uint32_t blockSize;    // 单个 Tile 的元素数
+  uint32_t blockDim;     // 使用的核数
+  uint32_t depth;        // 队列深度
+  ElementwiseSplit split;      // 连续分支的核间切分
+  BroadcastRowSplit rows;      // 广播分支的行切分
+  uint64_t ubBytes;      // 按 blockSize 实际申请的 UB 字节数
+};
+
+// 各核函数的 UB 占用，需与 op_kernel/pows.cpp 中的 InitBuffer 保持一致：
+//   队列：x1、y，以及逐元素指数分支的 x2，各 depth 块（连续分支可选三缓冲，广播分支为双缓冲）；
+//   PowsCompute：half/bf16 需要 x1、x2 的 float 中间结果，sign-aware 另需 y 的 float 中间结果；
+//   PowsScalarCompute：half/bf16 需要 x1、y 的 float 中间结果；
+//   PowsSignFixup：3 个 float/int32 临时 Buffer 与 4 个按位掩码。
+inline UbPlanner PowsUbPlan(int32_t branch, bool sign_aware, uint32_t sizeofdatatype, uint32_t depth)
+{
+  bool computeInFloat = (sizeofdatatype != sizeof(float));
+  UbPlanner planner;
+  planner.Queue(sizeofdatatype, depth).Queue(sizeofdatatype, depth);
+  if (branch == POWS_BRANCH_SCALAR_EXP) {
+    if (computeInFloat) {
+      planner.Buffer(sizeof(float), 2);
+    }
+  } else {
+    planner.Queue(sizeofdatatype, depth);
+    if (computeInFloat) {
+      planner.Buffer(sizeof(float), sign_aware ? 3 : 2);
+    }
+  }
+  if (sign_aware) {
+    planner.Buffer(sizeof(float), 3).BitMask(4);
+  }
+  return planner;
+}
+
+inline uint32_t PowsTileLength(uint64_t ub_size, int32_t branch, bool sign_aware, uint32_t sizeofdatatype,
+                               uint32_t align, uint32_t depth = PIPELINE_DEPTH_DOUBLE)
+{
+  return PowsUbPlan(branch, sign_aware, sizeofdatatype, depth).TileLength(ub_size, align);
+}
+
+// sizeofdatatype 为 4（float）或 2（half / bf16）。输出元素数超过 UINT32_MAX（TilingData 按 uint32 记录长度）
+// 或 UB 放不下最小的 Tile 时返回 false。
+// tuned 为 nullptr 时查 tuned_tiling_table.h，未命中按公式计算；tools/tiling_autotune 传入候选方案直接评估。
+inline bool PlanPowsTiling(const BroadcastPlanner& planner, uint32_t sizeofdatatype, bool sign_aware,
+                           uint64_t ub_size, uint32_t coreNum, PowsTilingPlan& plan,
+                           const TunedTiling* tuned = nullptr)
+{
+  if (planner.OutSize() > UINT32_MAX) {
+    return false;
+  }
+  uint32_t totalLength = static_cast<uint32_t>(planner.OutSize());
+  // 合并后两个输入都与输出同形状时，整块数据是连续的。
+  plan.branch = planner.AllFull() ? POWS_BRANCH_TENSOR : POWS_BRANCH_BROADCAST;
+  // 指数 x2 只有一个元素时走标量指数分支：核函数只搬入 x1，并按指数取值选择平方、开方、倒数等计算方式。
+  if (planner.IsScalar(1)) {
+    plan.branch = POWS_BRANCH_SCALAR_EXP;
+  }
+  // 输出为空时没有需要广播的数据，按连续分支处理。
+  if (totalLength == 0) {
+    plan.branch = POWS_BRANCH_TENSOR;
+  }
+  plan.tilingKey = sign_aware ? plan.branch + POWS_KEY_SIGN_AWARE : plan.branch;
+  plan.alignNum = static_cast<uint8_t>(COPY_BLOCK_BYTES / sizeofdatatype);
+  plan.depth = PIPELINE_DEPTH_DOUBLE;
+  plan.split = {0, 0, 0, 0};
+  plan.rows = {0, 0, 0};
+  const TunedTiling formula = {};
+  if (tuned == nullptr) {
+    tuned = FindTunedTiling(TUNE_OP_POWS, sizeofdatatype, plan.tilingKey, TuneClassOf(planner, 2), totalLength,
+                            ub_size, coreNum);
+  }
+  const TunedTiling& choice = tuned != nullptr ? *tuned : formula;
+  // 按当前分支实际申请的 Buffer 求 UB 能容纳的最大 Tile，向下对齐到 alignNum * 8 个元素（256 字节），
+  // 与 Compare 等接口的对齐要求一致。
+  uint32_t align = plan.alignNum * 8;
+  plan.blockSize = PowsTileLength(ub_size, plan.branch, sign_aware, sizeofdatatype, align);
+  if (plan.blockSize == 0) {
+    return false;
+  }
+  if (plan.branch != POWS_BRANCH_BROADCAST) {
+    // 核间切分的最小粒度：alignNum * 8 个元素（256 字节），保证每个核的 GM 起始地址 32 字节对齐。
+    plan.split = SplitElementwise(totalLength, TunedCoreNum(choice, coreNum), align);
+    plan.blockDim = plan.split.coreNum;
+    // 每核的 Tile 足够多时改用三缓冲：Ln / Exp 为主的计算与搬入、搬出能更好地重叠。
+    auto tileLengthOf = [&](uint32_t depth) {
+      return PowsTileLength(ub_size, plan.branch, sign_aware, sizeofdatatype, align, depth);
+    };
+    plan.depth = TunedPipelineDepth(choice, plan.split.coreSize, sizeofdatatype, tileLengthOf, plan.blockSize);
+    plan.blockSize = TunedTileLength(choice, plan.blockSize, align);
+    if (plan.depth == PIPELINE_DEPTH_TRIPLE) {
+      plan.tilingKey += TILING_KEY_TRIPLE_BUFFER;
+    }
+  } else {
+    // 广播分支每行在 UB 中按 alignNum 个元素补齐。
+    plan.blockSize = TunedTileLength(choice, plan.blockSize, align);
+    uint32_t rowLength = planner.OutShape()[planner.DimNum() - 1];
+    plan.rows = SplitBroadcastRows(totalLength, rowLength, plan.alignNum, plan.blockSize);
+    plan.blockDim = BroadcastCoreNum(TunedCoreNum(choice, coreNum), plan.rows);
+  }
+  plan.ubBytes = PowsUbPlan(plan.branch, sign_aware, sizeofdatatype, plan.depth).UsedBytes(plan.blockSize);
+  return true;
+}
+
+// 按切分方案填写 PowsTilingData（TilingDataT），TilingFunc 与 tools/tiling_cache_bench 共用。
+template <typename TilingDataT>
+inline void FillPowsTilingData(const BroadcastPlanner& planner, const PowsTilingPlan& plan, TilingDataT& tiling)
+{
+  const uint32_t MAX_DIM = BroadcastPlanner::MAX_DIM_NUM;
+  tiling.set_ALIGN_NUM(plan.alignNum);
+  tiling.set_block_size(plan.blockSize);
+  // 连续分支的核间切分 core_size / core_remain / core_tail。
+  SetElementwiseSplit(tiling, plan.split);
+  // 合并后的输出形状、x1/x2 的步长与广播分支的 Tile 划分。
+  tiling.set_dim_num(planner.DimNum());
+  uint32_t y_dims[MAX_DIM];
+  std::copy(planner.OutShape(), planner.OutShape() + MAX_DIM, y_dims);
+  tiling.set_y_shape(y_dims);
+  uint32_t strides[2 * MAX_DIM];
+  std::copy(planner.Strides(0), planner.Strides(0) + MAX_DIM, strides);
+  std::copy(planner.Strides(1), planner.Strides(1) + MAX_DIM, strides + MAX_DIM);
+  tiling.set_strides(strides);
+  tiling.set_row_tile(plan.rows.rowTile);
+  tiling.set_col_tile(plan.rows.colTile);
+}
+}
+
+#endif  // POWS_PLAN_H
@@ -1,315 +1,459 @@
 #include "kernel_operator.h"
+#include "op_profiler.h"
+#include "copy_utils.h"
+#include "broadcast_indexer.h"
+#include "broadcast_tile.h"
+#include "pows_compute.h"
+#include "elementwise_pipeline.h"
 
 constexpr int32_t BUFFER_NUM = 2;     // 使用双缓冲 (每个队列有 2 个 Buffer)
+constexpr int32_t MAX_DIM_NUM = 8;    // 与 TilingFunc 中合并后形状的最大维度数一致
+
+// 标量转换为 float，bf16 需要通过 ToFloat 转换。
+template<typename T>
+__aicore__ inline float ScalarToFloat(T value)
+{
+    if constexpr (std::is_same_v<T, bfloat16_t>) {
+        return AscendC::ToFloat(value);
+    } else {
+        return static_cast<float>(value);
+    }
+}
+
+// 标量指数的计算方式，由指数取值在 SetExponent 中确定一次，Tile 循环内不再判断。
+enum class ScalarExpMode : uint8_t {
+    ONE,          // x ** 0 = 1
+    COPY,         // x ** 1 = x
+    SQUARE,       // x ** 2 = x * x
+    SQRT,         // x ** 0.5
+    RSQRT,        // x ** -0.5
+    RECIPROCAL,   // x ** -1
+    INTEGER,      // 小整数指数：平方-乘法
+    GENERAL       // 其他指数：exp(e * ln(x))
+};
+constexpr int32_t MAX_INT_EXPONENT = 32;   // 绝对值不超过该值的整数指数走平方-乘法
 
-template<typename TYPE_X1, typename TYPE_X2, typename TYPE_Y> class Kernel_Powsx {
+// 指数 x2 为单个标量时的 Pows 计算：避开 Ln/Exp，并且不需要搬入 x2。
+// half / bf16 先转换为 float 计算，结果再转换回原类型。
+// 整数指数按乘法计算，负底数的符号天然正确；SIGN_AWARE 修正 GENERAL 分支，以及 SQRT / RSQRT 对 -0.0、-inf 的结果。
+template<typename TYPE_X1, typename TYPE_Y, bool SIGN_AWARE = false> class PowsScalarCompute {
 public:
-    __aicore__ inline Kernel_Powsx() {}
+    __aicore__ inline PowsScalarCompute() {}
 
-    // ALIGN_NUM：一个 BLOCK_SIZE (32 字节) 可以容纳多少个当前数据类型的元素。
-    __aicore__ inline void Init(GM_ADDR x1, GM_ADDR x2, GM_ADDR y,
-                                uint8_t ALIGN_NUM, uint32_t block_size, uint32_t core_size, uint32_t core_remain)
+    __aicore__ inline void Init(AscendC::TPipe& pipe, uint32_t tileLength)
     {
-        this->blockLength = core_size + core_remain;
-        this->tileLength = block_size;
-        // 将blocklength长度对齐为32字节
-        this->blockLength = this->blockLength + (this->blockLength % ALIGN_NUM ? ALIGN_NUM - this->blockLength % ALIGN_NUM : 0); 
-
-        x1Gm.SetGlobalBuffer((__gm__ TYPE_X1*)x1, this->blockLength);
-        x2Gm.SetGlobalBuffer((__gm__ TYPE_X2*)x2, this->blockLength);
-        yGm.SetGlobalBuffer((__gm__ TYPE_Y*)y, this->blockLength);
-
-        // 计算需要处理的 Tile 数量 (tileNum)。如果 blockLength 不能被 tileLength 整除，则加 1 处理剩余部分。
-        this->tileNum = this->blockLength / this->tileLength + (this->blockLength % this->tileLength > 0);
-
-        pipe.InitBuffer(inQueueX1, BUFFER_NUM, this->tileLength * sizeof(TYPE_X1));
-        pipe.InitBuffer(inQueueX2, BUFFER_NUM, this->tileLength * sizeof(TYPE_X2));
-        pipe.InitBuffer(outQueueY, BUFFER_NUM, this->tileLength * sizeof(TYPE_Y));
-
-        if constexpr (std::is_same_v<TYPE_Y, float16_t>) {
-            pipe.InitBuffer(B_x1, this->tileLength * sizeof(float32_t));
-            pipe.InitBuffer(B_x2, this->tileLength * sizeof(float32_t));
-            pipe.InitBuffer(B_y, this->tileLength * sizeof(float32_t));
+        // float 直接在输入/输出队列的 Tensor 上计算，half / bf16 需要 float 中间结果。
+        if constexpr (!std::is_same_v<TYPE_Y, float32_t>) {
+            pipe.InitBuffer(B_x1, tileLength * sizeof(float));
+            pipe.InitBuffer(B_y, tileLength * sizeof(float));
         }
-        else if constexpr (std::is_same_v<TYPE_Y, float32_t>) {
-            pipe.InitBuffer(B_x1, this->tileLength * sizeof(float32_t));
-        }
-        else if constexpr (std::is_same_v<TYPE_Y, bfloat16_t>) {
-            pipe.InitBuffer(B_x1, this->tileLength * sizeof(float));
-            pipe.InitBuffer(B_x2, this->tileLength * sizeof(float));
-            pipe.InitBuffer(B_y, this->tileLength * sizeof(float));
-            pipe.InitBuffer(f_x1_16, this->tileLength * sizeof(float));
-            pipe.InitBuffer(f_x2_16, this->tileLength * sizeof(float));
-            pipe.InitBuffer(f_y_16, this->tileLength * sizeof(float));
+        if constexpr (SIGN_AWARE) {
+            fixup.Init(pipe, tileLength);
         }
+    }
 
+    // 指数在 Init 之后设置一次，Tile 循环内不再判断。
+    __aicore__ inline void SetExponent(float exponent)
+    {
+        this->exponent = exponent;
+        this->intExponent = 0;
+        if (exponent == 0.0f) {
+            this->mode = ScalarExpMode::ONE;
+        } else if (exponent == 1.0f) {
+            this->mode = ScalarExpMode::COPY;
+        } else if (exponent == 2.0f) {
+            this->mode = ScalarExpMode::SQUARE;
+        } else if (exponent == 0.5f) {
+            this->mode = ScalarExpMode::SQRT;
+        } else if (exponent == -0.5f) {
+            this->mode = ScalarExpMode::RSQRT;
+        } else if (exponent == -1.0f) {
+            this->mode = ScalarExpMode::RECIPROCAL;
+        } else if (exponent >= -MAX_INT_EXPONENT && exponent <= MAX_INT_EXPONENT &&
+                   static_cast<float>(static_cast<int32_t>(exponent)) == exponent) {
+            // 先确认指数有限且在范围内再转换为整数，NaN、±inf 与超出 int32 的值直接转换是未定义行为。
+            this->intExponent = static_cast<int32_t>(exponent);
+            this->mode = ScalarExpMode::INTEGER;
+        } else {
+            this->mode = ScalarExpMode::GENERAL;
+        }
+    }
 
+    // x1Local 在计算过程中可能被改写（平方-乘法中作为底数累乘）。
+    __aicore__ inline void Compute(const AscendC::LocalTensor<TYPE_Y>& yLocal, const AscendC::LocalTensor<TYPE_X1>& x1Local,
+                                   uint32_t length)
+    {
+        if constexpr (std::is_same_v<TYPE_Y, float32_t>) {
+            ComputeFloat(yLocal, x1Local, length);
+        } else {
+            auto tmp_x1 = B_x1.Get<float>();
+            auto tmp_y = B_y.Get<float>();
+            AscendC::Cast(tmp_x1, x1Local, AscendC::RoundMode::CAST_NONE, length);
+            ComputeFloat(tmp_y, tmp_x1, length);
+            if constexpr (std::is_same_v<TYPE_Y, bfloat16_t>) {
+                AscendC::Cast(yLocal, tmp_y, AscendC::RoundMode::CAST_ROUND, length);
+            } else {
+                AscendC::Cast(yLocal, tmp_y, AscendC::RoundMode::CAST_NONE, length);
+            }
+        }
     }
 
-    // 核心处理函数：实现标准的三级双缓冲流水线 (CopyIn -> Compute -> CopyOut)
-    __aicore__ inline void Process()
+private:
+    __aicore__ inline void ComputeFloat(const AscendC::LocalTensor<float>& dst, const AscendC::LocalTensor<float>& base,
+                                        uint32_t length)
     {
-        int32_t loopCount = this->tileNum;
-        // 循环处理除了最后一个 Tile 之外的所有完整 Tile。
-        for (int32_t i = 0; i < loopCount-1; i++) {
-            // AscendC::printf("++++++++++++++++++++++++++++++this is times:[%d/%d] loop+++++++++++++++++++++++++++++++\n", i, loopCount-2);
-            CopyIn(i, this->tileLength);
-            Compute(i, this->tileLength);
-            CopyOut(i, this->tileLength);
+        switch (this->mode) {
+            case ScalarExpMode::ONE:
+                AscendC::Duplicate(dst, 1.0f, length);
+                break;
+            case ScalarExpMode::COPY:
+                AscendC::Muls(dst, base, 1.0f, length);
+                break;
+            case ScalarExpMode::SQUARE:
+                AscendC::Mul(dst, base, base, length);
+                break;
+            case ScalarExpMode::SQRT:
+                if constexpr (SIGN_AWARE) {
+                    AscendC::Sqrt(dst, fixup.UnsignedZero(base, length), length);
+                    fixup.ApplyNegInf(dst, base, BitsToFloat(FLOAT_INF_BITS), length);
+                } else {
+                    AscendC::Sqrt(dst, base, length);
+                }
+                break;
+            case ScalarExpMode::RSQRT:
+                if constexpr (SIGN_AWARE) {
+                    AscendC::Rsqrt(dst, fixup.UnsignedZero(base, length), length);
+                    fixup.ApplyNegInf(dst, base, 0.0f, length);
+                } else {
+                    AscendC::Rsqrt(dst, base, length);
+                }
+                break;
+            case ScalarExpMode::RECIPROCAL:
+                AscendC::Reciprocal(dst, base, length);
+                break;
+            case ScalarExpMode::INTEGER:
+                PowerBySquaring(dst, base, length);
+                break;
+            default:
+                if constexpr (SIGN_AWARE) {
+                    AscendC::Ln(dst, fixup.AbsBase(base, length), length);
+                    AscendC::Muls(dst, dst, this->exponent, length);
+                    AscendC::Exp(dst, dst, length);
+                    fixup.ApplyScalar(dst, base, this->exponent, length);
+                } else {
+                    AscendC::Ln(dst, base, length);
+                    AscendC::Muls(dst, dst, this->exponent, length);
+                    AscendC::Exp(dst, dst, length);
+                }
+                break;
         }
+    }
 
-        uint32_t length = this->blockLength - this->tileLength * (loopCount - 1);
-        // AscendC::printf("++++++++++++++++++++++++++++++this is times:[%d/%d] loop+++++++++++++++++++++++++++++++\n", loopCount-1, loopCount-1);
-        CopyIn(loopCount - 1, (length + 31) / 32 * 32);
-        Compute(loopCount - 1, (length + 31) / 32 * 32);
-        // 拷贝最后一个 Tile 的计算结果回 GM。
-        // 注意：拷贝长度向上对齐到 32 的倍数，因为 DataCopy 输出通常要求对齐。
-        // 即使计算只产生了 length 个有效结果，也会拷贝对齐后的长度，多余部分是无效数据，
-        // 但因为 GM 空间是按对齐后的 blockLength 分配的，所以写这些无效数据是安全的。
-        CopyOut(loopCount - 1, (length + 31) / 32 * 32);
+    // 平方-乘法：按指数的二进制位累乘，底数每轮自乘一次，负指数最后取倒数。
+    __aicore__ inline void PowerBySquaring(const AscendC::LocalTensor<float>& dst, const AscendC::LocalTensor<float>& base,
+                                           uint32_t length)
+    {
+        uint32_t n = this->intExponent < 0 ? -this->intExponent : this->intExponent;
+        bool first = true;
+        while (n > 0) {
+            if (n & 1) {
+                if (first) {
+                    AscendC::Muls(dst, base, 1.0f, length);
+                    first = false;
+                } else {
+                    AscendC::Mul(dst, dst, base, length);
+                }
+            }
+            n >>= 1;
+            if (n > 0) {
+                AscendC::Mul(base, base, base, length);
+            }
+        }
+        if (this->intExponent < 0) {
+            AscendC::Reciprocal(dst, dst, length);
+        }
     }
 
 private:
-    // 搬入函数 (GM -> UB)
-    __aicore__ inline void CopyIn(int32_t progress, uint32_t length)
-    {
-        AscendC::LocalTensor<TYPE_X1> x1Local = inQueueX1.AllocTensor<TYPE_X1>();
-        AscendC::LocalTensor<TYPE_X2> x2Local = inQueueX2.AllocTensor<TYPE_X2>();
+    float exponent;
+    int32_t intExponent;
+    ScalarExpMode mode;
+    AscendC::TBuf<AscendC::QuePosition::VECCALC> B_x1, B_y;
+    PowsSignFixup fixup;
+};
 
-        AscendC::DataCopy(x1Local, x1Gm[progress * this->tileLength], length);
-        AscendC::DataCopy(x2Local, x2Gm[progress * this->tileLength], length);
-        
-        inQueueX1.EnQue(x1Local);
-        inQueueX2.EnQue(x2Local);
+// 连续分支：x1、x2、y 按核均分后连续处理，流水线见 ElementwisePipeline，DEPTH 为队列深度。
+template<typename TYPE_X1, typename TYPE_X2, typename TYPE_Y, bool SIGN_AWARE = false, int32_t DEPTH = BUFFER_NUM> class Kernel_Powsx {
+public:
+    __aicore__ inline Kernel_Powsx() {}
+
+    // ALIGN_NUM：一个 BLOCK_SIZE (32 字节) 可以容纳多少个当前数据类型的元素，核间切分粒度为 ALIGN_NUM * 8 个元素。
+    __aicore__ inline void Init(GM_ADDR x1, GM_ADDR x2, GM_ADDR y,
+                                uint8_t ALIGN_NUM, uint32_t block_size, uint32_t core_size, uint32_t core_remain, uint32_t core_tail,
+                                GM_ADDR workspace)
+    {
+        GM_ADDR inputs[] = {x1, x2};
+        pipeline.Init(inputs, y, ALIGN_NUM * 8, block_size, core_size, core_remain, core_tail, workspace);
     }
 
-    __aicore__ inline void Compute(int32_t progress, uint32_t length) 
+    __aicore__ inline void Process()
     {
-        AscendC::LocalTensor<TYPE_X1> x1Local = inQueueX1.DeQue<TYPE_X1>();
-        AscendC::LocalTensor<TYPE_X2> x2Local = inQueueX2.DeQue<TYPE_X2>();
-        AscendC::LocalTensor<TYPE_Y> yLocal = outQueueY.AllocTensor<TYPE_Y>();
+        pipeline.Process();
+    }
 
-        if constexpr (std::is_same_v<TYPE_Y, float32_t>) {
-            // AscendC::printf("-------------------------------this is float32_t compute-------------------------------\n");
-            auto ln_x1 = B_x1.Get<float32_t>();
-            AscendC::Ln(ln_x1, x1Local, length);
-            AscendC::Mul(ln_x1, x2Local, ln_x1, length);
-            AscendC::Exp(yLocal, ln_x1, length);
-        }
-        else if constexpr (std::is_same_v<TYPE_Y, float16_t>) {
-            // AscendC::printf("-------------------------------this is float16_t compute-------------------------------\n");
-            auto tmp_x1 = B_x1.Get<float32_t>();
-            auto tmp_x2 = B_x2.Get<float32_t>();
-            auto tmp_y = B_y.Get<float32_t>();
-            AscendC::Cast(tmp_x1, x1Local, AscendC::RoundMode::CAST_NONE, length);
-            AscendC::Cast(tmp_x2, x2Local, AscendC::RoundMode::CAST_NONE, length);
-            AscendC::Ln(tmp_x1, tmp_x1, length);
-            AscendC::Mul(tmp_x1, tmp_x2, tmp_x1, length);
-            AscendC::Exp(tmp_y, tmp_x1, length);
-            AscendC::Cast(yLocal, tmp_y, AscendC::RoundMode::CAST_NONE, length);
+private:
+    ElementwisePipeline<PowsCompute<TYPE_X1, TYPE_X2, TYPE_Y, SIGN_AWARE>, TYPE_Y, DEPTH, TYPE_X1, TYPE_X2> pipeline;
+};
 
-        }
-        else if constexpr (std::is_same_v<TYPE_Y, bfloat16_t>){
-            // AscendC::printf("-------------------------------this is bf16_t compute-------------------------------\n");
-            auto tmp_x1 = B_x1.Get<float>();
-            auto tmp_x2 = B_x2.Get<float>();
-            auto tmp_y = B_y.Get<float>();
-            AscendC::Cast(tmp_x1, x1Local, AscendC::RoundMode::CAST_NONE, length);
-            AscendC::Cast(tmp_x2, x2Local, AscendC::RoundMode::CAST_NONE, length);
-            AscendC::DumpTensor(tmp_x1, 321333, length);
-            AscendC::Ln(tmp_x1, tmp_x1, length);
-            AscendC::Mul(tmp_x1, tmp_x1, tmp_x2, length);
-            AscendC::Exp(tmp_y, tmp_x1, length);
-            AscendC::Cast(yLocal, tmp_y, AscendC::RoundMode::CAST_ROUND, length);
-        }
 
-        
-        outQueueY.EnQue<TYPE_Y>(yLocal);
-        inQueueX1.FreeTensor(x1Local);
-        inQueueX2.FreeTensor(x2Local);
-    }
+// 指数 x2 为单个标量的连续分支：核间切分与 Kernel_Powsx 相同，x2 只在 Init 中读取一次，不进入流水线。
+// y 与 x2 共用同一块 GM 时改为 0 号核串行处理，x2 在写回 y[0] 之前读取。
+template<typename TYPE_X1, typename TYPE_X2, typename TYPE_Y, bool SIGN_AWARE = false, int32_t DEPTH = BUFFER_NUM> class KernelPows_ScalarExp {
+public:
+    __aicore__ inline KernelPows_ScalarExp() {}
 
-    // 搬出函数 (UB -> GM)
-    __aicore__ inline void CopyOut(int32_t progress, uint32_t length)
+    __aicore__ inline void Init(GM_ADDR x1, GM_ADDR x2, GM_ADDR y,
+                                uint8_t ALIGN_NUM, uint32_t block_size, uint32_t core_size, uint32_t core_remain, uint32_t core_tail,
+                                GM_ADDR workspace)
     {
-        AscendC::LocalTensor<TYPE_Y> yLocal = outQueueY.DeQue<TYPE_Y>();
+        GM_ADDR inputs[] = {x1};
+        pipeline.Init(inputs, y, ALIGN_NUM * 8, block_size, core_size, core_remain, core_tail, workspace, x2 == y);
+        AscendC::GlobalTensor<TYPE_X2> x2Gm;
+        x2Gm.SetGlobalBuffer((__gm__ TYPE_X2*)x2, 1);
+        pipeline.Computer().SetExponent(ScalarToFloat(x2Gm.GetValue(0)));
+    }
 
-        AscendC::DataCopy(yGm[progress * this->tileLength], yLocal, length);
-        outQueueY.FreeTensor(yLocal);
+    __aicore__ inline void Process()
+    {
+        pipeline.Process();
     }
 
 private:
-    // 固定变量
-    uint32_t blockLength, tileNum, tileLength;  
-
-    AscendC::TPipe pipe;
-    AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueX1;          
-    AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueX2;         
-    AscendC::TQue<AscendC::QuePosition::VECOUT, BUFFER_NUM> outQueueY;     
-
-    AscendC::GlobalTensor<TYPE_X1> x1Gm; 
-    AscendC::GlobalTensor<TYPE_X2> x2Gm;        
-    AscendC::GlobalTensor<TYPE_Y> yGm;     
-    //
-    AscendC::TBuf<AscendC::QuePosition::VECCALC> B_x1, B_x2, B_y;
-    AscendC::TBuf<AscendC::QuePosition::VECCALC> f_x1_16, f_x2_16, f_y_16;
+    ElementwisePipeline<PowsScalarCompute<TYPE_X1, TYPE_Y, SIGN_AWARE>, TYPE_Y, DEPTH, TYPE_X1> pipeline;
 };
 
 
-template<typename TYPE_X1, typename TYPE_X2, typename TYPE_Y> class KernelPows_Broadcast {
+// 广播分支：输出按合并后的最内维看作 [rowNum, rowLength]，以整行或行内分段为单位切 Tile，
+// 沿用 CopyIn -> Compute -> CopyOut 的双缓冲流水线。
+// 与输出同形状的输入整块 DataCopyPad 搬入；最内维连续的广播输入逐行搬入；最内维被广播的输入逐行 Duplicate。
+// y 与被广播的输入共用同一块 GM 时，由 0 号核倒序处理全部 Tile（见 BroadcastTiler::Serialize）。
+template<typename TYPE_X1, typename TYPE_X2, typename TYPE_Y, bool SIGN_AWARE = false> class KernelPows_Broadcast {
     public:
         __aicore__ inline KernelPows_Broadcast() {}
     
-        __aicore__ inline void Init(GM_ADDR x1, GM_ADDR x2, GM_ADDR y,
-                                    uint8_t ALIGN_NUM, uint32_t block_size, uint32_t core_size, uint32_t core_remain, uint32_t shapeInf[2*10])
+        __aicore__ inline void Init(GM_ADDR x1, GM_ADDR x2, GM_ADDR y, uint8_t ALIGN_NUM, uint32_t block_size,
+                                    uint32_t dim_num, uint32_t y_shape[MAX_DIM_NUM], uint32_t strides[2 * MAX_DIM_NUM],
+                                    uint32_t row_tile, uint32_t col_tile, GM_ADDR workspace)
         {
-             // 确定最大维度数
-            int32_t x1DimNum = static_cast<int32_t>(shapeInf[0 * 10 + 0]);
-            int32_t x2DimNum = static_cast<int32_t>(shapeInf[1 * 10 + 0]);
-            maxDimNum = x1DimNum;
-            if (x2DimNum > maxDimNum) maxDimNum = x2DimNum;
-            // 将shapeInf转换为shape，最后一行存每个维度最大值
-            for(int tensor_idx = maxDimNum-1; tensor_idx >= 0; tensor_idx--) {
-                this->shapes[0][tensor_idx] = (maxDimNum - x1DimNum - tensor_idx) > 0 ? 1 : shapeInf[0*10 + tensor_idx+1];
-                this->shapes[1][tensor_idx] = (maxDimNum - x2DimNum - tensor_idx) > 0 ? 1 : shapeInf[1*10 + tensor_idx+1];
-                this->shapes[2][tensor_idx] = this->shapes[0][tensor_idx];
-                if (this->shapes[1][tensor_idx] > this->shapes[2][tensor_idx]) this->shapes[2][tensor_idx] = this->shapes[1][tensor_idx];
+            this->dimNum = dim_num;
+            this->alignNum = ALIGN_NUM;
+            // 合并后的形状与各输入的步长（广播维为 0）由 TilingFunc 预先计算。
+            // 输入的步长与输出的连续步长一致时，该输入与输出同形状，可按整块搬入。
+            uint64_t x1Size = 1;
+            uint64_t x2Size = 1;
+            uint64_t ySize = 1;
+            this->x1Contiguous = true;
+            this->x2Contiguous = true;
+            for (int32_t j = this->dimNum - 1; j >= 0; j--) {
+                this->yShape[j] = y_shape[j];
+                this->x1Strides[j] = strides[0 * MAX_DIM_NUM + j];
+                this->x2Strides[j] = strides[1 * MAX_DIM_NUM + j];
+                this->x1Contiguous = this->x1Contiguous && (this->x1Strides[j] == ySize);
+                this->x2Contiguous = this->x2Contiguous && (this->x2Strides[j] == ySize);
+                x1Size += (this->yShape[j] - 1) * this->x1Strides[j];
+                x2Size += (this->yShape[j] - 1) * this->x2Strides[j];
+                ySize *= this->yShape[j];
+            }
+            // 行号只在外层 dimNum - 1 维上展开。
+            rowIndexer.Init(this->dimNum - 1, this->yShape);
+            rowIndexer.SetStrides(0, this->x1Strides);
+            rowIndexer.SetStrides(1, this->x2Strides);
+            this->rowLength = this->yShape[this->dimNum - 1];
+            tiler.Init(ySize, this->rowLength, row_tile, col_tile, ALIGN_NUM);
+            if ((x1 == y && !this->x1Contiguous) || (x2 == y && !this->x2Contiguous)) {
+                tiler.Serialize();
             }
 
-            for (int i = 0; i < 3; i++) {
-                strides[i][maxDimNum - 1] = 1;
+            x1Gm.SetGlobalBuffer((__gm__ TYPE_X1*)x1, x1Size);
+            x2Gm.SetGlobalBuffer((__gm__ TYPE_X2*)x2, x2Size);
+            yGm.SetGlobalBuffer((__gm__ TYPE_Y*)y, ySize);
+
+            pipe.InitBuffer(inQueueX1, BUFFER_NUM, block_size * sizeof(TYPE_X1));
+            pipe.InitBuffer(inQueueX2, BUFFER_NUM, block_size * sizeof(TYPE_X2));
+            pipe.InitBuffer(outQueueY, BUFFER_NUM, block_size * sizeof(TYPE_Y));
+            computer.Init(pipe, block_size);
+            profiler.Init(workspace);
+        }
+    
+        __aicore__ inline void Process()
+        {
+            for (uint32_t i = tiler.tileStart; i < tiler.tileEnd; i++) {
+                profiler.TileBegin();
+                BroadcastTile tile = tiler.Locate(tiler.Order(i));
+                CopyIn(tile);
+                profiler.Mark(OP_PROFILE_COPY_IN);
+                Compute(tile);
+                profiler.Mark(OP_PROFILE_COMPUTE);
+                CopyOut(tile);
+                profiler.Mark(OP_PROFILE_COPY_OUT);
+                profiler.AddBytes(InputBytes<TYPE_X1>(this->x1Strides, this->x1Contiguous, tile) +
+                                  InputBytes<TYPE_X2>(this->x2Strides, this->x2Contiguous, tile),
+                                  static_cast<uint64_t>(tile.rows) * tile.cols * sizeof(TYPE_Y));
             }
-            for (int i = maxDimNum - 2; i >= 0; i--) {
-                strides[0][i] = strides[0][i + 1] * shapes[0][i + 1];
-                strides[1][i] = strides[1][i + 1] * shapes[1][i + 1];
-                strides[2][i] = strides[2][i + 1] * shapes[2][i + 1];
+            profiler.Finish();
+        }
+
+    private:
+        // 与 CopyIn 对应，一个 Tile 实际从 GM 读取的字节数，仅用于性能打点。
+        template<typename T>
+        __aicore__ inline uint64_t InputBytes(const uint64_t* strides, bool contiguous, const BroadcastTile& tile)
+        {
+            if (!contiguous && strides[this->dimNum - 1] == 0) {
+                return static_cast<uint64_t>(tile.rows) * sizeof(T);
             }
-            
-            this->blockLength = core_size + core_remain;
-            // 将blocklength长度对齐为32字节
-            this->blockLength = this->blockLength + (this->blockLength % ALIGN_NUM ? ALIGN_NUM - this->blockLength % ALIGN_NUM : 0); 
-            x1Gm.SetGlobalBuffer((__gm__ TYPE_X1*)x1, this->blockLength);
-            x2Gm.SetGlobalBuffer((__gm__ TYPE_X2*)x2, this->blockLength);
-            yGm.SetGlobalBuffer((__gm__ TYPE_Y*)y, this->blockLength);
-            
-            this->tileLength = 1;
-            if constexpr (std::is_same_v<TYPE_Y, float16_t>) {
-                pipe.InitBuffer(B_x1, this->tileLength * sizeof(float32_t));
-                pipe.InitBuffer(B_x2, this->tileLength * sizeof(float32_t));
-                pipe.InitBuffer(B_y, this->tileLength * sizeof(float32_t));
-                auto tmp_x1 = B_x1.Get<float32_t>();
-                auto tmp_x2 = B_x2.Get<float32_t>();
-                auto tmp_y = B_y.Get<float32_t>();
+            return static_cast<uint64_t>(tile.rows) * tile.cols * sizeof(T);
+        }
+
+        __aicore__ inline void CopyIn(const BroadcastTile& tile)
+        {
+            AscendC::LocalTensor<TYPE_X1> x1Local = inQueueX1.AllocTensor<TYPE_X1>();
+            AscendC::LocalTensor<TYPE_X2> x2Local = inQueueX2.AllocTensor<TYPE_X2>();
+
+            if (this->x1Contiguous) {
+                CopyInTile(x1Local, x1Gm, this->rowLength, tile);
             }
-            else if constexpr (std::is_same_v<TYPE_Y, float32_t>) {
-                pipe.InitBuffer(B_x1, this->tileLength * sizeof(float32_t));
-                pipe.InitBuffer(B_x2, this->tileLength * sizeof(float32_t));
-                pipe.InitBuffer(B_y, this->tileLength * sizeof(float32_t));
-                auto tmp_x1 = B_x1.Get<float32_t>();
-                auto tmp_x2 = B_x2.Get<float32_t>();
-                auto tmp_y = B_y.Get<float32_t>();
+            if (this->x2Contiguous) {
+                CopyInTile(x2Local, x2Gm, this->rowLength, tile);
             }
-            else if constexpr (std::is_same_v<TYPE_Y, bfloat16_t>) {
-                pipe.InitBuffer(B_x1, this->tileLength * sizeof(float));
-                pipe.InitBuffer(B_x2, this->tileLength * sizeof(float));
-                pipe.InitBuffer(B_y, this->tileLength * sizeof(bfloat16_t));
-                auto tmp_x1 = B_x1.Get<float>();
-                auto tmp_x2 = B_x2.Get<float>();
-                auto tmp_y = B_y.Get<bfloat16_t>();
+            if (!this->x1Contiguous || !this->x2Contiguous) {
+                // 每个 Tile 只分解一次起始行号，之后逐行前进，行内没有除法与取模。
+                rowIndexer.Seek(tile.rowStart);
+                for (uint32_t r = 0; r < tile.rows; r++) {
+                    if (!this->x1Contiguous) {
+                        CopyInRow(x1Local[r * tile.colPad], x1Gm, rowIndexer.Offset(0),
+                                  this->x1Strides[this->dimNum - 1], tile);
+                    }
+                    if (!this->x2Contiguous) {
+                        CopyInRow(x2Local[r * tile.colPad], x2Gm, rowIndexer.Offset(1),
+                                  this->x2Strides[this->dimNum - 1], tile);
+                    }
+                    rowIndexer.Next();
+                }
             }
 
+            inQueueX1.EnQue(x1Local);
+            inQueueX2.EnQue(x2Local);
+        }
 
+        __aicore__ inline void Compute(const BroadcastTile& tile)
+        {
+            AscendC::LocalTensor<TYPE_X1> x1Local = inQueueX1.DeQue<TYPE_X1>();
+            AscendC::LocalTensor<TYPE_X2> x2Local = inQueueX2.DeQue<TYPE_X2>();
+            AscendC::LocalTensor<TYPE_Y> yLocal = outQueueY.AllocTensor<TYPE_Y>();
+
+            // 补齐部分的数据无效，但一起参与计算不影响有效结果，且不会被搬出。
+            computer.Compute(yLocal, x1Local, x2Local, tile.rows * tile.colPad);
+
+            outQueueY.EnQue<TYPE_Y>(yLocal);
+            inQueueX1.FreeTensor(x1Local);
+            inQueueX2.FreeTensor(x2Local);
         }
-    
-        __aicore__ inline void Process()
+
+        __aicore__ inline void CopyOut(const BroadcastTile& tile)
         {
-            for (int i = 0; i < blockLength; i++) {
-                int x1Offset = 0;
-                int x2Offset = 0;
-                int outOffset = 0;
-                for (int j = 0; j < maxDimNum; j++) {
-                    int index = i / strides[2][j] % shapes[2][j];
-                    x1Offset += (index % shapes[0][j]) * strides[0][j];
-                    x2Offset += (index % shapes[1][j]) * strides[1][j];
-                    outOffset += index * strides[2][j];
-                }
-                TYPE_X1 x1 = x1Gm.GetValue(x1Offset);
-                TYPE_X2 x2 = x2Gm.GetValue(x2Offset);
-
-                if constexpr (std::is_same_v<TYPE_Y, float16_t>) {
-                    auto tmp_x1 = B_x1.Get<float32_t>();
-                    auto tmp_x2 = B_x2.Get<float32_t>();
-                    auto tmp_y = B_y.Get<float32_t>();
-                    tmp_x1.SetValue(0, static_cast<float32_t>(x1));
-                    tmp_x2.SetValue(0, static_cast<float32_t>(x2));
-                    AscendC::Ln(tmp_x1, tmp_x1, tileLength);
-                    AscendC::Mul(tmp_x1, tmp_x2, tmp_x1, tileLength);
-                    AscendC::Exp(tmp_y, tmp_x1, tileLength);
-                    yGm.SetValue(outOffset, static_cast<float16_t>(tmp_y.GetValue(0)));
-                }
-                else if constexpr (std::is_same_v<TYPE_Y, float32_t>) {
-                    auto tmp_x1 = B_x1.Get<float32_t>();
-                    auto tmp_x2 = B_x2.Get<float32_t>();
-                    auto tmp_y = B_y.Get<float32_t>();
-                    tmp_x1.SetValue(0, x1);
-                    tmp_x2.SetValue(0, x2);
-                    AscendC::Ln(tmp_x1, tmp_x1, tileLength);
-                    AscendC::Mul(tmp_x1, tmp_x2, tmp_x1, tileLength);
-                    AscendC::Exp(tmp_y, tmp_x1, tileLength);
-                    yGm.SetValue(outOffset, tmp_y.GetValue(0));
-                }
-                else if constexpr (std::is_same_v<TYPE_Y, bfloat16_t>) {
-                    auto tmp_x1 = B_x1.Get<float>();
-                    auto tmp_x2 = B_x2.Get<float>();
-                    auto tmp_y = B_y.Get<bfloat16_t>();
-                    tmp_y.SetValue(0, x1);
-                    AscendC::Cast(tmp_x1, tmp_y, AscendC::RoundMode::CAST_NONE, tileLength);
-                    tmp_y.SetValue(0, x2);
-                    AscendC::Cast(tmp_x2, tmp_y, AscendC::RoundMode::CAST_NONE, tileLength);
-                    AscendC::Ln(tmp_x1, tmp_x1, tileLength);
-                    AscendC::Mul(tmp_x1, tmp_x2, tmp_x1, tileLength);
-                    AscendC::Exp(tmp_x1, tmp_x1, tileLength);
-                    AscendC::Cast(tmp_y, tmp_x1, AscendC::RoundMode::CAST_ROUND, tileLength);
-                    yGm.SetValue(outOffset, tmp_y.GetValue(0));
-                }
-                
-            }
+            AscendC::LocalTensor<TYPE_Y> yLocal = outQueueY.DeQue<TYPE_Y>();
+
+            CopyOutTile(yGm, yLocal, this->rowLength, tile);
+            outQueueY.FreeTensor(yLocal);
         }
 
-    
     private:
         AscendC::TPipe pipe;
+        AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueX1;          
+        AscendC::TQue<AscendC::QuePosition::VECIN, BUFFER_NUM> inQueueX2;         
+        AscendC::TQue<AscendC::QuePosition::VECOUT, BUFFER_NUM> outQueueY;     
         // 固定变量
-        uint32_t blockLength, tileLength;  
+        uint32_t dimNum, alignNum;
+        uint32_t rowLength;
+        BroadcastTiler tiler;
+        bool x1Contiguous, x2Contiguous;
         
         AscendC::GlobalTensor<TYPE_X1> x1Gm; 
         AscendC::GlobalTensor<TYPE_X2> x2Gm;        
         AscendC::GlobalTensor<TYPE_Y> yGm;     
               
-        int64_t shapes[3][10];   
-        int64_t strides[3][10];  
-        int32_t maxDimNum; // 最大维度数
-        AscendC::TBuf<AscendC::QuePosition::VECCALC> B_x1, B_x2, B_y;
-
+        uint64_t yShape[MAX_DIM_NUM];   
+        uint64_t x1Strides[MAX_DIM_NUM];  
+        uint64_t x2Strides[MAX_DIM_NUM];  
+        BroadcastIndexer<2> rowIndexer;    // 输出行号对应的 x1、x2 起始偏移
+        PowsCompute<TYPE_X1, TYPE_X2, TYPE_Y, SIGN_AWARE> computer;
+        OpProfiler profiler;
 };
 
 
-
-
-
-
 extern "C" __global__ __aicore__ void pows(GM_ADDR x1, GM_ADDR x2, GM_ADDR y, GM_ADDR workspace, GM_ADDR tiling) {
     GET_TILING_DATA(tiling_data, tiling);
     // TODO: user kernel impl
+    // TilingKey：1 连续，2 广播，3 标量指数；加 10 为对应的 sign-aware 版本；连续分支加 100 为三缓冲版本。
     if (TILING_KEY_IS(1)) {
         Kernel_Powsx<DTYPE_X1, DTYPE_X2, DTYPE_Y> op; 
         op.Init(x1, x2, y,
-            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain);
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
         op.Process();
     } else if (TILING_KEY_IS(2)) {
         KernelPows_Broadcast<DTYPE_X1, DTYPE_X2, DTYPE_Y> op; 
+        op.Init(x1, x2, y, tiling_data.ALIGN_NUM, tiling_data.block_size,
+            tiling_data.dim_num, tiling_data.y_shape, tiling_data.strides,
+            tiling_data.row_tile, tiling_data.col_tile, workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(3)) {
+        KernelPows_ScalarExp<DTYPE_X1, DTYPE_X2, DTYPE_Y> op; 
+        op.Init(x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(11)) {
+        Kernel_Powsx<DTYPE_X1, DTYPE_X2, DTYPE_Y, true> op; 
+        op.Init(x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(12)) {
+        KernelPows_Broadcast<DTYPE_X1, DTYPE_X2, DTYPE_Y, true> op; 
+        op.Init(x1, x2, y, tiling_data.ALIGN_NUM, tiling_data.block_size,
+            tiling_data.dim_num, tiling_data.y_shape, tiling_data.strides,
+            tiling_data.row_tile, tiling_data.col_tile, workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(13)) {
+        KernelPows_ScalarExp<DTYPE_X1, DTYPE_X2, DTYPE_Y, true> op; 
+        op.Init(x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(101)) {
+        Kernel_Powsx<DTYPE_X1, DTYPE_X2, DTYPE_Y, false, 3> op; 
+        op.Init(x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(103)) {
+        KernelPows_ScalarExp<DTYPE_X1, DTYPE_X2, DTYPE_Y, false, 3> op; 
+        op.Init(x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(111)) {
+        Kernel_Powsx<DTYPE_X1, DTYPE_X2, DTYPE_Y, true, 3> op; 
+        op.Init(x1, x2, y,
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
+        op.Process();
+    } else if (TILING_KEY_IS(113)) {
+        KernelPows_ScalarExp<DTYPE_X1, DTYPE_X2, DTYPE_Y, true, 3> op; 
         op.Init(x1, x2, y,
-            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.shapeInf);
+            tiling_data.ALIGN_NUM, tiling_data.block_size, tiling_data.core_size, tiling_data.core_remain, tiling_data.core_tail,
+            workspace);
         op.Process();
     }
 }
\ No newline at end of file
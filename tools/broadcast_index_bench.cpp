@@ -0,0 +1,205 @@
+// 广播下标生成的 CPU 仿真基准：比较逐元素除法/取模与 BroadcastIndexer 里程表的每元素耗时。
+// 三种写法都只生成 condition、x1、x2 的偏移并做 select，与 KernelSelect_Broadcast 的标量循环一致：
+//   legacy   ：旧实现，每维 i / stride % shape，再对每个输入取模；
+//   per-dim  ：Host 预计算步长后，每维一次 / 与 %；
+//   odometer ：BroadcastIndexer，只在起点 Seek 一次。
+// Host 的 64 位除法比 AI Core 标量单元便宜得多，这里的加速比只反映相对趋势。
+//
+// 用法：broadcast_index_bench [repeat]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#else
+#define BENCH_HAS_TSC 0
+#endif
+
+#include "broadcast_indexer.h"
+
+namespace {
+
+const int32_t RANK = 4;
+const int32_t INPUT_NUM = 3;
+
+struct Case {
+  const char* name;
+  int64_t shapes[INPUT_NUM][RANK];
+};
+
+struct Layout {
+  uint64_t outShape[RANK];
+  uint64_t outStrides[RANK];
+  uint64_t inShape[INPUT_NUM][RANK];
+  uint64_t inStrides[INPUT_NUM][RANK];       // 输入自身的连续步长
+  uint64_t bcastStrides[INPUT_NUM][RANK];    // 按输出下标取数的步长，广播维为 0
+  uint64_t total;
+};
+
+Layout MakeLayout(const Case& c)
+{
+  Layout l;
+  for (int32_t j = 0; j < RANK; j++) {
+    l.outShape[j] = 1;
+    for (int32_t k = 0; k < INPUT_NUM; k++) {
+      l.inShape[k][j] = static_cast<uint64_t>(c.shapes[k][j]);
+      if (l.inShape[k][j] > l.outShape[j]) {
+        l.outShape[j] = l.inShape[k][j];
+      }
+    }
+  }
+  l.total = 1;
+  for (int32_t j = RANK - 1; j >= 0; j--) {
+    l.outStrides[j] = l.total;
+    l.total *= l.outShape[j];
+  }
+  for (int32_t k = 0; k < INPUT_NUM; k++) {
+    uint64_t stride = 1;
+    for (int32_t j = RANK - 1; j >= 0; j--) {
+      l.inStrides[k][j] = stride;
+      l.bcastStrides[k][j] = l.inShape[k][j] == 1 ? 0 : stride;
+      stride *= l.inShape[k][j];
+    }
+  }
+  return l;
+}
+
+uint64_t InputSize(const Layout& l, int32_t k)
+{
+  uint64_t size = 1;
+  for (int32_t j = 0; j < RANK; j++) {
+    size *= l.inShape[k][j];
+  }
+  return size;
+}
+
+// 禁止内联，避免编译器把形状当作常量把除法优化掉。
+__attribute__((noinline)) void RunLegacy(const Layout& l, const uint8_t* cond, const float* x1, const float* x2,
+                                         float* y)
+{
+  for (uint64_t i = 0; i < l.total; i++) {
+    uint64_t offsets[INPUT_NUM] = {0, 0, 0};
+    uint64_t outOffset = 0;
+    for (int32_t j = 0; j < RANK; j++) {
+      uint64_t index = i / l.outStrides[j] % l.outShape[j];
+      for (int32_t k = 0; k < INPUT_NUM; k++) {
+        offsets[k] += (index % l.inShape[k][j]) * l.inStrides[k][j];
+      }
+      outOffset += index * l.outStrides[j];
+    }
+    y[outOffset] = cond[offsets[0]] ? x1[offsets[1]] : x2[offsets[2]];
+  }
+}
+
+__attribute__((noinline)) void RunPerDim(const Layout& l, const uint8_t* cond, const float* x1, const float* x2,
+                                         float* y)
+{
+  for (uint64_t i = 0; i < l.total; i++) {
+    uint64_t offsets[INPUT_NUM] = {0, 0, 0};
+    uint64_t rest = i;
+    for (int32_t j = RANK - 1; j >= 0; j--) {
+      uint64_t index = rest % l.outShape[j];
+      rest /= l.outShape[j];
+      for (int32_t k = 0; k < INPUT_NUM; k++) {
+        offsets[k] += index * l.bcastStrides[k][j];
+      }
+    }
+    y[i] = cond[offsets[0]] ? x1[offsets[1]] : x2[offsets[2]];
+  }
+}
+
+__attribute__((noinline)) void RunOdometer(const Layout& l, const uint8_t* cond, const float* x1, const float* x2,
+                                           float* y)
+{
+  BroadcastIndexer<INPUT_NUM> indexer;
+  indexer.Init(RANK, l.outShape);
+  for (int32_t k = 0; k < INPUT_NUM; k++) {
+    indexer.SetStrides(k, l.bcastStrides[k]);
+  }
+  indexer.Seek(0);
+  for (uint64_t i = 0; i < l.total; i++) {
+    y[i] = cond[indexer.Offset(0)] ? x1[indexer.Offset(1)] : x2[indexer.Offset(2)];
+    indexer.Next();
+  }
+}
+
+typedef void (*RunFunc)(const Layout&, const uint8_t*, const float*, const float*, float*);
+
+struct Timing {
+  double ns;
+  double cycles;
+};
+
+Timing Measure(RunFunc run, const Layout& l, const uint8_t* cond, const float* x1, const float* x2, float* y,
+               int repeat)
+{
+  typedef std::chrono::steady_clock Clock;
+  run(l, cond, x1, x2, y);   // 预热
+  Clock::time_point start = Clock::now();
+#if BENCH_HAS_TSC
+  uint64_t tscStart = __rdtsc();
+#endif
+  for (int r = 0; r < repeat; r++) {
+    run(l, cond, x1, x2, y);
+  }
+  Timing t;
+  double elements = static_cast<double>(l.total) * repeat;
+#if BENCH_HAS_TSC
+  t.cycles = static_cast<double>(__rdtsc() - tscStart) / elements;
+#else
+  t.cycles = 0;
+#endif
+  t.ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / elements;
+  return t;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  int repeat = argc > 1 ? std::atoi(argv[1]) : 20;
+  if (repeat <= 0) {
+    std::fprintf(stderr, "usage: %s [repeat]\n", argv[0]);
+    return 1;
+  }
+
+  // 合并后仍为 4 维的形状：相邻维的广播模式互不相同。
+  const Case cases[] = {
+    {"cond[8,1,32,1] x1[1,16,32,64] x2[8,16,1,64]", {{8, 1, 32, 1}, {1, 16, 32, 64}, {8, 16, 1, 64}}},
+    {"cond[1,24,1,96] x1[4,24,48,96] x2[4,1,48,1]", {{1, 24, 1, 96}, {4, 24, 48, 96}, {4, 1, 48, 1}}},
+    {"cond[2,1,1,7] x1[2,33,65,7] x2[1,33,65,1]", {{2, 1, 1, 7}, {2, 33, 65, 7}, {1, 33, 65, 1}}},
+  };
+
+  std::printf("%-48s %10s %18s %18s %18s\n", "case", "elements", "legacy", "per-dim", "odometer");
+  std::printf("%-48s %10s %18s %18s %18s\n", "", "", BENCH_HAS_TSC ? "cyc/elem (ns)" : "ns/elem",
+              BENCH_HAS_TSC ? "cyc/elem (ns)" : "ns/elem", BENCH_HAS_TSC ? "cyc/elem (ns)" : "ns/elem");
+  int status = 0;
+  for (const Case& c : cases) {
+    Layout l = MakeLayout(c);
+    std::vector<uint8_t> cond(InputSize(l, 0));
+    std::vector<float> x1(InputSize(l, 1));
+    std::vector<float> x2(InputSize(l, 2));
+    for (size_t i = 0; i < cond.size(); i++) cond[i] = static_cast<uint8_t>((i * 7) % 3 == 0);
+    for (size_t i = 0; i < x1.size(); i++) x1[i] = static_cast<float>(i);
+    for (size_t i = 0; i < x2.size(); i++) x2[i] = -static_cast<float>(i);
+    std::vector<float> yRef(l.total), yPerDim(l.total), yOdometer(l.total);
+
+    Timing legacy = Measure(RunLegacy, l, cond.data(), x1.data(), x2.data(), yRef.data(), repeat);
+    Timing perDim = Measure(RunPerDim, l, cond.data(), x1.data(), x2.data(), yPerDim.data(), repeat);
+    Timing odometer = Measure(RunOdometer, l, cond.data(), x1.data(), x2.data(), yOdometer.data(), repeat);
+    bool match = yRef == yPerDim && yRef == yOdometer;
+    if (!match) {
+      status = 1;
+    }
+
+    std::printf("%-48s %10llu %9.2f (%5.2f) %9.2f (%5.2f) %9.2f (%5.2f)%s\n", c.name,
+                static_cast<unsigned long long>(l.total), legacy.cycles, legacy.ns, perDim.cycles, perDim.ns,
+                odometer.cycles, odometer.ns, match ? "" : "  MISMATCH");
+  }
+  return status;
+}
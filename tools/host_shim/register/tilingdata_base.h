@@ -0,0 +1,39 @@
+// Host 工具用的 register/tilingdata_base.h：只实现各算子 *_tiling.h 用到的宏，
+// 使 tools 能直接编译算子的 TilingData 定义（如 pows_tiling.h），得到与 TilingFunc 相同的字段与序列化结果。
+// 字段按声明顺序、自然对齐排布，与核函数 GET_TILING_DATA 读取的结构一致；SaveToBuffer 整体拷贝。
+// REGISTER_TILING_DATA_CLASS 只在 CANN 运行时中有意义，这里为空。
+
+#ifndef TOOLS_HOST_SHIM_TILINGDATA_BASE_H
+#define TOOLS_HOST_SHIM_TILINGDATA_BASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#define BEGIN_TILING_DATA_DEF(name) \
+  class name {                      \
+  public:
+
+#define TILING_DATA_FIELD_DEF(type, field)          \
+  type field##_ = {};                               \
+  void set_##field(type value) { field##_ = value; } \
+  type get_##field() const { return field##_; }
+
+#define TILING_DATA_FIELD_DEF_ARR(type, num, field)                                     \
+  type field##_[num] = {};                                                              \
+  void set_##field(const type* value) { std::memcpy(field##_, value, sizeof(field##_)); } \
+  const type* get_##field() const { return field##_; }
+
+#define END_TILING_DATA_DEF                                                                \
+  size_t GetDataSize() const { return sizeof(*this); }                                    \
+  void SaveToBuffer(void* dst, size_t capacity) const                                     \
+  {                                                                                       \
+    if (capacity >= sizeof(*this)) {                                                      \
+      std::memcpy(dst, this, sizeof(*this));                                              \
+    }                                                                                     \
+  }                                                                                       \
+  }
+
+#define REGISTER_TILING_DATA_CLASS(op, cls)
+
+#endif  // TOOLS_HOST_SHIM_TILINGDATA_BASE_H
@@ -0,0 +1,228 @@
+// 原地执行（y 与某个输入共用同一块 GM）的调度检查：在 Host 上用 kernel_split.h 重放各核的搬入 / 搬出顺序，
+// 确认 y 所在输入的每个元素都由写回它的核在写回之前读取，且任意两个核的读写区间互不重叠。
+//   contiguous：ElementwisePipeline 的核间切分与 DEPTH - 1 个 Tile 的预取；y 与标量输入共用时
+//               按 ElementwiseBlock::InitSerial 串行处理，标量在 Init 中读取；
+//   broadcast ：BroadcastTiler 的行切分，y 所在的输入与输出同形状（CopyInTile）、为标量、[1, L]、[R, 1]
+//               或 [R / 2, 1, L]，后四种按 BroadcastTiler::Serialize 倒序串行处理。
+// 同一个 Tile 的搬入经 EnQue / DeQue 同步后才计算、搬出，因此按程序顺序重放即可。
+//
+// 用法：inplace_schedule_check [cases]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "elementwise_tiling.h"
+#include "kernel_split.h"
+
+namespace {
+
+struct Access {
+    bool write;
+    uint64_t begin;
+    uint64_t end;
+};
+
+using Schedule = std::vector<std::vector<Access>>;   // 每个核按程序顺序的读写区间
+
+// 检查失败时返回描述，成功返回 nullptr。
+const char* Verify(const Schedule& schedule, uint64_t total)
+{
+    const int64_t NONE = -1;
+    std::vector<int64_t> owner(total, NONE);
+    std::vector<uint64_t> writeStep(total, 0);
+    for (size_t core = 0; core < schedule.size(); core++) {
+        for (size_t step = 0; step < schedule[core].size(); step++) {
+            const Access& a = schedule[core][step];
+            if (!a.write) {
+                continue;
+            }
+            for (uint64_t e = a.begin; e < a.end; e++) {
+                if (e >= total) {
+                    return "write out of range";
+                }
+                if (owner[e] != NONE) {
+                    return "element written twice";
+                }
+                owner[e] = static_cast<int64_t>(core);
+                writeStep[e] = step;
+            }
+        }
+    }
+    for (uint64_t e = 0; e < total; e++) {
+        if (owner[e] == NONE) {
+            return "element never written";
+        }
+    }
+    for (size_t core = 0; core < schedule.size(); core++) {
+        for (size_t step = 0; step < schedule[core].size(); step++) {
+            const Access& a = schedule[core][step];
+            if (a.write) {
+                continue;
+            }
+            for (uint64_t e = a.begin; e < a.end; e++) {
+                if (e >= total) {
+                    return "read out of range";
+                }
+                if (owner[e] != static_cast<int64_t>(core)) {
+                    return "element read by another core";
+                }
+                if (step > writeStep[e]) {
+                    return "element read after being written";
+                }
+            }
+        }
+    }
+    return nullptr;
+}
+
+// 与 ElementwisePipeline::Init / Process 一致。scalarAlias 时 y 与标量输入共用，有 Tile 的核在 Init 中读取 y[0]。
+Schedule ContiguousSchedule(uint32_t total, uint32_t coreNum, uint32_t coreUnit, uint32_t tileLength, uint32_t depth,
+                            bool scalarAlias)
+{
+    optiling::ElementwiseSplit split = optiling::SplitElementwise(total, coreNum, coreUnit);
+    Schedule schedule(split.coreNum);
+    for (uint32_t blockIdx = 0; blockIdx < split.coreNum; blockIdx++) {
+        ElementwiseBlock block;
+        if (scalarAlias) {
+            block.InitSerial(blockIdx, split.coreNum, coreUnit, tileLength, split.coreSize, split.coreRemain,
+                             split.coreTail);
+        } else {
+            block.Init(blockIdx, split.coreNum, coreUnit, tileLength, split.coreSize, split.coreRemain, split.coreTail);
+        }
+        if (scalarAlias && block.tileNum > 0) {
+            schedule[blockIdx].push_back({false, 0, 1});
+        }
+        auto tile = [&](bool write, uint32_t i) {
+            uint64_t begin = block.offset + static_cast<uint64_t>(i) * block.tileLength;
+            // 标量输入不按 Tile 搬入。
+            if (write || !scalarAlias) {
+                schedule[blockIdx].push_back({write, begin, begin + block.TileLength(i)});
+            }
+        };
+        uint32_t prefetch = depth - 1 < block.tileNum ? depth - 1 : block.tileNum;
+        for (uint32_t i = 0; i < prefetch; i++) {
+            tile(false, i);
+        }
+        for (uint32_t i = 0; i < block.tileNum - prefetch; i++) {
+            tile(false, i + prefetch);
+            tile(true, i);
+        }
+        for (uint32_t i = block.tileNum - prefetch; i < block.tileNum; i++) {
+            tile(true, i);
+        }
+    }
+    return schedule;
+}
+
+// y 所在输入的形状，输出看作 [rowNum, rowLength]。
+enum class AliasShape { SAME, SCALAR, ROW, COL, OUTER };
+
+const char* AliasName(AliasShape shape)
+{
+    switch (shape) {
+        case AliasShape::SAME:
+            return "same";
+        case AliasShape::SCALAR:
+            return "scalar";
+        case AliasShape::ROW:
+            return "row";
+        case AliasShape::COL:
+            return "col";
+        default:
+            return "outer";
+    }
+}
+
+// 与 KernelPows_Broadcast / KernelSelect_Broadcast 的 Init / Process 及 CopyInTile / CopyInRow / CopyOutTile 一致，
+// 每行一个区间。输出第 r 行读取的输入区间按该输入的形状换算。
+Schedule BroadcastSchedule(uint32_t rowNum, uint32_t rowLength, uint32_t rowTile, uint32_t colTile, uint32_t blockNum,
+                           AliasShape shape)
+{
+    const uint32_t ROW_ALIGN = 8;
+    Schedule schedule(blockNum);
+    for (uint32_t blockIdx = 0; blockIdx < blockNum; blockIdx++) {
+        BroadcastTiler tiler;
+        tiler.Init(static_cast<uint64_t>(rowNum) * rowLength, rowLength, rowTile, colTile, ROW_ALIGN, blockIdx,
+                   blockNum);
+        if (shape != AliasShape::SAME) {
+            tiler.Serialize(blockIdx);
+        }
+        for (uint32_t i = tiler.tileStart; i < tiler.tileEnd; i++) {
+            BroadcastTile tile = tiler.Locate(tiler.Order(i));
+            for (uint32_t r = tile.rowStart; r < tile.rowStart + tile.rows; r++) {
+                uint64_t begin = static_cast<uint64_t>(r) * rowLength + tile.colStart;
+                uint64_t end = begin + tile.cols;
+                if (shape == AliasShape::SCALAR) {
+                    begin = 0;
+                    end = 1;
+                } else if (shape == AliasShape::ROW) {
+                    begin = tile.colStart;
+                    end = begin + tile.cols;
+                } else if (shape == AliasShape::COL) {
+                    begin = r;
+                    end = r + 1;
+                } else if (shape == AliasShape::OUTER) {
+                    begin = static_cast<uint64_t>(r / 2) * rowLength + tile.colStart;
+                    end = begin + tile.cols;
+                }
+                schedule[blockIdx].push_back({false, begin, end});
+            }
+            for (uint32_t r = tile.rowStart; r < tile.rowStart + tile.rows; r++) {
+                uint64_t begin = static_cast<uint64_t>(r) * rowLength + tile.colStart;
+                schedule[blockIdx].push_back({true, begin, begin + tile.cols});
+            }
+        }
+    }
+    return schedule;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    int cases = argc > 1 ? std::atoi(argv[1]) : 2000;
+    std::mt19937 rng(20240607);
+    auto pick = [&rng](uint32_t lo, uint32_t hi) {
+        return std::uniform_int_distribution<uint32_t>(lo, hi)(rng);
+    };
+
+    int failed = 0;
+    for (int c = 0; c < cases; c++) {
+        // 打包掩码的切分粒度为 256 个元素，其余为 ALIGN_NUM * 8。
+        const uint32_t units[] = {64, 128, 256};
+        uint32_t coreUnit = units[pick(0, 2)];
+        uint32_t total = pick(1, 200000);
+        uint32_t coreNum = pick(1, 48);
+        uint32_t tileLength = pick(1, 64) * 32;
+        uint32_t depth = pick(optiling::PIPELINE_DEPTH_DOUBLE, optiling::PIPELINE_DEPTH_TRIPLE);
+        bool scalarAlias = pick(0, 1) != 0;
+        const char* error = Verify(ContiguousSchedule(total, coreNum, coreUnit, tileLength, depth, scalarAlias), total);
+        if (error != nullptr) {
+            std::printf("contiguous total=%u cores=%u unit=%u tile=%u depth=%u scalar=%d: %s\n",
+                        total, coreNum, coreUnit, tileLength, depth, scalarAlias ? 1 : 0, error);
+            failed++;
+        }
+
+        uint32_t rowLength = pick(1, 3000);
+        uint32_t rowNum = pick(1, 200000 / rowLength);
+        uint32_t colTile = pick(1, rowLength);
+        uint32_t rowTile = colTile < rowLength ? 1 : pick(1, 64);
+        uint32_t blockNum = pick(1, 48);
+        AliasShape shape = static_cast<AliasShape>(pick(0, 4));
+        if (shape == AliasShape::OUTER && rowNum % 2 != 0) {
+            rowNum++;
+        }
+        error = Verify(BroadcastSchedule(rowNum, rowLength, rowTile, colTile, blockNum, shape),
+                       static_cast<uint64_t>(rowNum) * rowLength);
+        if (error != nullptr) {
+            std::printf("broadcast rows=%u row_length=%u row_tile=%u col_tile=%u cores=%u alias=%s: %s\n",
+                        rowNum, rowLength, rowTile, colTile, blockNum, AliasName(shape), error);
+            failed++;
+        }
+    }
+    std::printf("%d cases, %d failed\n", cases * 2, failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,259 @@
+// Pows / SelectV2 / PowsSelect 的切分与 CPU 仿真基准：按固定的 形状 × dtype × 广播方式 矩阵，
+// 用与 TilingFunc 相同的切分计算（pows_plan.h / select_v2_plan.h / pows_select_plan.h）给出每个用例选择的 TilingKey、
+// block_size、核数、Tile 数与 UB 占用，按核函数的搬运方式估算 GM 读写字节数，
+// 并在 CPU 参考实现（common/op_cpu）上计时。结果以 JSON 输出到 stdout，便于前后两次运行逐项比较。
+// 用例矩阵：
+//   size  ：1 到 64M 个元素，含不按 256 字节对齐的长度；
+//   dtype ：各算子注册的全部 dtype；
+//   case  ：same（同形状）、scalar（x2 只有一个元素，pows / pows_select 中为指数）、row（x2 为 [1, C]）、col（x2 为 [R, 1]），
+//           row / col 取 C = BROADCAST_COLS，元素数不能整除或只有一行时跳过。
+// 用例形状与 GM 字节数的估算见 tiling_model.h，与 tiling_autotune 共用。
+// 默认平台为 ascend310b，与 TilingFunc 一样先查 tuned_tiling_table.h，输出中 tuned 标记是否命中表项；
+// --formula 时不查表，按公式切分，便于比较表项与公式。
+// cpu_ref_ns 为 CPU 参考实现多次运行的中位数，只反映 Host 上的相对趋势；超过 --ref-limit 的用例不运行，输出 null。
+//
+// 用法：op_tiling_bench [--ub bytes] [--cores n] [--ref-limit elements] [--repeat n] [--threads n] [--sign-aware]
+//                       [--formula]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cpu_parallel.h"
+#include "cpu_reference.h"
+#include "cpu_simd.h"
+#include "tiling_model.h"
+
+namespace {
+
+using opcpu::DataType;
+using tilingmodel::CaseKind;
+
+const uint64_t DEFAULT_UB_SIZE = tilingmodel::TARGET_UB_SIZE;
+const uint32_t DEFAULT_CORE_NUM = tilingmodel::TARGET_CORE_NUM;
+const uint64_t DEFAULT_REF_LIMIT = 1 << 22;
+const uint32_t DEFAULT_REPEAT = 5;
+const uint64_t SIZES[] = {1, 100, 4096, 65537, 1 << 20, 3000000, 1 << 24, 1 << 26};
+
+struct Options {
+  uint64_t ubSize = DEFAULT_UB_SIZE;
+  uint32_t coreNum = DEFAULT_CORE_NUM;
+  uint64_t refLimit = DEFAULT_REF_LIMIT;
+  uint32_t repeat = DEFAULT_REPEAT;
+  uint32_t threadNum = 0;
+  bool signAware = false;
+  bool formula = false;
+};
+
+struct DtypeInfo {
+  DataType dtype;
+  const char* name;
+};
+
+const DtypeInfo POWS_DTYPES[] = {
+  {DataType::FLOAT, "float"}, {DataType::FLOAT16, "float16"}, {DataType::BF16, "bf16"},
+};
+
+const DtypeInfo SELECT_DTYPES[] = {
+  {DataType::BOOL, "bool"},   {DataType::INT8, "int8"},   {DataType::UINT8, "uint8"},
+  {DataType::FLOAT16, "float16"}, {DataType::BF16, "bf16"}, {DataType::INT16, "int16"},
+  {DataType::FLOAT, "float"}, {DataType::INT32, "int32"}, {DataType::INT64, "int64"},
+};
+
+void FillRandom(std::vector<uint8_t>& buf, DataType dtype, float lo, float hi, std::mt19937& rng)
+{
+  std::uniform_real_distribution<float> dist(lo, hi);
+  size_t count = buf.size() / opcpu::DataTypeSize(dtype);
+  if (dtype == DataType::FLOAT) {
+    float* p = reinterpret_cast<float*>(buf.data());
+    for (size_t i = 0; i < count; i++) {
+      p[i] = dist(rng);
+    }
+  } else if (dtype == DataType::FLOAT16 || dtype == DataType::BF16) {
+    uint16_t* p = reinterpret_cast<uint16_t*>(buf.data());
+    for (size_t i = 0; i < count; i++) {
+      p[i] = dtype == DataType::FLOAT16 ? opcpu::FloatToHalf(dist(rng)) : opcpu::FloatToBf16(dist(rng));
+    }
+  } else {
+    std::uniform_int_distribution<uint32_t> byte(0, 255);
+    for (auto& b : buf) {
+      b = static_cast<uint8_t>(byte(rng));
+    }
+  }
+}
+
+uint64_t ElementCount(const std::vector<int64_t>& shape)
+{
+  uint64_t n = 1;
+  for (int64_t d : shape) {
+    n *= static_cast<uint64_t>(d);
+  }
+  return n;
+}
+
+// CPU 参考实现的中位耗时（纳秒），失败时返回 -1。
+int64_t TimeReference(uint8_t op, const std::vector<std::vector<int64_t>>& shapes, const std::vector<int64_t>& out,
+                      DataType dtype, const Options& options)
+{
+  std::mt19937 rng(1234);
+  size_t elemBytes = opcpu::DataTypeSize(dtype);
+  bool pows = op == optiling::TUNE_OP_POWS;
+  // pows_select 的 x1、x2 与 pows 的 x1、x2 取值相同。
+  size_t exponent = pows ? 1 : 2;
+  bool powInputs = op != optiling::TUNE_OP_SELECT_V2;
+  std::vector<std::vector<uint8_t>> inputs(shapes.size());
+  for (size_t k = 0; k < shapes.size(); k++) {
+    bool cond = !pows && k == 0;
+    inputs[k].resize(ElementCount(shapes[k]) * (cond ? 1 : elemBytes));
+    if (cond) {
+      std::bernoulli_distribution bit(0.5);
+      for (auto& b : inputs[k]) {
+        b = bit(rng) ? 1 : 0;
+      }
+    } else {
+      // pows 的底数取正数，指数在 [-2, 2] 内，避免大量溢出或 NaN 走到特殊路径。
+      FillRandom(inputs[k], dtype, powInputs && k == exponent ? -2.0f : 0.5f, 2.0f, rng);
+    }
+  }
+  std::vector<uint8_t> y(ElementCount(out) * elemBytes);
+  opcpu::RefOptions refOptions;
+  refOptions.threadNum = options.threadNum;
+  opcpu::Tensor yt{y.data(), dtype, out};
+  std::vector<int64_t> samples;
+  for (uint32_t r = 0; r < options.repeat; r++) {
+    auto start = std::chrono::steady_clock::now();
+    opcpu::RefStatus status;
+    if (pows) {
+      status = opcpu::Pows({inputs[0].data(), dtype, shapes[0]}, {inputs[1].data(), dtype, shapes[1]}, yt,
+                           options.signAware, refOptions);
+    } else if (op == optiling::TUNE_OP_POWS_SELECT) {
+      status = opcpu::PowsSelect({inputs[0].data(), DataType::BOOL, shapes[0]}, {inputs[1].data(), dtype, shapes[1]},
+                                 {inputs[2].data(), dtype, shapes[2]}, {inputs[3].data(), dtype, shapes[3]}, yt,
+                                 options.signAware, refOptions);
+    } else {
+      status = opcpu::SelectV2({inputs[0].data(), DataType::BOOL, shapes[0]}, {inputs[1].data(), dtype, shapes[1]},
+                               {inputs[2].data(), dtype, shapes[2]}, yt, false, refOptions);
+    }
+    auto end = std::chrono::steady_clock::now();
+    if (status != opcpu::RefStatus::OK) {
+      return -1;
+    }
+    samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+void PrintShape(const std::vector<int64_t>& shape)
+{
+  std::printf("[");
+  for (size_t i = 0; i < shape.size(); i++) {
+    std::printf("%s%lld", i == 0 ? "" : ", ", static_cast<long long>(shape[i]));
+  }
+  std::printf("]");
+}
+
+void RunOp(uint8_t op, const char* opName, const DtypeInfo* dtypes, size_t dtypeNum, const Options& options,
+           bool& first)
+{
+  for (size_t d = 0; d < dtypeNum; d++) {
+    uint32_t elemBytes = static_cast<uint32_t>(opcpu::DataTypeSize(dtypes[d].dtype));
+    for (CaseKind kind : tilingmodel::CASES) {
+      for (uint64_t size : SIZES) {
+        std::vector<int64_t> out;
+        std::vector<int64_t> bcast;
+        if (!tilingmodel::CaseShapes(kind, size, out, bcast)) {
+          continue;
+        }
+        std::vector<std::vector<int64_t>> shapes = tilingmodel::CaseInputs(op, out, bcast);
+        tilingmodel::OpTiling t;
+        const optiling::TunedTiling formula = {};
+        if (!tilingmodel::PlanOp(op, shapes, elemBytes, options.signAware, options.ubSize, options.coreNum,
+                                 options.formula ? &formula : nullptr, t)) {
+          std::fprintf(stderr, "%s %s %s %llu: tiling failed\n", opName, dtypes[d].name, tilingmodel::CaseName(kind),
+                       static_cast<unsigned long long>(size));
+          continue;
+        }
+        const optiling::TunedTiling* entry = nullptr;
+        if (!options.formula) {
+          entry = optiling::FindTunedTiling(op, elemBytes, t.baseKey, t.bcastClass, t.totalLength, options.ubSize,
+                                            options.coreNum);
+        }
+        int64_t refNs = size <= options.refLimit ? TimeReference(op, shapes, out, dtypes[d].dtype, options) : -1;
+
+        std::printf("%s\n    {\"op\": \"%s\", \"dtype\": \"%s\", \"case\": \"%s\", \"size\": %llu, \"shape\": ",
+                    first ? "" : ",", opName, dtypes[d].name, tilingmodel::CaseName(kind),
+                    static_cast<unsigned long long>(size));
+        PrintShape(out);
+        std::printf(", \"x2_shape\": ");
+        PrintShape(bcast);
+        std::printf(",\n     \"tuned\": %s, \"tiling_key\": %u, \"block_size\": %u, \"aiv_num\": %u, \"depth\": %u, \"tile_num\": %llu, "
+                    "\"ub_bytes\": %llu,\n     \"gm_read_bytes\": %llu, \"gm_write_bytes\": %llu, \"cpu_ref_ns\": ",
+                    entry != nullptr ? "true" : "false", t.tilingKey, t.blockSize, t.blockDim, t.depth, static_cast<unsigned long long>(t.tileNum),
+                    static_cast<unsigned long long>(t.ubBytes), static_cast<unsigned long long>(t.gmReadBytes),
+                    static_cast<unsigned long long>(t.gmWriteBytes));
+        if (refNs >= 0) {
+          std::printf("%lld}", static_cast<long long>(refNs));
+        } else {
+          std::printf("null}");
+        }
+        first = false;
+      }
+    }
+  }
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--sign-aware") {
+      options.signAware = true;
+    } else if (arg == "--formula") {
+      options.formula = true;
+    } else if (arg == "--ub" && hasValue) {
+      options.ubSize = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--cores" && hasValue) {
+      options.coreNum = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--ref-limit" && hasValue) {
+      options.refLimit = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--repeat" && hasValue) {
+      options.repeat = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--threads" && hasValue) {
+      options.threadNum = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      return false;
+    }
+  }
+  return options.coreNum != 0 && options.repeat != 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    std::fprintf(stderr, "usage: %s [--ub bytes] [--cores n] [--ref-limit elements] [--repeat n] [--threads n] "
+                 "[--sign-aware] [--formula]\n", argv[0]);
+    return 1;
+  }
+  uint32_t threads = options.threadNum != 0 ? options.threadNum : opcpu::ThreadPool::Instance().MaxThreads();
+  std::printf("{\n  \"config\": {\"ub_size\": %llu, \"core_num\": %u, \"sign_aware\": %s, \"formula\": %s, \"simd\": \"%s\", "
+              "\"cpu_threads\": %u, \"ref_limit\": %llu, \"repeat\": %u},\n  \"cases\": [",
+              static_cast<unsigned long long>(options.ubSize), options.coreNum, options.signAware ? "true" : "false",
+              options.formula ? "true" : "false", opcpu::SimdName(), threads, static_cast<unsigned long long>(options.refLimit), options.repeat);
+  bool first = true;
+  RunOp(optiling::TUNE_OP_POWS, "pows", POWS_DTYPES, sizeof(POWS_DTYPES) / sizeof(POWS_DTYPES[0]), options, first);
+  RunOp(optiling::TUNE_OP_SELECT_V2, "select_v2", SELECT_DTYPES, sizeof(SELECT_DTYPES) / sizeof(SELECT_DTYPES[0]), options, first);
+  RunOp(optiling::TUNE_OP_POWS_SELECT, "pows_select", POWS_DTYPES, sizeof(POWS_DTYPES) / sizeof(POWS_DTYPES[0]), options,
+        first);
+  std::printf("\n  ]\n}\n");
+  return 0;
+}
@@ -0,0 +1,97 @@
+// sign_aware Pows 的特殊值检查：±0、±inf、±1、NaN 等底数与各类指数组合，用 CPU 参考实现（common/op_cpu，
+// 与核函数的计算方式逐元素一致）计算，再与 std::pow 比较。
+//   scalar：x2 只有一个元素，走 KernelPows_ScalarExp 的 ONE / SQUARE / SQRT / RSQRT / RECIPROCAL / INTEGER / GENERAL；
+//   tensor：x2 逐元素给出，走 PowsSignFixup::Apply。
+// NaN、±inf 与 ±0 按类别与符号精确比较，其余结果允许 ln / exp 带来的相对误差。
+//
+// 用法：pows_special_check
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+#include "cpu_reference.h"
+
+namespace {
+
+const float INF = std::numeric_limits<float>::infinity();
+const float NAN_VALUE = std::numeric_limits<float>::quiet_NaN();
+const float REL_TOLERANCE = 1e-5f;
+
+const float BASES[] = {0.0f, -0.0f, INF, -INF, 1.0f, -1.0f, 2.0f, -2.0f, 0.25f, -0.25f, NAN_VALUE};
+const float EXPONENTS[] = {0.0f, -0.0f, 0.5f, -0.5f, 1.0f, -1.0f, 2.0f, 3.0f, -3.0f, 0.25f, -0.25f, 1.5f,
+                           INF, -INF, NAN_VALUE};
+
+bool Matches(float got, float want)
+{
+    if (std::isnan(want) || std::isnan(got)) {
+        return std::isnan(want) && std::isnan(got);
+    }
+    if (std::isinf(want) || want == 0.0f) {
+        return got == want && std::signbit(got) == std::signbit(want);
+    }
+    return std::fabs(got - want) <= REL_TOLERANCE * std::fabs(want);
+}
+
+int Report(const char* path, float base, float expo, float got, float want)
+{
+    std::printf("%s pow(%g, %g): got %g, std::pow %g\n", path, base, expo, got, want);
+    return 1;
+}
+
+}  // namespace
+
+int main()
+{
+    const int64_t baseNum = sizeof(BASES) / sizeof(BASES[0]);
+    const int64_t expoNum = sizeof(EXPONENTS) / sizeof(EXPONENTS[0]);
+    int failed = 0;
+    int checked = 0;
+
+    std::vector<float> y(baseNum);
+    for (float expo : EXPONENTS) {
+        opcpu::RefStatus status = opcpu::Pows({BASES, opcpu::DataType::FLOAT, {baseNum}},
+                                              {&expo, opcpu::DataType::FLOAT, {1}},
+                                              {y.data(), opcpu::DataType::FLOAT, {baseNum}}, true);
+        if (status != opcpu::RefStatus::OK) {
+            std::printf("scalar exponent %g: reference failed\n", expo);
+            return 1;
+        }
+        for (int64_t i = 0; i < baseNum; i++, checked++) {
+            float want = std::pow(BASES[i], expo);
+            if (!Matches(y[i], want)) {
+                failed += Report("scalar", BASES[i], expo, y[i], want);
+            }
+        }
+    }
+
+    // 底数与指数两两组合成同形状的 x1、x2。
+    std::vector<float> x1;
+    std::vector<float> x2;
+    for (float expo : EXPONENTS) {
+        for (float base : BASES) {
+            x1.push_back(base);
+            x2.push_back(expo);
+        }
+    }
+    int64_t total = baseNum * expoNum;
+    y.resize(total);
+    opcpu::RefStatus status = opcpu::Pows({x1.data(), opcpu::DataType::FLOAT, {total}},
+                                          {x2.data(), opcpu::DataType::FLOAT, {total}},
+                                          {y.data(), opcpu::DataType::FLOAT, {total}}, true);
+    if (status != opcpu::RefStatus::OK) {
+        std::printf("tensor exponent: reference failed\n");
+        return 1;
+    }
+    for (int64_t i = 0; i < total; i++, checked++) {
+        float want = std::pow(x1[i], x2[i]);
+        if (!Matches(y[i], want)) {
+            failed += Report("tensor", x1[i], x2[i], y[i], want);
+        }
+    }
+
+    std::printf("%d cases, %d failed\n", checked, failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+// 解析开启 OP_PROFILING 后核函数写入用户 workspace 的打点数据（布局见 common/include/op_profile_layout.h）。
+// 输入为从 Device 拷回的用户 workspace 二进制文件（系统 workspace 之后的部分），
+// 输出每个核各阶段耗时、停顿时间、搬运带宽，以及核间负载不均衡度。
+//
+// 用法：profile_decoder <workspace.bin> [--freq-mhz 50] [--tiles]
+//   --freq-mhz  GetSystemCycle 的计数频率，默认 50 MHz
+//   --tiles     额外打印每个核逐 Tile 的记录
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "op_profile_layout.h"
+
+namespace {
+
+struct CoreProfile {
+    uint64_t blockIdx;
+    uint64_t tileNum;
+    uint64_t wallCycles;
+    uint64_t stageCycles[OP_PROFILE_STAGE_NUM];
+    uint64_t stallCycles;
+    uint64_t readBytes;
+    uint64_t writeBytes;
+    std::vector<const uint64_t*> tiles;
+};
+
+const char* const STAGE_NAMES[OP_PROFILE_STAGE_NUM] = {"CopyIn", "Compute", "CopyOut"};
+
+void PrintUsage(const char* prog)
+{
+    std::fprintf(stderr, "usage: %s <workspace.bin> [--freq-mhz <MHz>] [--tiles]\n", prog);
+}
+
+double CyclesToUs(uint64_t cycles, double freqMhz)
+{
+    return static_cast<double>(cycles) / freqMhz;
+}
+
+// 字节数 / 微秒 换算为 GB/s
+double Bandwidth(uint64_t bytes, double us)
+{
+    return us > 0 ? static_cast<double>(bytes) / us / 1e3 : 0.0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::string path;
+    double freqMhz = 50.0;
+    bool printTiles = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--freq-mhz") == 0 && i + 1 < argc) {
+            freqMhz = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--tiles") == 0) {
+            printTiles = true;
+        } else if (argv[i][0] != '-' && path.empty()) {
+            path = argv[i];
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (path.empty() || freqMhz <= 0) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", path.c_str());
+        return 1;
+    }
+    std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    size_t regionNum = bytes.size() / OP_PROFILE_REGION_BYTES;
+    if (regionNum == 0) {
+        std::fprintf(stderr, "%s is smaller than one profile region (%u bytes)\n", path.c_str(), OP_PROFILE_REGION_BYTES);
+        return 1;
+    }
+    std::vector<uint64_t> words(regionNum * OP_PROFILE_REGION_WORDS);
+    std::memcpy(words.data(), bytes.data(), words.size() * sizeof(uint64_t));
+
+    // 区域数以第一个核记录的 blockNum 为准，未启动的核（magic 不匹配）跳过。
+    std::vector<CoreProfile> cores;
+    for (size_t r = 0; r < regionNum; r++) {
+        const uint64_t* region = words.data() + r * OP_PROFILE_REGION_WORDS;
+        if (region[OP_PROFILE_H_MAGIC] != OP_PROFILE_MAGIC) {
+            continue;
+        }
+        if (region[OP_PROFILE_H_VERSION] != OP_PROFILE_VERSION) {
+            std::fprintf(stderr, "region %zu: unsupported version %llu\n", r,
+                         static_cast<unsigned long long>(region[OP_PROFILE_H_VERSION]));
+            return 1;
+        }
+        if (cores.empty() && region[OP_PROFILE_H_BLOCK_NUM] < regionNum) {
+            regionNum = region[OP_PROFILE_H_BLOCK_NUM];
+        }
+        CoreProfile core;
+        core.blockIdx = region[OP_PROFILE_H_BLOCK_IDX];
+        core.tileNum = region[OP_PROFILE_H_TILE_NUM];
+        core.wallCycles = region[OP_PROFILE_H_END_CYCLE] - region[OP_PROFILE_H_START_CYCLE];
+        uint64_t busy = 0;
+        for (uint32_t s = 0; s < OP_PROFILE_STAGE_NUM; s++) {
+            core.stageCycles[s] = region[OP_PROFILE_H_STAGE_CYCLES + s];
+            busy += core.stageCycles[s];
+        }
+        core.stallCycles = core.wallCycles > busy ? core.wallCycles - busy : 0;
+        core.readBytes = region[OP_PROFILE_H_READ_BYTES];
+        core.writeBytes = region[OP_PROFILE_H_WRITE_BYTES];
+        uint64_t recorded = std::min<uint64_t>(core.tileNum, OP_PROFILE_MAX_TILES);
+        for (uint64_t t = 0; t < recorded; t++) {
+            core.tiles.push_back(region + OP_PROFILE_HEADER_WORDS + t * OP_PROFILE_TILE_WORDS);
+        }
+        cores.push_back(core);
+    }
+    if (cores.empty()) {
+        std::fprintf(stderr, "no valid profile region found in %s\n", path.c_str());
+        return 1;
+    }
+
+    std::printf("%-6s %8s %12s %12s %12s %12s %12s %10s %10s\n", "core", "tiles", "wall(us)", "CopyIn(us)",
+                "Compute(us)", "CopyOut(us)", "stall(us)", "GM GB/s", "stall%");
+    uint64_t maxWall = 0;
+    uint64_t sumWall = 0;
+    uint64_t totalBytes = 0;
+    uint64_t totalStages[OP_PROFILE_STAGE_NUM] = {0};
+    uint64_t totalStall = 0;
+    for (const CoreProfile& core : cores) {
+        double wallUs = CyclesToUs(core.wallCycles, freqMhz);
+        uint64_t coreBytes = core.readBytes + core.writeBytes;
+        std::printf("%-6llu %8llu %12.2f %12.2f %12.2f %12.2f %12.2f %10.2f %9.1f%%\n",
+                    static_cast<unsigned long long>(core.blockIdx), static_cast<unsigned long long>(core.tileNum), wallUs,
+                    CyclesToUs(core.stageCycles[OP_PROFILE_COPY_IN], freqMhz),
+                    CyclesToUs(core.stageCycles[OP_PROFILE_COMPUTE], freqMhz),
+                    CyclesToUs(core.stageCycles[OP_PROFILE_COPY_OUT], freqMhz),
+                    CyclesToUs(core.stallCycles, freqMhz), Bandwidth(coreBytes, wallUs),
+                    core.wallCycles ? 100.0 * core.stallCycles / core.wallCycles : 0.0);
+        maxWall = std::max(maxWall, core.wallCycles);
+        sumWall += core.wallCycles;
+        totalBytes += coreBytes;
+        for (uint32_t s = 0; s < OP_PROFILE_STAGE_NUM; s++) {
+            totalStages[s] += core.stageCycles[s];
+        }
+        totalStall += core.stallCycles;
+    }
+
+    // 不均衡度：最慢核耗时 / 平均耗时，1.0 表示完全均衡。
+    double meanWall = static_cast<double>(sumWall) / cores.size();
+    double maxWallUs = CyclesToUs(maxWall, freqMhz);
+    std::printf("\ncores: %zu  kernel time(us): %.2f  imbalance(max/mean): %.3f\n", cores.size(), maxWallUs,
+                meanWall > 0 ? maxWall / meanWall : 0.0);
+    std::printf("aggregate GM bandwidth: %.2f GB/s (%llu bytes)\n", Bandwidth(totalBytes, maxWallUs),
+                static_cast<unsigned long long>(totalBytes));
+    uint64_t totalAll = totalStall;
+    for (uint32_t s = 0; s < OP_PROFILE_STAGE_NUM; s++) {
+        totalAll += totalStages[s];
+    }
+    if (totalAll > 0) {
+        std::printf("time share:");
+        for (uint32_t s = 0; s < OP_PROFILE_STAGE_NUM; s++) {
+            std::printf("  %s %.1f%%", STAGE_NAMES[s], 100.0 * totalStages[s] / totalAll);
+        }
+        std::printf("  stall %.1f%%\n", 100.0 * totalStall / totalAll);
+    }
+
+    if (printTiles) {
+        for (const CoreProfile& core : cores) {
+            std::printf("\ncore %llu (%zu of %llu tiles recorded)\n", static_cast<unsigned long long>(core.blockIdx),
+                        core.tiles.size(), static_cast<unsigned long long>(core.tileNum));
+            std::printf("%8s %12s %12s %12s\n", "tile", "CopyIn(us)", "Compute(us)", "CopyOut(us)");
+            for (size_t t = 0; t < core.tiles.size(); t++) {
+                const uint64_t* tile = core.tiles[t];
+                std::printf("%8zu %12.2f %12.2f %12.2f\n", t, CyclesToUs(tile[OP_PROFILE_COPY_IN], freqMhz),
+                            CyclesToUs(tile[OP_PROFILE_COMPUTE], freqMhz), CyclesToUs(tile[OP_PROFILE_COPY_OUT], freqMhz));
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,232 @@
+// SelectV2 跳过一致 Tile（skip_uniform_tiles，TilingKey 7）的 CPU 仿真基准：
+// 按核函数的 Tile 划分遍历 condition，统计全 1 / 全 0 的 Tile 比例与 GM 读流量，
+// 并比较逐元素 select 与「先判断 condition、一致时只拷贝一个输入」的 Host 耗时，两者输出需一致。
+// 掩码分两类：
+//   random  ：每个元素独立以 density 的概率为 1，density 不为 0 / 1 时 Tile 几乎不会一致，用来观察判断本身的开销；
+//   padding ：[rows, row_length] 的 padding 掩码，每行前 valid 个元素为 1，valid 随行变化。
+// Host 上的耗时只反映相对趋势，读流量按 float 计算（condition 1 字节、x1 / x2 各 4 字节）。
+// 另按核函数的流水估算单核的设备周期（CycleModel，参数取 tiling_autotune 的默认代价模型，未用实测数据校准）：
+//   逐元素分支为双缓冲，稳态每个 Tile 取搬入、计算、搬出中的最大者；
+//   跳过一致 Tile 时下一个 Tile 的 x1 / x2 搬入要等判断完成，判断又要等当前 Tile 的计算，
+//   每个 Tile 为 计算 + 判断 + 数据搬入 串行，只有 condition 的搬入与搬出能与计算重叠。
+//
+// 用法：select_density_bench [tile_length] [repeat]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const uint64_t TOTAL_LENGTH = 1 << 22;
+
+struct Mask {
+  std::string name;
+  std::vector<uint8_t> cond;
+};
+
+Mask RandomMask(double density, uint32_t seed)
+{
+  Mask m;
+  char name[64];
+  std::snprintf(name, sizeof(name), "random density=%.2f", density);
+  m.name = name;
+  m.cond.resize(TOTAL_LENGTH);
+  std::mt19937 rng(seed);
+  std::bernoulli_distribution bit(density);
+  for (uint64_t i = 0; i < TOTAL_LENGTH; i++) {
+    m.cond[i] = bit(rng) ? 1 : 0;
+  }
+  return m;
+}
+
+// 每行有效长度在 [minValid, rowLength] 内均匀分布。
+Mask PaddingMask(uint64_t rowLength, double minValidRatio, uint32_t seed)
+{
+  Mask m;
+  char name[64];
+  std::snprintf(name, sizeof(name), "padding row=%llu valid>=%.0f%%", static_cast<unsigned long long>(rowLength),
+                minValidRatio * 100);
+  m.name = name;
+  m.cond.resize(TOTAL_LENGTH);
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<uint64_t> valid(static_cast<uint64_t>(rowLength * minValidRatio), rowLength);
+  for (uint64_t row = 0; row < TOTAL_LENGTH / rowLength; row++) {
+    uint64_t v = valid(rng);
+    for (uint64_t j = 0; j < rowLength; j++) {
+      m.cond[row * rowLength + j] = j < v ? 1 : 0;
+    }
+  }
+  return m;
+}
+
+struct Traffic {
+  uint64_t tiles;
+  uint64_t uniformTiles;
+  uint64_t baseBytes;
+  uint64_t skipBytes;
+  double baseCycles;
+  double skipCycles;
+};
+
+// 单位为周期。向量指令按 256 字节一个 repeat、每个 repeat 1 个周期计。
+struct CycleModel {
+  double coreBytesPerCycle = 64;   // 单核 MTE 带宽
+  double copyLatency = 600;        // 一次 DataCopy 的延迟
+  double tileOverhead = 200;       // 每个 Tile 的队列同步与标量开销
+  double scalarSync = 100;         // 判断时标量单元等待向量计算完成（V_S 同步）
+};
+
+double CopyCycles(const CycleModel& m, uint64_t bytes)
+{
+  return bytes == 0 ? 0 : m.copyLatency + bytes / m.coreBytesPerCycle;
+}
+
+double VectorCycles(uint64_t bytes)
+{
+  return static_cast<double>((bytes + 255) / 256);
+}
+
+// 逐元素 select：condition Cast 为 half、Compare 得到按位掩码、Select。
+double SelectCycles(const CycleModel& m, uint64_t length)
+{
+  return VectorCycles(length * 2) * 2 + VectorCycles(length * sizeof(float)) + m.tileOverhead;
+}
+
+// 判断一致：condition Cast 为 half 后 ReduceMax / ReduceMin，标量单元读取结果。
+double ClassifyCycles(const CycleModel& m, uint64_t length)
+{
+  return VectorCycles(length * 2) * 3 + m.scalarSync;
+}
+
+__attribute__((noinline)) void RunSelect(const uint8_t* cond, const float* x1, const float* x2, float* y,
+                                         uint64_t total)
+{
+  for (uint64_t i = 0; i < total; i++) {
+    y[i] = cond[i] ? x1[i] : x2[i];
+  }
+}
+
+// 与 KernelSelect_Uniform 相同：先对 condition 求最大 / 最小值再决定读哪些输入。
+__attribute__((noinline)) Traffic RunSkipUniform(const uint8_t* cond, const float* x1, const float* x2, float* y,
+                                                 uint64_t total, uint32_t tileLength, const CycleModel& m)
+{
+  Traffic t = {0, 0, 0, 0, 0, 0};
+  // 上一个 Tile 的计算（或拷贝）与搬出周期，首个 Tile 之前为 0。
+  double prevCompute = 0;
+  double prevOut = 0;
+  for (uint64_t start = 0; start < total; start += tileLength) {
+    uint64_t length = total - start < tileLength ? total - start : tileLength;
+    uint8_t maxValue = 0;
+    uint8_t minValue = 1;
+    for (uint64_t i = 0; i < length; i++) {
+      maxValue = cond[start + i] > maxValue ? cond[start + i] : maxValue;
+      minValue = cond[start + i] < minValue ? cond[start + i] : minValue;
+    }
+    t.tiles++;
+    t.baseBytes += length * (sizeof(uint8_t) + 2 * sizeof(float));
+    t.skipBytes += length * sizeof(uint8_t);
+    uint64_t loadBytes = 0;
+    double compute = 0;
+    if (minValue != 0 || maxValue == 0) {
+      const float* src = minValue != 0 ? x1 : x2;
+      std::copy(src + start, src + start + length, y + start);
+      t.uniformTiles++;
+      loadBytes = length * sizeof(float);
+      compute = VectorCycles(length * sizeof(float)) + m.tileOverhead;
+    } else {
+      RunSelect(cond + start, x1 + start, x2 + start, y + start, length);
+      loadBytes = length * 2 * sizeof(float);
+      compute = SelectCycles(m, length);
+    }
+    t.skipBytes += loadBytes;
+
+    double condIn = CopyCycles(m, length);
+    double out = CopyCycles(m, length * sizeof(float));
+    double baseIn = CopyCycles(m, length * (sizeof(uint8_t) + 2 * sizeof(float)));
+    double baseCompute = SelectCycles(m, length);
+    t.baseCycles += start == 0 ? baseIn + baseCompute + out : std::max({baseIn, baseCompute, out});
+    // 本 Tile 的 condition 搬入与上一个 Tile 的计算重叠，判断排在其后，数据搬入与上一个 Tile 的搬出重叠。
+    t.skipCycles += std::max(condIn, prevCompute) + ClassifyCycles(m, length) +
+        std::max(CopyCycles(m, loadBytes), prevOut);
+    prevCompute = compute;
+    prevOut = out;
+  }
+  t.skipCycles += prevCompute + prevOut;
+  return t;
+}
+
+double ElapsedNs(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  uint32_t tileLength = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 8192;
+  int repeat = argc > 2 ? std::atoi(argv[2]) : 10;
+  if (tileLength == 0 || repeat <= 0) {
+    std::fprintf(stderr, "usage: %s [tile_length] [repeat]\n", argv[0]);
+    return 1;
+  }
+
+  const CycleModel model;
+  std::vector<Mask> masks;
+  const double densities[] = {0.0, 0.01, 0.5, 0.99, 1.0};
+  for (double d : densities) {
+    masks.push_back(RandomMask(d, 1));
+  }
+  masks.push_back(PaddingMask(32768, 0.5, 2));
+  masks.push_back(PaddingMask(131072, 0.25, 3));
+  masks.push_back(PaddingMask(4096, 0.5, 4));
+
+  std::vector<float> x1(TOTAL_LENGTH), x2(TOTAL_LENGTH), yRef(TOTAL_LENGTH), ySkip(TOTAL_LENGTH);
+  for (uint64_t i = 0; i < TOTAL_LENGTH; i++) {
+    x1[i] = static_cast<float>(i);
+    x2[i] = -static_cast<float>(i);
+  }
+
+  std::printf("tile_length=%u elements=%llu\n", tileLength, static_cast<unsigned long long>(TOTAL_LENGTH));
+  std::printf("%-40s %9s %12s %12s %8s %12s %12s %12s %12s\n", "mask", "uniform", "base MB", "skip MB", "saved",
+              "base ns/el", "skip ns/el", "base Mcyc", "skip Mcyc");
+  int status = 0;
+  for (const Mask& m : masks) {
+    double density = 0;
+    for (uint8_t c : m.cond) {
+      density += c;
+    }
+    density /= TOTAL_LENGTH;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; r++) {
+      RunSelect(m.cond.data(), x1.data(), x2.data(), yRef.data(), TOTAL_LENGTH);
+    }
+    double baseNs = ElapsedNs(start) / (static_cast<double>(TOTAL_LENGTH) * repeat);
+
+    Traffic t = {0, 0, 0, 0, 0, 0};
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; r++) {
+      t = RunSkipUniform(m.cond.data(), x1.data(), x2.data(), ySkip.data(), TOTAL_LENGTH, tileLength, model);
+    }
+    double skipNs = ElapsedNs(start) / (static_cast<double>(TOTAL_LENGTH) * repeat);
+
+    bool match = yRef == ySkip;
+    if (!match) {
+      status = 1;
+    }
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s (%.2f)", m.name.c_str(), density);
+    std::printf("%-40s %8.1f%% %12.2f %12.2f %7.1f%% %12.3f %12.3f %12.2f %12.2f%s\n", name,
+                100.0 * t.uniformTiles / t.tiles, t.baseBytes / 1048576.0, t.skipBytes / 1048576.0,
+                100.0 * (t.baseBytes - t.skipBytes) / t.baseBytes, baseNs, skipNs, t.baseCycles / 1e6,
+                t.skipCycles / 1e6, match ? "" : "  MISMATCH");
+  }
+  return status;
+}
@@ -0,0 +1,226 @@
+// SelectV2 切分结果的检查：按 TilingFunc 的步骤（BroadcastPlanner、PackedConditionMatches、PlanSelectTiling、
+// FillSelectTilingData）为随机形状生成 SelectV2TilingData，再用 NumPy 广播规则逐元素核对。
+//   strides：按 y_shape 分解每个输出下标、乘以 TilingData 中的步长，须等于直接按原始形状求出的
+//            condition / x1 / x2 下标；打包时 condition 一段须全为 0，x1 / x2 的步长写在各自的位置；
+//   packed ：x1、x2 同形状且 condition 恰好 ceil(n / 8) 个字节时接受，TilingKey 为 KEY_PACKED；
+//            x1 或 x2 被广播、condition 长度不符时拒绝。
+//
+// 用法：select_plan_check [cases]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "broadcast_shape.h"
+#include "select_v2_tiling.h"
+#include "select_v2_plan.h"
+
+namespace {
+
+using optiling::BroadcastPlanner;
+
+const uint64_t UB_SIZE = 192 * 1024;
+const uint32_t CORE_NUM = 8;
+const uint32_t MAX_DIM = BroadcastPlanner::MAX_DIM_NUM;
+
+struct Shape {
+    std::vector<int64_t> dims;
+    size_t GetDimNum() const { return dims.size(); }
+    int64_t GetDim(size_t i) const { return dims[i]; }
+    void SetDimNum(size_t n) { dims.resize(n); }
+    void SetDim(size_t i, int64_t v) { dims[i] = v; }
+};
+
+// 输出第 e 个元素在 shape 中的下标：各输入右对齐，长度为 1 的维度取 0。
+uint64_t NaiveIndex(const Shape& out, const Shape& shape, uint64_t e)
+{
+    uint64_t index = 0;
+    uint64_t stride = 1;
+    size_t offset = out.GetDimNum() - shape.GetDimNum();
+    for (size_t i = out.GetDimNum(); i-- > 0;) {
+        uint64_t coord = e % out.GetDim(i);
+        e /= out.GetDim(i);
+        if (i >= offset) {
+            int64_t dim = shape.GetDim(i - offset);
+            index += (dim == 1 ? 0 : coord) * stride;
+            stride *= dim;
+        }
+    }
+    return index;
+}
+
+// 核函数的方式：按合并后的 y_shape 分解输出下标，乘以各维步长。
+uint64_t KernelIndex(const optiling::SelectV2TilingData& tiling, uint32_t input, uint64_t e)
+{
+    uint64_t index = 0;
+    for (uint32_t i = tiling.get_dim_num(); i-- > 0;) {
+        uint64_t dim = tiling.get_y_shape()[i];
+        index += (e % dim) * tiling.get_strides()[input * MAX_DIM + i];
+        e /= dim;
+    }
+    return index;
+}
+
+// 与 select_v2.cpp 中 ComputeTiling 的顺序一致，planner 不接受或打包校验失败时返回 false。
+bool Plan(const Shape* inputs, bool packed, optiling::SelectTilingPlan& plan, optiling::SelectV2TilingData& tiling)
+{
+    BroadcastPlanner planner;
+    for (uint32_t i = packed ? 1 : 0; i < 3; i++) {
+        planner.AddInput(inputs[i]);
+    }
+    if (!planner.Plan() || planner.OutSize() > UINT32_MAX) {
+        return false;
+    }
+    uint64_t conditionSize = 1;
+    for (int64_t dim : inputs[0].dims) {
+        conditionSize *= static_cast<uint64_t>(dim);
+    }
+    if (packed && !optiling::PackedConditionMatches(planner, conditionSize)) {
+        return false;
+    }
+    if (!optiling::PlanSelectTiling(planner, packed, false, sizeof(float), UB_SIZE, CORE_NUM, plan)) {
+        return false;
+    }
+    optiling::FillSelectTilingData(planner, packed, plan, tiling);
+    return true;
+}
+
+const char* CheckStrides(const Shape* inputs, bool packed, const optiling::SelectV2TilingData& tiling)
+{
+    static const char* const NAMES[] = {"condition", "x1", "x2"};
+    const Shape* pointers[] = {&inputs[0], &inputs[1], &inputs[2]};
+    Shape out;
+    uint32_t first = packed ? 1 : 0;
+    if (ge::InferBroadcastShape(pointers + first, 3 - first, BroadcastPlanner::MAX_INPUT_DIM_NUM, out) !=
+        ge::BroadcastShapeStatus::OK) {
+        return "InferBroadcastShape rejected a planned shape";
+    }
+    uint64_t total = 1;
+    for (int64_t dim : out.dims) {
+        total *= static_cast<uint64_t>(dim);
+    }
+    if (packed) {
+        for (uint32_t i = 0; i < MAX_DIM; i++) {
+            if (tiling.get_strides()[i] != 0) {
+                return "packed condition strides are not zero";
+            }
+        }
+    }
+    for (uint32_t k = first; k < 3; k++) {
+        for (uint64_t e = 0; e < total; e++) {
+            if (KernelIndex(tiling, k, e) != NaiveIndex(out, inputs[k], e)) {
+                std::printf("  %s: element %llu\n", NAMES[k], static_cast<unsigned long long>(e));
+                return "stride mismatch";
+            }
+        }
+    }
+    return nullptr;
+}
+
+void PrintShapes(const Shape* inputs)
+{
+    for (uint32_t k = 0; k < 3; k++) {
+        std::printf(" %s", ge::FormatShape(inputs[k]).c_str());
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    int cases = argc > 1 ? std::atoi(argv[1]) : 2000;
+    std::mt19937 rng(20240611);
+    auto pick = [&rng](uint32_t lo, uint32_t hi) {
+        return std::uniform_int_distribution<uint32_t>(lo, hi)(rng);
+    };
+
+    int failed = 0;
+    int checked = 0;
+    for (int c = 0; c < cases; c++) {
+        // 输出形状：1 到 5 维，每维 1 到 6。
+        Shape out;
+        uint32_t rank = pick(1, 5);
+        for (uint32_t i = 0; i < rank; i++) {
+            out.dims.push_back(pick(1, 6));
+        }
+        // 各输入去掉若干前导维，部分维度置 1（被广播）。
+        auto broadcastFrom = [&](const Shape& full) {
+            Shape shape;
+            uint32_t drop = pick(0, static_cast<uint32_t>(full.dims.size()) - 1);
+            for (size_t i = drop; i < full.dims.size(); i++) {
+                shape.dims.push_back(pick(0, 2) == 0 ? 1 : full.dims[i]);
+            }
+            return shape;
+        };
+
+        // 未打包：condition、x1、x2 任意广播。
+        Shape inputs[3] = {broadcastFrom(out), broadcastFrom(out), broadcastFrom(out)};
+        optiling::SelectTilingPlan plan;
+        optiling::SelectV2TilingData tiling;
+        checked++;
+        if (!Plan(inputs, false, plan, tiling)) {
+            std::printf("plain");
+            PrintShapes(inputs);
+            std::printf(": rejected\n");
+            failed++;
+        } else if (const char* error = CheckStrides(inputs, false, tiling)) {
+            std::printf("plain");
+            PrintShapes(inputs);
+            std::printf(": %s\n", error);
+            failed++;
+        }
+
+        // 打包：x1、x2 同形状时接受，且步长与未打包时 x1、x2 的一致。
+        uint64_t total = 1;
+        for (int64_t dim : out.dims) {
+            total *= static_cast<uint64_t>(dim);
+        }
+        Shape packedInputs[3] = {Shape{{static_cast<int64_t>((total + 7) / 8)}}, out, out};
+        optiling::SelectV2TilingData packedTiling;
+        checked++;
+        if (!Plan(packedInputs, true, plan, packedTiling) || plan.tilingKey % optiling::TILING_KEY_TRIPLE_BUFFER !=
+            optiling::KEY_PACKED) {
+            std::printf("packed");
+            PrintShapes(packedInputs);
+            std::printf(": not planned as KEY_PACKED\n");
+            failed++;
+        } else if (const char* error = CheckStrides(packedInputs, true, packedTiling)) {
+            std::printf("packed");
+            PrintShapes(packedInputs);
+            std::printf(": %s\n", error);
+            failed++;
+        }
+
+        // 打包且 x1 或 x2 被广播（f49685e 修复的情形中 TilingData 会错位）、或 condition 长度不符：须拒绝。
+        Shape rejected[3] = {packedInputs[0], out, out};
+        if (pick(0, 1) == 0) {
+            rejected[1 + pick(0, 1)] = broadcastFrom(out);
+            uint64_t size = 1;
+            for (int64_t dim : rejected[1].dims) {
+                size *= static_cast<uint64_t>(dim);
+            }
+            for (int64_t dim : rejected[2].dims) {
+                size *= static_cast<uint64_t>(dim);
+            }
+            if (size == total * total) {
+                continue;   // 恰好没有广播
+            }
+        } else {
+            rejected[0].dims[0] += pick(0, 1) == 0 ? 1 : -1;
+            if (rejected[0].dims[0] <= 0) {
+                continue;
+            }
+        }
+        checked++;
+        if (Plan(rejected, true, plan, packedTiling)) {
+            std::printf("packed");
+            PrintShapes(rejected);
+            std::printf(": accepted\n");
+            failed++;
+        }
+    }
+    std::printf("%d cases, %d failed\n", checked, failed);
+    return failed == 0 ? 0 : 1;
+}
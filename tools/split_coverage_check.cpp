@@ -0,0 +1,93 @@
+// 连续分支核间切分的覆盖检查：按 SplitElementwise 的结果，用核函数的 ElementwiseBlock（kernel_split.h）
+// 求各核的区间与 Tile 划分（ElementwisePipeline、KernelSelect_Uniform 等逐元素核函数共用这一划分），
+// 确认 [0, totalLength) 中的每个元素恰好被写回一次，且除最后一个核外每个核的长度都是 coreUnit 的整数倍
+// （各核在 GM 上的起始地址保持 32 字节对齐）。
+// 扫描的规模取 0、1、coreUnit 与 coreNum * coreUnit 前后的边界值以及不对齐的大长度，
+// 覆盖最后一个核的尾部元素、只有一个核、核数多于 coreUnit 个数与最后一个 Tile 不满的情况。
+//
+// 用法：split_coverage_check
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "elementwise_tiling.h"
+#include "kernel_split.h"
+
+namespace {
+
+// 检查失败时返回描述，成功返回 nullptr。
+const char* Replay(uint32_t total, uint32_t coreNum, uint32_t coreUnit, uint32_t tileLength)
+{
+    optiling::ElementwiseSplit split = optiling::SplitElementwise(total, coreNum, coreUnit);
+    if (split.coreNum == 0 || split.coreNum > coreNum) {
+        return "core count out of range";
+    }
+    std::vector<uint8_t> writes(total, 0);
+    for (uint32_t blockIdx = 0; blockIdx < split.coreNum; blockIdx++) {
+        // GetBlockNum() 为 TilingFunc 设置的 split.coreNum。
+        ElementwiseBlock block;
+        block.Init(blockIdx, split.coreNum, coreUnit, tileLength, split.coreSize, split.coreRemain, split.coreTail);
+        if (blockIdx != split.coreNum - 1 && block.length % coreUnit != 0) {
+            return "core length not a multiple of coreUnit";
+        }
+        for (uint32_t i = 0; i < block.tileNum; i++) {
+            uint32_t length = block.TileLength(i);
+            if (length == 0 || length > tileLength) {
+                return "tile length out of range";
+            }
+            uint64_t begin = static_cast<uint64_t>(block.offset) + static_cast<uint64_t>(i) * tileLength;
+            for (uint64_t e = begin; e < begin + length; e++) {
+                if (e >= total) {
+                    return "write out of range";
+                }
+                if (writes[e]++ != 0) {
+                    return "element written twice";
+                }
+            }
+        }
+    }
+    for (uint32_t e = 0; e < total; e++) {
+        if (writes[e] == 0) {
+            return "element never written";
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+int main()
+{
+    // 打包掩码的切分粒度为 256 个元素，其余为 ALIGN_NUM * 8（ALIGN_NUM = 32 字节 / 元素宽度）。
+    const uint32_t units[] = {32, 64, 128, 256};
+    const uint32_t cores[] = {1, 2, 3, 7, 8, 20, 24, 40, 48};
+    int cases = 0;
+    int failed = 0;
+    for (uint32_t coreUnit : units) {
+        uint32_t alignNum = coreUnit / 8;
+        // Tile 长度为 ALIGN_NUM 的整数倍：小于、等于、不整除 coreUnit 以及较大的 Tile。
+        const uint32_t tiles[] = {alignNum, alignNum * 3, coreUnit, coreUnit * 5 + alignNum, 8192};
+        for (uint32_t coreNum : cores) {
+            uint32_t full = coreNum * coreUnit;
+            const uint32_t sizes[] = {
+                0, 1, alignNum - 1, alignNum, coreUnit - 1, coreUnit, coreUnit + 1,
+                full - 1, full, full + 1, full + coreUnit - 1, full * 3 + coreUnit / 2,
+                full * 7 + coreUnit * (coreNum - 1) + 5, 65537, 1000003,
+            };
+            for (uint32_t total : sizes) {
+                for (uint32_t tileLength : tiles) {
+                    cases++;
+                    const char* error = Replay(total, coreNum, coreUnit, tileLength);
+                    if (error != nullptr) {
+                        std::printf("total=%u cores=%u unit=%u tile=%u: %s\n", total, coreNum, coreUnit, tileLength,
+                                    error);
+                        failed++;
+                    }
+                }
+            }
+        }
+    }
+    std::printf("%d cases, %d failed\n", cases, failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,386 @@
+// 离线切分调优：对每个 (算子, 元素宽度, TilingKey, 广播方式, 规模档位, 平台) 扫描 Tile 长度上限、核数上限与队列深度，
+// 用解析的带宽 / 计算代价模型给每个候选打分，把明显优于公式的方案写成 common/op_host/tuned_tiling_table.h。
+// 候选方案直接交给 PlanPowsTiling / PlanSelectTiling / PlanPowsSelectTiling 切分，与 TilingFunc 运行时得到的结果完全一致。
+//
+// 代价模型（单位为周期）：
+//   每个 Tile 的搬入 = 搬运延迟 + 搬入字节 / 单核带宽 + 广播输入的逐行搬运或 GetValue，
+//   计算 = 向量指令数 × 256 字节 repeat 数 + Tile 固定开销，搬出 = 搬运延迟 + 搬出字节 / 单核带宽；
+//   单核带宽取 min(单核 MTE 带宽, GM 总带宽 / 核数)；队列深度为 depth 时后续 Tile 的搬运延迟摊到 depth - 1 个 Tile 上，
+//   稳态每个 Tile 取搬入、计算、搬出中的最大者，首个 Tile 三者串行；
+//   算子耗时 = 启动开销 + 每核启动开销 × 核数 + 最慢的核的耗时。
+// 每个档位取 3 个样本规模，候选得分为各样本相对公式的耗时比的均值，比公式快 MIN_GAIN 以上才写入表项。
+// 模型参数可通过命令行调整，用实测数据校准后重新生成；op_tiling_bench 与 --formula 的结果对比可查看表项的效果。
+// 表项只在 UB 字节数与核数完全相同的平台上命中；不给 --platform 时按算子注册的 ascend310b 调优。
+//
+// 用法：tiling_autotune [--platform ub_bytes,cores]... [--gm-bw bytes_per_cycle] [--core-bw bytes_per_cycle]
+//                       [--copy-latency cycles] [--tile-overhead cycles] [--output file]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "tiling_model.h"
+
+namespace {
+
+using optiling::TunedTiling;
+using tilingmodel::CaseKind;
+using tilingmodel::OpTiling;
+
+const double MIN_GAIN = 0.02;
+const uint32_t TILE_DIVISORS[] = {2, 3, 4, 6, 8};
+const uint32_t CORE_CAPS[] = {32, 24, 16, 8, 4, 2, 1};
+const uint32_t SAMPLE_NUM = 3;
+const uint64_t MAX_SIZE = 1ULL << 26;
+
+struct Platform {
+  uint64_t ubSize;
+  uint32_t coreNum;
+};
+
+struct CostModel {
+  double gmBytesPerCycle = 800;     // GM 总带宽
+  double coreBytesPerCycle = 64;    // 单核 MTE 带宽
+  double copyLatency = 600;         // 一次 DataCopy 的延迟
+  double copyIssue = 30;            // 广播输入逐行搬运时每行的发射开销
+  double scalarRead = 200;          // GetValue 读 GM 中的一个元素
+  double tileOverhead = 200;        // 每个 Tile 的队列同步与标量开销
+  double launchBase = 4000;
+  double launchPerCore = 50;
+};
+
+struct Options {
+  std::vector<Platform> platforms;
+  CostModel model;
+  std::string output;
+};
+
+// 每 256 字节 repeat 的向量指令数与计算时的元素宽度，按核函数的主要计算估算。
+void VectorWork(const OpTiling& t, uint8_t op, double& instrs, double& computeBytes)
+{
+  if (op == optiling::TUNE_OP_POWS) {
+    // Ln、Mul、Exp 在 float 上计算；half / bf16 另需两次输入转换与一次输出转换；sign_aware 的修正约 12 条指令。
+    computeBytes = sizeof(float);
+    instrs = 3;
+    if (t.elemBytes != sizeof(float)) {
+      instrs += t.baseKey % optiling::POWS_KEY_SIGN_AWARE == optiling::POWS_BRANCH_SCALAR_EXP ? 2 : 3;
+    }
+    if (t.baseKey > optiling::POWS_KEY_SIGN_AWARE) {
+      instrs += 12;
+    }
+  } else if (op == optiling::TUNE_OP_POWS_SELECT) {
+    // 逐元素的 pow 同上（没有标量指数分支），再加上 condition 转 half、Compare、Select。
+    computeBytes = sizeof(float);
+    instrs = 3 + 3;
+    if (t.elemBytes != sizeof(float)) {
+      instrs += 3;
+    }
+    if (t.baseKey > optiling::POWS_SELECT_KEY_SIGN_AWARE) {
+      instrs += 12;
+    }
+  } else {
+    // condition 转 half、Compare、Select；8 字节类型按两个 float 选择。
+    computeBytes = t.elemBytes == sizeof(uint64_t) ? sizeof(float) * 2 : std::max<uint32_t>(t.elemBytes, 2);
+    instrs = 3;
+  }
+}
+
+// 一个核处理 tiles 个平均 n 个元素（每个 Tile rows 行）的 Tile 的耗时。
+double CoreCycles(const OpTiling& t, uint8_t op, const CostModel& m, uint64_t tiles, double n, double rows)
+{
+  if (tiles == 0) {
+    return 0;
+  }
+  double bw = std::min(m.coreBytesPerCycle, m.gmBytesPerCycle / t.blockDim);
+  double instrs;
+  double computeBytes;
+  VectorWork(t, op, instrs, computeBytes);
+  double rowCost = 0;
+  if (t.broadcast) {
+    // 最内维连续的广播输入逐行搬运，最内维被广播的输入逐行 GetValue 后 Duplicate。
+    uint32_t rowCopies = t.streamBytes > 0 ? 1 : 0;
+    rowCost = rows * (rowCopies * m.copyIssue + t.rowScalarReads * (m.scalarRead + 1));
+  }
+  double inBw = n * t.streamBytes / bw + rowCost;
+  double outBw = n * t.elemBytes / bw;
+  double compute = instrs * std::ceil(n * computeBytes / 256) + m.tileOverhead;
+  double hidden = m.copyLatency / std::max<uint32_t>(t.depth - 1, 1);
+  double steady = std::max({inBw + hidden, compute, outBw + hidden});
+  double first = inBw + compute + outBw + 2 * m.copyLatency + t.coreScalarReads * m.scalarRead;
+  return first + (tiles - 1) * steady;
+}
+
+double KernelCycles(const OpTiling& t, uint8_t op, const CostModel& m)
+{
+  double slowest = 0;
+  if (t.broadcast) {
+    uint64_t perCore = (t.rows.tileNum + t.blockDim - 1) / t.blockDim;
+    double n = static_cast<double>(t.totalLength) / std::max<uint64_t>(t.rows.tileNum, 1);
+    double rows = t.rows.colTile == t.rowLength ? n / t.rowLength : 1;
+    slowest = CoreCycles(t, op, m, perCore, n, rows);
+  } else {
+    for (uint32_t i = 0; i < t.split.coreNum; i++) {
+      uint64_t length = tilingmodel::CoreLength(t, i);
+      uint64_t tiles = (length + t.blockSize - 1) / t.blockSize;
+      if (tiles != 0) {
+        slowest = std::max(slowest, CoreCycles(t, op, m, tiles, static_cast<double>(length) / tiles, 1));
+      }
+    }
+  }
+  return m.launchBase + m.launchPerCore * t.blockDim + slowest;
+}
+
+// 档位 bucket 内的样本规模：下界、几何中点与上界附近；row / col 取 BROADCAST_COLS 的整数倍且至少两行。
+std::vector<uint64_t> BucketSamples(uint32_t bucket, CaseKind kind)
+{
+  uint64_t lo = bucket == 0 ? 256 : (1ULL << optiling::TUNE_SIZE_BUCKET_MIN_LOG2) << (2 * (bucket - 1));
+  uint64_t hi = bucket + 1 == optiling::TUNE_SIZE_BUCKET_NUM ? MAX_SIZE + 1 :
+      (1ULL << optiling::TUNE_SIZE_BUCKET_MIN_LOG2) << (2 * bucket);
+  uint64_t points[SAMPLE_NUM] = {lo, static_cast<uint64_t>(std::sqrt(static_cast<double>(lo) * hi)), hi - 1};
+  std::vector<uint64_t> samples;
+  for (uint64_t size : points) {
+    if (kind == CaseKind::ROW || kind == CaseKind::COL) {
+      size = std::max<uint64_t>(size / tilingmodel::BROADCAST_COLS, 2) * tilingmodel::BROADCAST_COLS;
+    }
+    if (size < hi && optiling::TuneSizeBucket(size) == bucket &&
+        std::find(samples.begin(), samples.end(), size) == samples.end()) {
+      samples.push_back(size);
+    }
+  }
+  return samples;
+}
+
+struct Group {
+  uint8_t op;
+  uint32_t elemBytes;
+  bool signAware;
+};
+
+// 对一个 (算子, 宽度, 广播方式, 档位, 平台) 扫描候选，返回是否找到优于公式的方案。
+bool TuneGroup(const Group& g, CaseKind kind, uint32_t bucket, const Platform& p, const CostModel& m,
+               TunedTiling& best, double& bestScore)
+{
+  std::vector<std::vector<std::vector<int64_t>>> cases;
+  std::vector<double> baseline;
+  const TunedTiling formula = {};
+  OpTiling base = {};
+  for (uint64_t size : BucketSamples(bucket, kind)) {
+    std::vector<int64_t> out;
+    std::vector<int64_t> bcast;
+    if (!tilingmodel::CaseShapes(kind, size, out, bcast)) {
+      continue;
+    }
+    auto shapes = tilingmodel::CaseInputs(g.op, out, bcast);
+    OpTiling t;
+    if (!tilingmodel::PlanOp(g.op, shapes, g.elemBytes, g.signAware, p.ubSize, p.coreNum, &formula, t)) {
+      continue;
+    }
+    // 档位内的样本需落在同一个 TilingKey 与广播方式上，表项才能按它们查找。
+    if (!cases.empty() && (t.baseKey != base.baseKey || t.bcastClass != base.bcastClass)) {
+      continue;
+    }
+    base = t;
+    cases.push_back(shapes);
+    baseline.push_back(KernelCycles(t, g.op, m));
+  }
+  if (cases.empty()) {
+    return false;
+  }
+
+  // 以双缓冲下 UB 能容纳的最大 Tile 为基准取若干比例作为 Tile 长度上限。
+  TunedTiling probe = {};
+  probe.depth = optiling::PIPELINE_DEPTH_DOUBLE;
+  OpTiling maxTile;
+  tilingmodel::PlanOp(g.op, cases[0], g.elemBytes, g.signAware, p.ubSize, p.coreNum, &probe, maxTile);
+  std::vector<uint32_t> tiles = {0};
+  for (uint32_t div : TILE_DIVISORS) {
+    uint32_t tile = maxTile.blockSize / div / maxTile.coreUnit * maxTile.coreUnit;
+    if (tile != 0 && std::find(tiles.begin(), tiles.end(), tile) == tiles.end()) {
+      tiles.push_back(tile);
+    }
+  }
+  std::vector<uint32_t> cores = {0};
+  for (uint32_t cap : CORE_CAPS) {
+    if (cap < p.coreNum) {
+      cores.push_back(cap);
+    }
+  }
+  // 只有走 ElementwisePipeline 的分支可以选择队列深度。
+  bool pipelined = !base.broadcast && !(g.op == optiling::TUNE_OP_SELECT_V2 &&
+      (base.baseKey == optiling::KEY_SCALAR_CONDITION || base.baseKey == optiling::KEY_UNIFORM));
+  std::vector<uint32_t> depths = {0};
+  if (pipelined) {
+    depths.push_back(optiling::PIPELINE_DEPTH_DOUBLE);
+    depths.push_back(optiling::PIPELINE_DEPTH_TRIPLE);
+  }
+
+  bestScore = 1.0;
+  bool found = false;
+  for (uint32_t tile : tiles) {
+    for (uint32_t core : cores) {
+      for (uint32_t depth : depths) {
+        if (tile == 0 && core == 0 && depth == 0) {
+          continue;
+        }
+        TunedTiling cand = {};
+        cand.tileLength = tile;
+        cand.coreNum = core;
+        cand.depth = depth;
+        double score = 0;
+        bool valid = true;
+        for (size_t i = 0; i < cases.size() && valid; i++) {
+          OpTiling t;
+          valid = tilingmodel::PlanOp(g.op, cases[i], g.elemBytes, g.signAware, p.ubSize, p.coreNum, &cand, t);
+          score += valid ? KernelCycles(t, g.op, m) / baseline[i] : 0;
+        }
+        score /= cases.size();
+        if (valid && score < bestScore - 1e-9) {
+          bestScore = score;
+          best = cand;
+          found = true;
+        }
+      }
+    }
+  }
+  if (!found || bestScore > 1.0 - MIN_GAIN) {
+    return false;
+  }
+  best.op = g.op;
+  best.elemBytes = static_cast<uint8_t>(g.elemBytes);
+  best.baseKey = static_cast<uint16_t>(base.baseKey);
+  best.bcastClass = base.bcastClass;
+  best.sizeBucket = static_cast<uint8_t>(bucket);
+  best.platformCores = p.coreNum;
+  best.ubSize = p.ubSize;
+  return true;
+}
+
+const char* OpName(uint8_t op)
+{
+  if (op == optiling::TUNE_OP_POWS) {
+    return "pows";
+  }
+  return op == optiling::TUNE_OP_POWS_SELECT ? "pows_select" : "select_v2";
+}
+
+void WriteTable(FILE* f, const std::vector<TunedTiling>& entries, const std::vector<double>& scores,
+                const Options& options, const std::string& command)
+{
+  const CostModel& m = options.model;
+  std::fprintf(f, "// 由 tools/tiling_autotune 生成，请勿手工修改。\n");
+  std::fprintf(f, "//   %s\n", command.c_str());
+  std::fprintf(f, "// 代价模型：gm_bw=%g core_bw=%g copy_latency=%g tile_overhead=%g（字节 / 周期、周期）\n",
+               m.gmBytesPerCycle, m.coreBytesPerCycle, m.copyLatency, m.tileOverhead);
+  std::fprintf(f, "#ifndef TUNED_TILING_TABLE_H\n#define TUNED_TILING_TABLE_H\n\nnamespace optiling {\n");
+  std::fprintf(f, "const TunedTiling TUNED_TILING_TABLE[] = {\n");
+  std::fprintf(f, "  // op, elemBytes, baseKey, bcastClass, sizeBucket, platformCores, ubSize, tileLength, coreNum, depth\n");
+  for (size_t i = 0; i < entries.size(); i++) {
+    const TunedTiling& e = entries[i];
+    std::fprintf(f, "  {%u, %u, %u, %u, %u, %u, %llu, %u, %u, %u},   // %s, %.1f%%\n", e.op, e.elemBytes, e.baseKey,
+                 e.bcastClass, e.sizeBucket, e.platformCores, static_cast<unsigned long long>(e.ubSize), e.tileLength,
+                 e.coreNum, e.depth, OpName(e.op), (1.0 - scores[i]) * 100);
+  }
+  std::fprintf(f, "  {0, 0, 0, 0, 0, 0, 0, 0, 0, 0},\n};\n}\n\n#endif  // TUNED_TILING_TABLE_H\n");
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const char* value = argv[++i];
+    if (arg == "--platform") {
+      Platform p;
+      char* end = nullptr;
+      p.ubSize = std::strtoull(value, &end, 10);
+      if (end == nullptr || *end != ',') {
+        return false;
+      }
+      p.coreNum = static_cast<uint32_t>(std::strtoul(end + 1, nullptr, 10));
+      if (p.ubSize == 0 || p.coreNum == 0) {
+        return false;
+      }
+      options.platforms.push_back(p);
+    } else if (arg == "--gm-bw") {
+      options.model.gmBytesPerCycle = std::strtod(value, nullptr);
+    } else if (arg == "--core-bw") {
+      options.model.coreBytesPerCycle = std::strtod(value, nullptr);
+    } else if (arg == "--copy-latency") {
+      options.model.copyLatency = std::strtod(value, nullptr);
+    } else if (arg == "--tile-overhead") {
+      options.model.tileOverhead = std::strtod(value, nullptr);
+    } else if (arg == "--output") {
+      options.output = value;
+    } else {
+      return false;
+    }
+  }
+  if (options.platforms.empty()) {
+    options.platforms.push_back({tilingmodel::TARGET_UB_SIZE, tilingmodel::TARGET_CORE_NUM});
+  }
+  return options.model.gmBytesPerCycle > 0 && options.model.coreBytesPerCycle > 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    std::fprintf(stderr, "usage: %s [--platform ub_bytes,cores]... [--gm-bw n] [--core-bw n] [--copy-latency n] "
+                 "[--tile-overhead n] [--output file]\n", argv[0]);
+    return 1;
+  }
+  std::string command = "tiling_autotune";
+  for (int i = 1; i < argc; i++) {
+    command += std::string(" ") + argv[i];
+  }
+
+  // pows / pows_select 的 half 与 bf16 宽度相同，共用表项；sign_aware 的 TilingKey 不同，分开调优。
+  const Group groups[] = {
+    {optiling::TUNE_OP_POWS, 4, false}, {optiling::TUNE_OP_POWS, 2, false},
+    {optiling::TUNE_OP_POWS, 4, true},  {optiling::TUNE_OP_POWS, 2, true},
+    {optiling::TUNE_OP_SELECT_V2, 1, false}, {optiling::TUNE_OP_SELECT_V2, 2, false},
+    {optiling::TUNE_OP_SELECT_V2, 4, false}, {optiling::TUNE_OP_SELECT_V2, 8, false},
+    {optiling::TUNE_OP_POWS_SELECT, 4, false}, {optiling::TUNE_OP_POWS_SELECT, 2, false},
+    {optiling::TUNE_OP_POWS_SELECT, 4, true},  {optiling::TUNE_OP_POWS_SELECT, 2, true},
+  };
+  std::vector<TunedTiling> entries;
+  std::vector<double> scores;
+  for (const Platform& p : options.platforms) {
+    for (const Group& g : groups) {
+      for (CaseKind kind : tilingmodel::CASES) {
+        for (uint32_t bucket = 0; bucket < optiling::TUNE_SIZE_BUCKET_NUM; bucket++) {
+          TunedTiling best;
+          double score;
+          if (TuneGroup(g, kind, bucket, p, options.model, best, score)) {
+            entries.push_back(best);
+            scores.push_back(score);
+            std::fprintf(stderr, "%s width=%u sign_aware=%d %s bucket=%u ub=%llu cores=%u: tile=%u cores=%u depth=%u "
+                         "(%.1f%% faster)\n", OpName(g.op), g.elemBytes, g.signAware, tilingmodel::CaseName(kind),
+                         bucket, static_cast<unsigned long long>(p.ubSize), p.coreNum, best.tileLength, best.coreNum,
+                         best.depth, (1.0 - score) * 100);
+          }
+        }
+      }
+    }
+  }
+
+  FILE* f = options.output.empty() ? stdout : std::fopen(options.output.c_str(), "w");
+  if (f == nullptr) {
+    std::fprintf(stderr, "cannot open %s\n", options.output.c_str());
+    return 1;
+  }
+  WriteTable(f, entries, scores, options, command);
+  if (f != stdout) {
+    std::fclose(f);
+  }
+  std::fprintf(stderr, "%zu entries\n", entries.size());
+  return 0;
+}
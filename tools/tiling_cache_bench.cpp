@@ -0,0 +1,234 @@
+// TilingPlanCache 的 Host 侧微基准：比较每次重新计算切分与命中缓存直接拷贝 TilingData 的单次耗时。
+// 未命中路径与 Pows / SelectV2 的 ComputeTiling 相同：BroadcastPlanner 合并形状，PlanPowsTiling / PlanSelectTiling
+// 切分，FillPowsTilingData / FillSelectTilingData 填写算子真实的 PowsTilingData / SelectV2TilingData 并序列化
+// （TilingData 的宏由 tools/host_shim 提供）。缓存中存放的就是这份序列化结果，计时后逐字节核对命中路径写回的数据。
+// gert::TilingContext 依赖 CANN 运行时，这里只实现 TilingPlanCache 用到的接口；两条路径都需要的平台信息查询不计入。
+//
+// 用法：tiling_cache_bench [launches] [distinct_shapes]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "tiling_cache.h"
+#include "pows_tiling.h"
+#include "pows_plan.h"
+#include "select_v2_tiling.h"
+#include "select_v2_plan.h"
+
+namespace {
+
+using optiling::BroadcastPlanner;
+using optiling::TilingPlan;
+using optiling::TilingPlanCache;
+using optiling::TilingSignature;
+
+const uint64_t UB_SIZE = 192 * 1024;
+const uint32_t CORE_NUM = 8;
+const uint32_t HALF_BYTES = 2;       // 用例的 dtype 为 float16
+const int64_t SOC_VERSION = 0;       // 签名中 SoC 一项，单一平台下取常量
+
+struct Shape {
+  std::vector<int64_t> dims;
+  size_t GetDimNum() const { return dims.size(); }
+  int64_t GetDim(size_t i) const { return dims[i]; }
+};
+
+class RawTilingData {
+public:
+  RawTilingData() : buffer(4096), size(0) {}
+  void* GetData() { return buffer.data(); }
+  size_t GetDataSize() const { return size; }
+  void SetDataSize(size_t s) { size = s; }
+  size_t GetCapacity() const { return buffer.size(); }
+
+private:
+  std::vector<uint8_t> buffer;
+  size_t size;
+};
+
+// TilingPlanCache 用到的 gert::TilingContext 接口，外加各输入的形状。
+class HostTilingContext {
+public:
+  HostTilingContext() : tilingKey(0), blockDim(0), workspace(0) {}
+  RawTilingData* GetRawTilingData() { return &raw; }
+  size_t* GetWorkspaceSizes(size_t) { return &workspace; }
+  void SetTilingKey(uint64_t key) { tilingKey = key; }
+  uint64_t GetTilingKey() const { return tilingKey; }
+  void SetBlockDim(uint32_t dim) { blockDim = dim; }
+  uint32_t GetBlockDim() const { return blockDim; }
+
+  std::vector<Shape> inputs;
+
+private:
+  RawTilingData raw;
+  uint64_t tilingKey;
+  uint32_t blockDim;
+  size_t workspace;
+};
+
+// 与 ComputeTiling 的结尾相同：序列化 TilingData，写入 TilingKey、核数与 workspace（未开启 OP_PROFILING 时为 0）。
+template <typename TilingDataT>
+bool SaveTiling(HostTilingContext* ctx, const TilingDataT& tiling, uint32_t tilingKey, uint32_t blockDim)
+{
+  tiling.SaveToBuffer(ctx->GetRawTilingData()->GetData(), ctx->GetRawTilingData()->GetCapacity());
+  ctx->GetRawTilingData()->SetDataSize(tiling.GetDataSize());
+  ctx->SetTilingKey(tilingKey);
+  ctx->SetBlockDim(blockDim);
+  *ctx->GetWorkspaceSizes(1) = 0;
+  return true;
+}
+
+bool PowsTiling(HostTilingContext* ctx)
+{
+  BroadcastPlanner planner;
+  for (const Shape& shape : ctx->inputs) {
+    planner.AddInput(shape);
+  }
+  if (!planner.Plan()) {
+    return false;
+  }
+  optiling::PowsTilingPlan plan;
+  if (!optiling::PlanPowsTiling(planner, HALF_BYTES, false, UB_SIZE, CORE_NUM, plan)) {
+    return false;
+  }
+  optiling::PowsTilingData tiling;
+  optiling::FillPowsTilingData(planner, plan, tiling);
+  return SaveTiling(ctx, tiling, plan.tilingKey, plan.blockDim);
+}
+
+bool SelectTiling(HostTilingContext* ctx)
+{
+  BroadcastPlanner planner;
+  for (const Shape& shape : ctx->inputs) {
+    planner.AddInput(shape);
+  }
+  if (!planner.Plan()) {
+    return false;
+  }
+  optiling::SelectTilingPlan plan;
+  if (!optiling::PlanSelectTiling(planner, false, false, HALF_BYTES, UB_SIZE, CORE_NUM, plan)) {
+    return false;
+  }
+  optiling::SelectV2TilingData tiling;
+  optiling::FillSelectTilingData(planner, false, plan, tiling);
+  return SaveTiling(ctx, tiling, plan.tilingKey, plan.blockDim);
+}
+
+typedef bool (*TilingFn)(HostTilingContext*);
+
+// 与 TilingFunc 相同的缓存路径：签名依次为各输入形状、dtype、属性（均为默认值）、SoC、核数、UB 大小。
+bool CachedTiling(HostTilingContext* ctx, TilingPlanCache& cache, TilingFn compute, uint32_t attrNum)
+{
+  TilingSignature signature;
+  for (const Shape& shape : ctx->inputs) {
+    signature.AppendShape(shape);
+  }
+  signature.Append(HALF_BYTES);
+  for (uint32_t i = 0; i < attrNum; i++) {
+    signature.Append(0);
+  }
+  signature.Append(SOC_VERSION).Append(CORE_NUM).Append(static_cast<int64_t>(UB_SIZE));
+  if (cache.LookupAndApply(signature, ctx)) {
+    return true;
+  }
+  if (!compute(ctx)) {
+    return false;
+  }
+  TilingPlan plan;
+  if (optiling::CaptureTilingPlan(ctx, plan)) {
+    cache.Insert(signature, plan);
+  }
+  return true;
+}
+
+// 类似解码循环的形状集合：[batch, seq, hidden]，奇数下标的最后一个输入逐通道广播为 [1, 1, hidden]。
+std::vector<HostTilingContext> MakeContexts(size_t distinct, uint32_t inputNum)
+{
+  std::vector<HostTilingContext> contexts(distinct);
+  for (size_t i = 0; i < distinct; i++) {
+    int64_t batch = 1 + static_cast<int64_t>(i % 4);
+    int64_t seq = 1 + static_cast<int64_t>(i / 4) * 16;
+    for (uint32_t k = 0; k < inputNum; k++) {
+      Shape shape;
+      shape.dims = (k + 1 == inputNum && (i % 2) != 0) ? std::vector<int64_t>{1, 1, 4096}
+                                                         : std::vector<int64_t>{batch, seq, 4096};
+      contexts[i].inputs.push_back(shape);
+    }
+  }
+  return contexts;
+}
+
+// 命中路径写回的结果需与重新计算的逐字节一致，返回不一致的形状数。
+size_t CountMismatches(std::vector<HostTilingContext>& contexts, TilingFn compute)
+{
+  size_t mismatches = 0;
+  for (HostTilingContext& ctx : contexts) {
+    std::vector<uint8_t> cached(static_cast<uint8_t*>(ctx.GetRawTilingData()->GetData()),
+                                static_cast<uint8_t*>(ctx.GetRawTilingData()->GetData()) +
+                                    ctx.GetRawTilingData()->GetDataSize());
+    uint64_t key = ctx.GetTilingKey();
+    uint32_t blockDim = ctx.GetBlockDim();
+    compute(&ctx);
+    if (cached.size() != ctx.GetRawTilingData()->GetDataSize() || key != ctx.GetTilingKey() ||
+        blockDim != ctx.GetBlockDim() ||
+        std::memcmp(cached.data(), ctx.GetRawTilingData()->GetData(), cached.size()) != 0) {
+      mismatches++;
+    }
+  }
+  return mismatches;
+}
+
+bool Run(const char* name, uint32_t inputNum, uint32_t attrNum, TilingFn compute, size_t launches, size_t distinct)
+{
+  std::vector<HostTilingContext> contexts = MakeContexts(distinct, inputNum);
+  typedef std::chrono::steady_clock Clock;
+  uint64_t checksum = 0;
+
+  Clock::time_point start = Clock::now();
+  for (size_t n = 0; n < launches; n++) {
+    HostTilingContext* ctx = &contexts[n % distinct];
+    compute(ctx);
+    checksum += ctx->GetBlockDim();
+  }
+  double uncachedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / launches;
+
+  TilingPlanCache cache(256);
+  start = Clock::now();
+  for (size_t n = 0; n < launches; n++) {
+    HostTilingContext* ctx = &contexts[n % distinct];
+    CachedTiling(ctx, cache, compute, attrNum);
+    checksum += ctx->GetBlockDim();
+  }
+  double cachedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / launches;
+  size_t mismatches = CountMismatches(contexts, compute);
+
+  std::printf("%s (tiling data %zu bytes)\n", name, contexts[0].GetRawTilingData()->GetDataSize());
+  std::printf("  recompute every launch: %8.1f ns/launch\n", uncachedNs);
+  std::printf("  plan cache:             %8.1f ns/launch  (hits %llu, misses %llu, entries %zu)\n", cachedNs,
+              static_cast<unsigned long long>(cache.Hits()), static_cast<unsigned long long>(cache.Misses()),
+              cache.Size());
+  std::printf("  speedup: %.2fx  mismatches: %zu  (checksum %llu)\n", uncachedNs / cachedNs, mismatches,
+              static_cast<unsigned long long>(checksum));
+  return mismatches == 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  size_t launches = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  size_t distinct = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 48;
+  if (launches == 0 || distinct == 0) {
+    std::fprintf(stderr, "usage: %s [launches] [distinct_shapes]\n", argv[0]);
+    return 1;
+  }
+
+  std::printf("launches: %zu  distinct shapes: %zu\n", launches, distinct);
+  bool ok = Run("pows", 2, 1, PowsTiling, launches, distinct);
+  ok = Run("select_v2", 3, 2, SelectTiling, launches, distinct) && ok;
+  return ok ? 0 : 1;
+}
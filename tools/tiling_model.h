@@ -0,0 +1,224 @@
+// op_tiling_bench 与 tiling_autotune 共用的用例矩阵与切分结果统计。
+// 切分直接调用算子的 PlanPowsTiling / PlanSelectTiling / PlanPowsSelectTiling，GM 流量按核函数的 DataCopy 方式估算：
+//   与输出同形状的输入读一次；连续分支中的标量输入每核读一个元素；
+//   广播分支中最内维连续的广播输入每行重复读取，最内维被广播的输入每行读一个元素（GetValue）。
+
+#ifndef TILING_MODEL_H
+#define TILING_MODEL_H
+
+#include <cstdint>
+#include <vector>
+
+#include "pows_plan.h"
+#include "pows_select_plan.h"
+#include "select_v2_plan.h"
+
+namespace tilingmodel {
+
+const uint64_t BROADCAST_COLS = 1024;
+
+// 各算子注册的 SoC（ascend310b）：每核 UB 256 KB，1 个 AI Core。两个工具默认按这一平台切分与调优。
+const uint64_t TARGET_UB_SIZE = 256 * 1024;
+const uint32_t TARGET_CORE_NUM = 1;
+
+// BroadcastPlanner::AddInput 需要的形状接口。
+class HostShape {
+public:
+  explicit HostShape(const std::vector<int64_t>& dims) : dims(dims) {}
+  size_t GetDimNum() const { return dims.size(); }
+  int64_t GetDim(size_t i) const { return dims[i]; }
+
+private:
+  const std::vector<int64_t>& dims;
+};
+
+// 广播方式，与 optiling::TUNE_CLASS_* 一一对应。
+enum class CaseKind { SAME, SCALAR, ROW, COL };
+
+const CaseKind CASES[] = {CaseKind::SAME, CaseKind::SCALAR, CaseKind::ROW, CaseKind::COL};
+
+inline const char* CaseName(CaseKind kind)
+{
+  switch (kind) {
+    case CaseKind::SAME:
+      return "same";
+    case CaseKind::SCALAR:
+      return "scalar";
+    case CaseKind::ROW:
+      return "row";
+    default:
+      return "col";
+  }
+}
+
+// 输出形状与广播输入 x2 的形状：same 为同形状，scalar 为 [1]，row / col 把输出看作 [size / C, C]，
+// x2 分别为 [1, C] 与 [size / C, 1]，C = BROADCAST_COLS。元素数不能整除或只有一行时返回 false。
+inline bool CaseShapes(CaseKind kind, uint64_t size, std::vector<int64_t>& out, std::vector<int64_t>& bcast)
+{
+  int64_t n = static_cast<int64_t>(size);
+  int64_t cols = static_cast<int64_t>(BROADCAST_COLS);
+  switch (kind) {
+    case CaseKind::SAME:
+      out = {n};
+      bcast = {n};
+      return true;
+    case CaseKind::SCALAR:
+      out = {n};
+      bcast = {1};
+      return true;
+    case CaseKind::ROW:
+    case CaseKind::COL:
+      if (size % BROADCAST_COLS != 0 || size / BROADCAST_COLS < 2) {
+        return false;
+      }
+      out = {n / cols, cols};
+      bcast = kind == CaseKind::ROW ? std::vector<int64_t>{1, cols} : std::vector<int64_t>{n / cols, 1};
+      return true;
+  }
+  return false;
+}
+
+// 各算子的输入形状：pows 为 (x1, x2)，select_v2 为 (condition, x1, x2)，pows_select 为 (condition, x1, x2, x3)，
+// 广播的都是 x2。
+inline std::vector<std::vector<int64_t>> CaseInputs(uint8_t op, const std::vector<int64_t>& out,
+                                                    const std::vector<int64_t>& bcast)
+{
+  std::vector<std::vector<int64_t>> shapes;
+  if (op != optiling::TUNE_OP_POWS) {
+    shapes.push_back(out);
+  }
+  shapes.push_back(out);
+  shapes.push_back(bcast);
+  if (op == optiling::TUNE_OP_POWS_SELECT) {
+    shapes.push_back(out);
+  }
+  return shapes;
+}
+
+struct OpTiling {
+  uint32_t tilingKey;
+  uint32_t baseKey;          // 不含 TILING_KEY_TRIPLE_BUFFER
+  uint8_t bcastClass;        // optiling::TUNE_CLASS_*
+  bool broadcast;            // 走广播分支
+  uint32_t elemBytes;
+  uint32_t blockSize;
+  uint32_t blockDim;
+  uint32_t depth;
+  uint32_t coreUnit;         // 连续分支的核间切分粒度
+  uint64_t totalLength;
+  uint32_t rowLength;        // 合并后的最内维长度
+  optiling::ElementwiseSplit split;
+  optiling::BroadcastRowSplit rows;
+  uint64_t tileNum;
+  uint64_t ubBytes;
+  // GM 流量：每个输出元素读取的字节数（同形状输入与最内维连续的广播输入）、
+  // 每行按 GetValue 读取的输入个数、每核按 GetValue 读取的输入个数与其元素宽度。
+  uint32_t streamBytes;
+  uint32_t rowScalarReads;
+  uint32_t coreScalarReads;
+  uint64_t gmReadBytes;
+  uint64_t gmWriteBytes;
+};
+
+// 第 core 个核在连续分支中处理的元素数，与 ElementwisePipeline::Init 的划分一致。
+inline uint64_t CoreLength(const OpTiling& t, uint32_t core)
+{
+  return t.split.coreSize + (core < t.split.coreRemain ? t.coreUnit : 0) +
+      (core + 1 == t.split.coreNum ? t.split.coreTail : 0);
+}
+
+// tuned 为 nullptr 时与 TilingFunc 相同（先查表，未命中按公式），否则按给定的候选方案切分。
+inline bool PlanOp(uint8_t op, const std::vector<std::vector<int64_t>>& shapes, uint32_t elemBytes, bool signAware,
+                   uint64_t ubSize, uint32_t coreNum, const optiling::TunedTiling* tuned, OpTiling& t)
+{
+  optiling::BroadcastPlanner planner;
+  for (const auto& shape : shapes) {
+    planner.AddInput(HostShape(shape));
+  }
+  if (!planner.Plan()) {
+    return false;
+  }
+  t = {};
+  t.totalLength = planner.OutSize();
+  t.elemBytes = elemBytes;
+  t.rowLength = planner.DimNum() == 0 ? 1 : planner.OutShape()[planner.DimNum() - 1];
+  t.bcastClass = optiling::TuneClassOf(planner, static_cast<uint32_t>(shapes.size()));
+  std::vector<uint32_t> inputBytes;
+  if (op == optiling::TUNE_OP_POWS) {
+    optiling::PowsTilingPlan plan;
+    if (!optiling::PlanPowsTiling(planner, elemBytes, signAware, ubSize, coreNum, plan, tuned)) {
+      return false;
+    }
+    t.tilingKey = plan.tilingKey;
+    t.broadcast = plan.branch == optiling::POWS_BRANCH_BROADCAST;
+    t.blockSize = plan.blockSize;
+    t.blockDim = plan.blockDim;
+    t.depth = plan.depth;
+    t.coreUnit = plan.alignNum * 8;
+    t.split = plan.split;
+    t.rows = plan.rows;
+    t.ubBytes = plan.ubBytes;
+    inputBytes = {elemBytes, elemBytes};
+  } else if (op == optiling::TUNE_OP_POWS_SELECT) {
+    optiling::PowsSelectTilingPlan plan;
+    if (!optiling::PlanPowsSelectTiling(planner, elemBytes, signAware, ubSize, coreNum, plan, tuned)) {
+      return false;
+    }
+    t.tilingKey = plan.tilingKey;
+    t.broadcast = plan.branch == optiling::POWS_SELECT_BRANCH_BROADCAST;
+    t.blockSize = plan.blockSize;
+    t.blockDim = plan.blockDim;
+    t.depth = plan.depth;
+    t.coreUnit = plan.alignNum * 8;
+    t.split = plan.split;
+    t.rows = plan.rows;
+    t.ubBytes = plan.ubBytes;
+    inputBytes = {sizeof(uint8_t), elemBytes, elemBytes, elemBytes};
+  } else {
+    optiling::SelectTilingPlan plan;
+    if (!optiling::PlanSelectTiling(planner, false, false, elemBytes, ubSize, coreNum, plan, tuned)) {
+      return false;
+    }
+    t.tilingKey = plan.tilingKey;
+    t.broadcast = plan.tilingKey == optiling::KEY_BROADCAST;
+    t.blockSize = plan.blockSize;
+    t.blockDim = plan.blockDim;
+    t.depth = plan.depth;
+    t.coreUnit = plan.alignNum * 8;
+    t.split = plan.split;
+    t.rows = plan.rows;
+    t.ubBytes = plan.ubBytes;
+    inputBytes = {sizeof(uint8_t), elemBytes, elemBytes};
+  }
+  t.baseKey = t.tilingKey % optiling::TILING_KEY_TRIPLE_BUFFER;
+
+  uint64_t rowNum = t.totalLength / t.rowLength;
+  for (uint32_t k = 0; k < inputBytes.size(); k++) {
+    if (planner.IsFull(k)) {
+      t.streamBytes += inputBytes[k];
+    } else if (!t.broadcast) {
+      t.coreScalarReads++;
+      t.gmReadBytes += static_cast<uint64_t>(t.blockDim) * inputBytes[k];
+    } else if (planner.Strides(k)[planner.DimNum() - 1] == 0) {
+      t.rowScalarReads++;
+      t.gmReadBytes += rowNum * inputBytes[k];
+    } else {
+      t.streamBytes += inputBytes[k];
+    }
+  }
+  t.gmReadBytes += t.totalLength * t.streamBytes;
+  t.gmWriteBytes = t.totalLength * elemBytes;
+
+  if (t.broadcast) {
+    t.tileNum = t.rows.tileNum;
+  } else {
+    for (uint32_t i = 0; i < t.split.coreNum && t.totalLength != 0; i++) {
+      t.tileNum += (CoreLength(t, i) + t.blockSize - 1) / t.blockSize;
+    }
+  }
+  return true;
+}
+
+}  // namespace tilingmodel
+
+#endif  // TILING_MODEL_H